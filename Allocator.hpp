@@ -0,0 +1,153 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+
+// Storage policy for Vector<T>. Buffers come from a std::pmr::memory_resource,
+// so arenas (std::pmr::monotonic_buffer_resource), pools or huge-page backed
+// resources can be plugged in per vector or process-wide. The default resource
+// returns 64-byte aligned memory, a cache line and one AVX-512 register.
+namespace atMath
+{
+
+    constexpr size_t default_alignment = 64;
+
+    // Tag for constructors that allocate without initializing the elements,
+    // for buffers that are about to be overwritten anyway. Arithmetic elements
+    // are left indeterminate, class types are default-constructed.
+    struct uninitialized_t
+    {
+        explicit uninitialized_t() = default;
+    };
+    constexpr uninitialized_t uninitialized{};
+
+    // Tag for constructors that use a caller's buffer in place without taking
+    // ownership. The caller keeps the memory alive for as long as the Vector
+    // uses it; growing the Vector moves it to a buffer of its own.
+    struct borrowed_t
+    {
+        explicit borrowed_t() = default;
+    };
+    constexpr borrowed_t borrowed{};
+
+    class AlignedResource : public std::pmr::memory_resource
+    {
+        size_t alignment;
+
+    public:
+        explicit AlignedResource(size_t alignment = default_alignment) : alignment(alignment) {}
+
+    private:
+        void *do_allocate(size_t bytes, size_t align) override
+        {
+            return ::operator new(bytes, std::align_val_t(std::max(align, alignment)));
+        }
+
+        void do_deallocate(void *p, size_t bytes, size_t align) override
+        {
+            ::operator delete(p, bytes, std::align_val_t(std::max(align, alignment)));
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+        {
+            return this == &other;
+        }
+    };
+
+    inline std::pmr::memory_resource *aligned_resource()
+    {
+        static AlignedResource resource;
+        return &resource;
+    }
+
+    inline std::atomic<std::pmr::memory_resource *> &default_resource_slot()
+    {
+        static std::atomic<std::pmr::memory_resource *> slot{nullptr};
+        return slot;
+    }
+
+    // Resource used by Vectors that are not given one explicitly.
+    inline std::pmr::memory_resource *get_default_resource()
+    {
+        std::pmr::memory_resource *resource = default_resource_slot().load(std::memory_order_acquire);
+        return resource != nullptr ? resource : aligned_resource();
+    }
+
+    // Returns the previous default. Passing nullptr restores aligned_resource().
+    inline std::pmr::memory_resource *set_default_resource(std::pmr::memory_resource *resource)
+    {
+        std::pmr::memory_resource *previous = default_resource_slot().exchange(resource, std::memory_order_acq_rel);
+        return previous != nullptr ? previous : aligned_resource();
+    }
+
+    template <class T>
+    constexpr size_t buffer_alignment()
+    {
+        return std::max(alignof(T), default_alignment);
+    }
+
+    // Releases a Vector buffer. Buffers allocated from a resource are destroyed
+    // and handed back to it; a null resource marks a buffer adopted from a
+    // std::unique_ptr<T[]>, which is released with delete[]. External buffers
+    // belong to someone else: dropping owner runs the deleter they were
+    // adopted with, and borrowed buffers have no owner at all.
+    template <class T>
+    struct BufferDeleter
+    {
+        std::pmr::memory_resource *resource = nullptr;
+        size_t count = 0;
+        bool external = false;
+        std::shared_ptr<void> owner;
+
+        void operator()(T *p)
+        {
+            if (external)
+            {
+                owner.reset();
+                return;
+            }
+            if (resource == nullptr)
+            {
+                delete[] p;
+                return;
+            }
+            std::destroy_n(p, count);
+            resource->deallocate(p, count * sizeof(T), buffer_alignment<T>());
+        }
+    };
+
+    template <class T>
+    using Buffer = std::unique_ptr<T[], BufferDeleter<T>>;
+
+    template <class T>
+    Buffer<T> make_buffer(size_t size, std::pmr::memory_resource *resource, bool initialize = true)
+    {
+        if (size == 0)
+        {
+            return Buffer<T>(nullptr, BufferDeleter<T>{resource, 0, false, nullptr});
+        }
+        T *p = static_cast<T *>(resource->allocate(size * sizeof(T), buffer_alignment<T>()));
+        try
+        {
+            if (initialize)
+            {
+                std::uninitialized_value_construct_n(p, size);
+            }
+            else
+            {
+                std::uninitialized_default_construct_n(p, size);
+            }
+        }
+        catch (...)
+        {
+            resource->deallocate(p, size * sizeof(T), buffer_alignment<T>());
+            throw;
+        }
+        return Buffer<T>(p, BufferDeleter<T>{resource, size, false, nullptr});
+    }
+
+}
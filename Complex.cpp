@@ -1,3 +1,5 @@
+#pragma once
+
 #include "Complex.hpp"
 #include <cmath>
 #include <cstdint>
@@ -8,7 +10,7 @@ namespace atMath{
 
 
     template <class T>
-    Complex<T>::Complex(T real, T imag, bool is_polar) : real(real), imag(imag){
+    constexpr Complex<T>::Complex(T real, T imag, bool is_polar) noexcept : real(real), imag(imag){
         static_assert(std::is_arithmetic<T>::value, "Complex type must be arithmetic");
         if (is_polar){
             this->real = real * cos(imag);
@@ -17,42 +19,24 @@ namespace atMath{
     }
 
     template <class T>
-    Complex<T>::Complex(const T real) : real(real), imag(0) {
-        static_assert(std::is_arithmetic<T>::value, "Complex type must be arithmetic");
-    }
-
-    template <class T>
-    Complex<T>::Complex(const Complex<T> &c) : real(c.real), imag(c.imag) {
+    constexpr Complex<T>::Complex(const T real) noexcept : real(real), imag(0) {
         static_assert(std::is_arithmetic<T>::value, "Complex type must be arithmetic");
     }
 
     template <class T>
     template <class U>
-    Complex<T>::Complex(const Complex<U> &c) : real(static_cast<T>(c.real)), imag(static_cast<T>(c.imag)) {
+    constexpr Complex<T>::Complex(const Complex<U> &c) noexcept : real(static_cast<T>(c.real)), imag(static_cast<T>(c.imag)) {
         static_assert(std::is_arithmetic<T>::value, "Complex type must be arithmetic");
     }
 
     template <class T>
-    Complex<T>::Complex() : real(0), imag(0) {
+    constexpr Complex<T>::Complex() noexcept : real(0), imag(0) {
         static_assert(std::is_arithmetic<T>::value, "Complex type must be arithmetic");
     }
 
-    template <class T>
-    Complex<T>::~Complex() {}
-
-
-    template <class T>
-    Complex<T> &Complex<T>::operator=(const Complex<T> &c){
-        if (this != &c){
-            real = c.real;
-            imag = c.imag;
-        }
-        return *this;
-    }
-
     template <class T>
     template <class U>
-    Complex<T> &Complex<T>::operator=(const Complex<U> &c){
+    constexpr Complex<T> &Complex<T>::operator=(const Complex<U> &c) noexcept{
         real = static_cast<T>(c.real);
         imag = static_cast<T>(c.imag);
         return *this;
@@ -60,7 +44,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Complex<T> &Complex<T>::operator+=(const Complex<U> &c){
+    constexpr Complex<T> &Complex<T>::operator+=(const Complex<U> &c) noexcept{
         real += static_cast<T>(c.real);
         imag += static_cast<T>(c.imag);
         return *this;
@@ -68,7 +52,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Complex<T> &Complex<T>::operator-=(const Complex<U> &c){
+    constexpr Complex<T> &Complex<T>::operator-=(const Complex<U> &c) noexcept{
         real -= static_cast<T>(c.real);
         imag -= static_cast<T>(c.imag);
         return *this;
@@ -76,7 +60,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Complex<T> &Complex<T>::operator*=(const Complex<U> &c){
+    constexpr Complex<T> &Complex<T>::operator*=(const Complex<U> &c) noexcept{
         T temp = real;
         real = real * static_cast<T>(c.real) - imag * static_cast<T>(c.imag);
         imag = temp * static_cast<T>(c.imag) + imag * static_cast<T>(c.real);
@@ -85,7 +69,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Complex<T> &Complex<T>::operator/=(const Complex<U> &c){
+    constexpr Complex<T> &Complex<T>::operator/=(const Complex<U> &c) noexcept{
         T temp = real;
         real = (real * static_cast<T>(c.real) + imag * static_cast<T>(c.imag)) / (c.real * c.real + c.imag * c.imag);
         imag = (imag * static_cast<T>(c.real) - temp * static_cast<T>(c.imag)) / (c.real * c.real + c.imag * c.imag);
@@ -94,7 +78,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Complex<T> &Complex<T>::operator=(const U &value){
+    constexpr Complex<T> &Complex<T>::operator=(const U &value) noexcept{
         real = static_cast<T>(value);
         imag = 0;
         return *this;
@@ -102,42 +86,42 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Complex<T> &Complex<T>::operator+=(const U &value){
+    constexpr Complex<T> &Complex<T>::operator+=(const U &value) noexcept{
         real += static_cast<T>(value);
         return *this;
     }
 
     template <class T>
     template <class U>
-    Complex<T> &Complex<T>::operator-=(const U &value){
+    constexpr Complex<T> &Complex<T>::operator-=(const U &value) noexcept{
         real -= static_cast<T>(value);
         return *this;
     }
 
     template <class T>
     template <class U>
-    Complex<T> &Complex<T>::operator*=(const U &value){
+    constexpr Complex<T> &Complex<T>::operator*=(const U &value) noexcept{
         *this = *this * value;
         return *this;
     }
 
     template <class T>
     template <class U>
-    Complex<T> &Complex<T>::operator/=(const U &value){
+    constexpr Complex<T> &Complex<T>::operator/=(const U &value) noexcept{
         *this = *this / value;
         return *this;
     }
 
     template <class T>
     template <class U>
-    bool Complex<T>::operator==(const Complex<U> &c) const{
+    constexpr bool Complex<T>::operator==(const Complex<U> &c) const noexcept{
         float epsilon = 0.00001f;
-        return abs(real - c.real) < epsilon && abs(imag - c.imag) < epsilon;
+        return nearly_equal(real, c.real, epsilon) && nearly_equal(imag, c.imag, epsilon);
     }
 
     template <class T>
     template <class U>
-    bool Complex<T>::operator!=(const Complex<U> &c) const{
+    constexpr bool Complex<T>::operator!=(const Complex<U> &c) const noexcept{
         return !(*this == c);
     }
 
@@ -147,7 +131,12 @@ namespace atMath{
     }
 
     template <class T>
-    T Complex<T>::squared_modulus() const{
+    constexpr T Complex<T>::squared_modulus() const noexcept{
+        return real * real + imag * imag;
+    }
+
+    template <class T>
+    constexpr T Complex<T>::modulus_squared() const noexcept{
         return real * real + imag * imag;
     }
 
@@ -167,7 +156,7 @@ namespace atMath{
     }
     
     template <class T>
-    Complex<T> Complex<T>::conjugate() const{
+    constexpr Complex<T> Complex<T>::conjugate() const noexcept{
         return Complex<T>(real, -imag);
     }
 
@@ -188,68 +177,68 @@ namespace atMath{
     }
 
     template <class T, class U>
-    inline auto operator+(const Complex<T> &c1, const Complex<U> &c2) -> Complex<decltype(c1.real + c2.real)>{
+    constexpr auto operator+(const Complex<T> &c1, const Complex<U> &c2) noexcept -> Complex<decltype(c1.real + c2.real)>{
         return Complex<decltype(c1.real + c2.real)>(c1.real + c2.real, c1.imag + c2.imag);
     }
 
     template <class T, class U>
-    inline auto operator-(const Complex<T> &c1, const Complex<U> &c2) -> Complex<decltype(c1.real - c2.real)>{
+    constexpr auto operator-(const Complex<T> &c1, const Complex<U> &c2) noexcept -> Complex<decltype(c1.real - c2.real)>{
         return Complex<decltype(c1.real - c2.real)>(c1.real - c2.real, c1.imag - c2.imag);
     }
 
     template <class T, class U>
-    inline auto operator*(const Complex<T> &c1, const Complex<U> &c2) -> Complex<decltype(c1.real * c2.real)>{
+    constexpr auto operator*(const Complex<T> &c1, const Complex<U> &c2) noexcept -> Complex<decltype(c1.real * c2.real)>{
         return Complex<decltype(c1.real * c2.real)>(c1.real * c2.real - c1.imag * c2.imag, c1.real * c2.imag + c1.imag * c2.real);
     }
 
     template <class T, class U>
-    inline auto operator/(const Complex<T> &c1, const Complex<U> &c2) -> Complex<decltype(1.f * c1.real / c2.real)>{
+    constexpr auto operator/(const Complex<T> &c1, const Complex<U> &c2) noexcept -> Complex<decltype(1.f * c1.real / c2.real)>{
         return Complex<decltype(1.f * c1.real / c2.real)>( 1.f *(c1.real * c2.real + c1.imag * c2.imag) / (c2.real * c2.real + c2.imag * c2.imag), 1.f *(c1.imag * c2.real - c1.real * c2.imag) / (c2.real * c2.real + c2.imag * c2.imag));
     }
 
     template <class T, class U>
-    inline auto operator+(const Complex<T> &c, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real + value)>>{
+    constexpr auto operator+(const Complex<T> &c, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real + value)>>{
         return Complex<decltype(c.real + value)>(c.real + value, c.imag);
     }
 
     template <class T, class U>
-    inline auto operator+(const U &value, const Complex<T> &c) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real + value)>>{
+    constexpr auto operator+(const U &value, const Complex<T> &c) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real + value)>>{
         return c + value;
     }
 
     template <class T, class U>
-    inline auto operator-(const Complex<T> &c, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real - value)>>{
+    constexpr auto operator-(const Complex<T> &c, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real - value)>>{
         return Complex<decltype(c.real - value)>(c.real - value, c.imag);
     }
 
     template <class T, class U>
-    inline auto operator-(const U &value, const Complex<T> &c) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(value - c.real)>>{
+    constexpr auto operator-(const U &value, const Complex<T> &c) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(value - c.real)>>{
         return Complex<decltype(value - c.real)>(value - c.real, -c.imag);
     }
 
     template <class T, class U>
-    inline auto operator*(const Complex<T> &c, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real * value)>>{
+    constexpr auto operator*(const Complex<T> &c, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real * value)>>{
         return Complex<decltype(c.real * value)>(c.real * value, c.imag * value);
     }
 
     template <class T, class U>
-    inline auto operator*(const U &value, const Complex<T> &c) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real * value)>>{
+    constexpr auto operator*(const U &value, const Complex<T> &c) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real * value)>>{
         return c * value;
     }
 
     template <class T, class U>
-    inline auto operator/(const Complex<T> &c,const  U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(1.f *c.real / value)>>{
+    constexpr auto operator/(const Complex<T> &c,const  U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(1.f *c.real / value)>>{
         return Complex<decltype(1.f * c.real / value)>(1.f * c.real / value,1.f * c.imag / value);
     }
 
     template <class T, class U>
-    auto operator/(const U &value, const Complex<T> &c) -> std::enable_if_t<std::is_arithmetic<U>::value,Complex<decltype(1.f * value * c.real / c.squared_modulus())>>{
+    constexpr auto operator/(const U &value, const Complex<T> &c) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value,Complex<decltype(1.f * value * c.real / c.squared_modulus())>>{
         double mod_rev = 1.f / c.squared_modulus();
         Complex<decltype(value * c.real * mod_rev)> result(c.real * mod_rev, -c.imag * mod_rev);
         return result * value;
     }
 
-    const Complex<int> i(0, 1);
+    constexpr Complex<int> i(0, 1);
 }
 
 template <class T>
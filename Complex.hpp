@@ -1,65 +1,94 @@
 #pragma once
 
+#include <complex>
+#include <cstddef>
 #include <iostream>
 #include <type_traits>
 #include <iomanip>
 
+// ATMATH_HEADER_ONLY compiles everything from the headers, ignoring the
+// precompiled instantiations of the atMath library.
+#if ATMATH_HEADER_ONLY
+#undef ATMATH_EXTERN_TEMPLATES
+#endif
+
+// Complex and Quaternion arithmetic is constexpr and inlined into the caller
+// even where the optimizer's cost model would keep a call.
+#ifndef ATMATH_FORCE_INLINE
+#if defined(__GNUC__) || defined(__clang__)
+#define ATMATH_FORCE_INLINE __attribute__((always_inline))
+#elif defined(_MSC_VER)
+#define ATMATH_FORCE_INLINE __forceinline
+#else
+#define ATMATH_FORCE_INLINE
+#endif
+#endif
+
 namespace atMath
 {
+    // |a - b| < epsilon without std::abs, so it is constexpr and does not
+    // wrap for unsigned element types.
+    template <class A, class B>
+    ATMATH_FORCE_INLINE constexpr bool nearly_equal(A a, B b, float epsilon) noexcept
+    {
+        return a > b ? a - b < epsilon : b - a < epsilon;
+    }
+
     template <class T = float>
     class Complex{
     public:
         T real;
         T imag;
 
-        Complex(T real, T imag, bool is_polar = false);
-        Complex(const T real);
-        Complex(const Complex<T> &c);
+        ATMATH_FORCE_INLINE constexpr Complex(T real, T imag, bool is_polar = false) noexcept;
+        ATMATH_FORCE_INLINE constexpr Complex(const T real) noexcept;
+        Complex(const Complex<T> &c) = default;
         template <class U>
-        Complex(const Complex<U> &c);
-        Complex();
-        ~Complex();
+        ATMATH_FORCE_INLINE constexpr Complex(const Complex<U> &c) noexcept;
+        ATMATH_FORCE_INLINE constexpr Complex() noexcept;
+        ~Complex() = default;
 
 
-        Complex<T> &operator=(const Complex<T> &c);
+        Complex<T> &operator=(const Complex<T> &c) = default;
         template <class U>
-        Complex<T> &operator=(const Complex<U> &c);
+        ATMATH_FORCE_INLINE constexpr Complex<T> &operator=(const Complex<U> &c) noexcept;
         template <class U>
-        Complex<T> &operator+=(const Complex<U> &c);
+        ATMATH_FORCE_INLINE constexpr Complex<T> &operator+=(const Complex<U> &c) noexcept;
         template <class U>
-        Complex<T> &operator-=(const Complex<U> &c);
+        ATMATH_FORCE_INLINE constexpr Complex<T> &operator-=(const Complex<U> &c) noexcept;
         template <class U>
-        Complex<T> &operator*=(const Complex<U> &c);
+        ATMATH_FORCE_INLINE constexpr Complex<T> &operator*=(const Complex<U> &c) noexcept;
         template <class U>
-        Complex<T> &operator/=(const Complex<U> &c);
+        ATMATH_FORCE_INLINE constexpr Complex<T> &operator/=(const Complex<U> &c) noexcept;
 
         template <class U>
-        Complex<T> &operator=(const U &value);
+        ATMATH_FORCE_INLINE constexpr Complex<T> &operator=(const U &value) noexcept;
         template <class U>
-        Complex<T> &operator+=(const U &value);
+        ATMATH_FORCE_INLINE constexpr Complex<T> &operator+=(const U &value) noexcept;
         template <class U>
-        Complex<T> &operator-=(const U &value);
+        ATMATH_FORCE_INLINE constexpr Complex<T> &operator-=(const U &value) noexcept;
         template <class U>
-        Complex<T> &operator*=(const U &value);
+        ATMATH_FORCE_INLINE constexpr Complex<T> &operator*=(const U &value) noexcept;
         template <class U>
-        Complex<T> &operator/=(const U &value);
+        ATMATH_FORCE_INLINE constexpr Complex<T> &operator/=(const U &value) noexcept;
 
-        Complex<T> operator-() const{
+        ATMATH_FORCE_INLINE constexpr Complex<T> operator-() const noexcept{
             return Complex<T>(-real, -imag);
         }
 
         template <class U>
-        bool operator==(const Complex<U> &c) const;
+        ATMATH_FORCE_INLINE constexpr bool operator==(const Complex<U> &c) const noexcept;
         template <class U>
-        bool operator!=(const Complex<U> &c) const;
+        ATMATH_FORCE_INLINE constexpr bool operator!=(const Complex<U> &c) const noexcept;
 
         double modulus() const;
-        T squared_modulus() const;
+        ATMATH_FORCE_INLINE constexpr T squared_modulus() const noexcept;
+        ATMATH_FORCE_INLINE constexpr T modulus_squared() const noexcept;
 
         Complex<double> pow(const double &epx);
         template <class U>
         Complex<double> pow(const Complex<U> &c);
-        Complex<T> conjugate() const;
+        ATMATH_FORCE_INLINE constexpr Complex<T> conjugate() const noexcept;
         double argz() const;
         
         static Complex<T> rotate(const double &angle);
@@ -92,34 +121,43 @@ namespace atMath
         }
     };
 
+    // Complex<T> is trivially copyable and laid out as T[2], which is the
+    // layout std::complex<T> guarantees, so buffers of either can be copied
+    // with memcpy and viewed as the other.
+    template <class T>
+    constexpr bool has_complex_layout = std::is_trivially_copyable<Complex<T>>::value && std::is_standard_layout<Complex<T>>::value &&
+                                        sizeof(Complex<T>) == sizeof(std::complex<T>) && alignof(Complex<T>) == alignof(std::complex<T>) &&
+                                        offsetof(Complex<T>, real) == 0 && offsetof(Complex<T>, imag) == sizeof(T);
+    static_assert(has_complex_layout<float> && has_complex_layout<double>, "Complex<T> must match the layout of std::complex<T>");
+
     template <class T>
     bool is_complex(const T &value);
 
     template <class T, class U>
-    inline auto operator+(const Complex<T> &c1, const Complex<U> &c2) -> Complex<decltype(c1.real + c2.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator+(const Complex<T> &c1, const Complex<U> &c2) noexcept -> Complex<decltype(c1.real + c2.real)>;
     template <class T, class U>
-    inline auto operator-(const Complex<T> &c1, const Complex<U> &c2) -> Complex<decltype(c1.real - c2.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator-(const Complex<T> &c1, const Complex<U> &c2) noexcept -> Complex<decltype(c1.real - c2.real)>;
     template <class T, class U>
-    inline auto operator*(const Complex<T> &c1, const Complex<U> &c2) -> Complex<decltype(c1.real * c2.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator*(const Complex<T> &c1, const Complex<U> &c2) noexcept -> Complex<decltype(c1.real * c2.real)>;
     template <class T, class U>
-    inline auto operator/(const Complex<T> &c1, const Complex<U> &c2) -> Complex<decltype(1.f * c1.real / c2.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator/(const Complex<T> &c1, const Complex<U> &c2) noexcept -> Complex<decltype(1.f * c1.real / c2.real)>;
 
     template <class T, class U>
-    inline auto operator+(const Complex<T> &c, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real + value)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator+(const Complex<T> &c, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real + value)>>;
     template <class T, class U>
-    inline auto operator+(const U &value, const Complex<T> &c) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real + value)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator+(const U &value, const Complex<T> &c) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real + value)>>;
     template <class T, class U>
-    inline auto operator-(const Complex<T> &c, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real - value)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator-(const Complex<T> &c, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real - value)>>;
     template <class T, class U>
-    inline auto operator-(const U &value, const Complex<T> &c) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(value - c.real)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator-(const U &value, const Complex<T> &c) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(value - c.real)>>;
     template <class T, class U>
-    inline auto operator*(const Complex<T> &c, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real * value)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator*(const Complex<T> &c, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real * value)>>;
     template <class T, class U>
-    inline auto operator*(const U &value, const Complex<T> &c) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real * value)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator*(const U &value, const Complex<T> &c) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(c.real * value)>>;
     template <class T, class U>
-    inline auto operator/(const Complex<T> &c, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(1.f * c.real / value)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator/(const Complex<T> &c, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Complex<decltype(1.f * c.real / value)>>;
     template <class T, class U>
-    auto operator/(const U &value, const Complex<T> &c) -> std::enable_if_t<std::is_arithmetic<U>::value,Complex<decltype(1.f * value * c.real / c.squared_modulus())>>;
+    ATMATH_FORCE_INLINE constexpr auto operator/(const U &value, const Complex<T> &c) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value,Complex<decltype(1.f * value * c.real / c.squared_modulus())>>;
 
 };
 
@@ -131,4 +169,26 @@ template <class T>
 atMath::Complex<double> log(const atMath::Complex<T> &c);
 
 template <class T>
-atMath::Complex<double> exp(const atMath::Complex<T> &c);
\ No newline at end of file
+atMath::Complex<double> exp(const atMath::Complex<T> &c);
+
+// Definitions; see the end of Vector.hpp for ATMATH_EXTERN_TEMPLATES.
+#include "Complex.cpp"
+
+#define ATMATH_COMPLEX_INSTANCES(PREFIX, T)                                  \
+    PREFIX class Complex<T>;
+
+#if ATMATH_EXTERN_TEMPLATES
+namespace atMath
+{
+    ATMATH_COMPLEX_INSTANCES(extern template, int)
+    ATMATH_COMPLEX_INSTANCES(extern template, float)
+    ATMATH_COMPLEX_INSTANCES(extern template, double)
+    ATMATH_COMPLEX_INSTANCES(extern template, uint32_t)
+    ATMATH_COMPLEX_INSTANCES(extern template, uint64_t)
+    ATMATH_COMPLEX_INSTANCES(extern template, int64_t)
+    ATMATH_COMPLEX_INSTANCES(extern template, uint8_t)
+    ATMATH_COMPLEX_INSTANCES(extern template, int8_t)
+    ATMATH_COMPLEX_INSTANCES(extern template, uint16_t)
+    ATMATH_COMPLEX_INSTANCES(extern template, int16_t)
+}
+#endif
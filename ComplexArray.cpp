@@ -0,0 +1,319 @@
+#pragma once
+
+#include "ComplexArray.hpp"
+#include <cmath>
+
+namespace atMath
+{
+
+    template <class T>
+    ComplexArray<T>::ComplexArray() : c_real(), c_imag() {}
+
+    template <class T>
+    ComplexArray<T>::ComplexArray(size_t size) : c_real(size), c_imag(size) {}
+
+    template <class T>
+    ComplexArray<T>::ComplexArray(size_t size, const Complex<T> &value) : c_real(size, value.real), c_imag(size, value.imag) {}
+
+    template <class T>
+    ComplexArray<T>::ComplexArray(size_t size, uninitialized_t) : c_real(size, uninitialized), c_imag(size, uninitialized) {}
+
+    template <class T>
+    ComplexArray<T>::ComplexArray(Vector<T> real, Vector<T> imag) : c_real(std::move(real)), c_imag(std::move(imag))
+    {
+        if (c_real.size() != c_imag.size())
+        {
+            throw std::runtime_error("Real and imaginary lanes must be the same size.");
+        }
+    }
+
+    template <class T>
+    ComplexArray<T>::ComplexArray(const Vector<Complex<T>> &v) : c_real(v.size(), uninitialized), c_imag(v.size(), uninitialized)
+    {
+        const Complex<T> *src = v.data();
+        T *re = c_real.data();
+        T *im = c_imag.data();
+        for (size_t i = 0; i < v.size(); i++)
+        {
+            re[i] = src[i].real;
+            im[i] = src[i].imag;
+        }
+    }
+
+    template <class T>
+    ComplexArray<T>::ComplexArray(std::initializer_list<Complex<T>> list) : c_real(list.size(), uninitialized), c_imag(list.size(), uninitialized)
+    {
+        size_t i = 0;
+        for (const Complex<T> &c : list)
+        {
+            c_real.at_unchecked(i) = c.real;
+            c_imag.at_unchecked(i) = c.imag;
+            i++;
+        }
+    }
+
+    template <class T>
+    template <class U>
+    ComplexArray<T>::ComplexArray(const ComplexArray<U> &c) : c_real(c.real()), c_imag(c.imag()) {}
+
+    template <class T>
+    void ComplexArray<T>::set(size_t index, const Complex<T> &value)
+    {
+        c_real[index] = value.real;
+        c_imag[index] = value.imag;
+    }
+
+    template <class T>
+    void ComplexArray<T>::push_back(const Complex<T> &value)
+    {
+        c_real.push_back(value.real);
+        c_imag.push_back(value.imag);
+    }
+
+    template <class T>
+    void ComplexArray<T>::reserve(size_t capacity)
+    {
+        c_real.reserve(capacity);
+        c_imag.reserve(capacity);
+    }
+
+    template <class T>
+    void ComplexArray<T>::clear()
+    {
+        c_real.clear();
+        c_imag.clear();
+    }
+
+    template <class T>
+    Vector<Complex<T>> ComplexArray<T>::toVector() const
+    {
+        Vector<Complex<T>> result(size(), uninitialized);
+        Complex<T> *dst = result.data();
+        const T *re = c_real.data();
+        const T *im = c_imag.data();
+        for (size_t i = 0; i < size(); i++)
+        {
+            dst[i].real = re[i];
+            dst[i].imag = im[i];
+        }
+        return result;
+    }
+
+    template <class T>
+    ComplexArray<T> &ComplexArray<T>::operator+=(const ComplexArray<T> &c)
+    {
+        c_real += c.c_real;
+        c_imag += c.c_imag;
+        return *this;
+    }
+
+    template <class T>
+    ComplexArray<T> &ComplexArray<T>::operator-=(const ComplexArray<T> &c)
+    {
+        c_real -= c.c_real;
+        c_imag -= c.c_imag;
+        return *this;
+    }
+
+    template <class T>
+    ComplexArray<T> &ComplexArray<T>::operator*=(const ComplexArray<T> &c)
+    {
+        if (size() != c.size())
+        {
+            throw std::runtime_error("Arrays must be the same size to multiply.");
+        }
+        T *re = c_real.data();
+        T *im = c_imag.data();
+        const T *ore = c.c_real.data();
+        const T *oim = c.c_imag.data();
+        for (size_t i = 0; i < size(); i++)
+        {
+            T a = re[i], b = im[i];
+            re[i] = a * ore[i] - b * oim[i];
+            im[i] = a * oim[i] + b * ore[i];
+        }
+        return *this;
+    }
+
+    template <class T>
+    ComplexArray<T> &ComplexArray<T>::operator/=(const ComplexArray<T> &c)
+    {
+        if (size() != c.size())
+        {
+            throw std::runtime_error("Arrays must be the same size to divide.");
+        }
+        T *re = c_real.data();
+        T *im = c_imag.data();
+        const T *ore = c.c_real.data();
+        const T *oim = c.c_imag.data();
+        for (size_t i = 0; i < size(); i++)
+        {
+            T a = re[i], b = im[i];
+            T norm = ore[i] * ore[i] + oim[i] * oim[i];
+            re[i] = (a * ore[i] + b * oim[i]) / norm;
+            im[i] = (b * ore[i] - a * oim[i]) / norm;
+        }
+        return *this;
+    }
+
+    template <class T>
+    ComplexArray<T> &ComplexArray<T>::operator*=(const Complex<T> &value)
+    {
+        T *re = c_real.data();
+        T *im = c_imag.data();
+        for (size_t i = 0; i < size(); i++)
+        {
+            T a = re[i], b = im[i];
+            re[i] = a * value.real - b * value.imag;
+            im[i] = a * value.imag + b * value.real;
+        }
+        return *this;
+    }
+
+    template <class T>
+    ComplexArray<T> &ComplexArray<T>::operator*=(const T &value)
+    {
+        c_real *= value;
+        c_imag *= value;
+        return *this;
+    }
+
+    template <class T>
+    ComplexArray<T> &ComplexArray<T>::operator/=(const T &value)
+    {
+        c_real /= value;
+        c_imag /= value;
+        return *this;
+    }
+
+    template <class T>
+    bool ComplexArray<T>::operator==(const ComplexArray<T> &c) const
+    {
+        return c_real == c.c_real && c_imag == c.c_imag;
+    }
+
+    template <class T>
+    bool ComplexArray<T>::operator!=(const ComplexArray<T> &c) const
+    {
+        return !(*this == c);
+    }
+
+    template <class T>
+    ComplexArray<T> ComplexArray<T>::conjugate() const
+    {
+        ComplexArray<T> result(c_real, Vector<T>(size(), uninitialized));
+        T *dst = result.c_imag.data();
+        const T *im = c_imag.data();
+        for (size_t i = 0; i < size(); i++)
+        {
+            dst[i] = -im[i];
+        }
+        return result;
+    }
+
+    template <class T>
+    Vector<T> ComplexArray<T>::squared_modulus() const
+    {
+        Vector<T> result(size(), uninitialized);
+        T *dst = result.data();
+        const T *re = c_real.data();
+        const T *im = c_imag.data();
+        for (size_t i = 0; i < size(); i++)
+        {
+            dst[i] = re[i] * re[i] + im[i] * im[i];
+        }
+        return result;
+    }
+
+    template <class T>
+    Vector<double> ComplexArray<T>::modulus() const
+    {
+        Vector<double> result(size(), uninitialized);
+        double *dst = result.data();
+        const T *re = c_real.data();
+        const T *im = c_imag.data();
+        for (size_t i = 0; i < size(); i++)
+        {
+            dst[i] = sqrt(static_cast<double>(re[i]) * re[i] + static_cast<double>(im[i]) * im[i]);
+        }
+        return result;
+    }
+
+    template <class T>
+    Vector<double> ComplexArray<T>::argz() const
+    {
+        Vector<double> result(size(), uninitialized);
+        double *dst = result.data();
+        const T *re = c_real.data();
+        const T *im = c_imag.data();
+        for (size_t i = 0; i < size(); i++)
+        {
+            dst[i] = atan2(static_cast<double>(im[i]), static_cast<double>(re[i]));
+        }
+        return result;
+    }
+
+    template <class T>
+    ComplexArray<T> operator+(ComplexArray<T> c1, const ComplexArray<T> &c2)
+    {
+        c1 += c2;
+        return c1;
+    }
+
+    template <class T>
+    ComplexArray<T> operator-(ComplexArray<T> c1, const ComplexArray<T> &c2)
+    {
+        c1 -= c2;
+        return c1;
+    }
+
+    template <class T>
+    ComplexArray<T> operator*(ComplexArray<T> c1, const ComplexArray<T> &c2)
+    {
+        c1 *= c2;
+        return c1;
+    }
+
+    template <class T>
+    ComplexArray<T> operator/(ComplexArray<T> c1, const ComplexArray<T> &c2)
+    {
+        c1 /= c2;
+        return c1;
+    }
+
+    template <class T>
+    ComplexArray<T> operator*(ComplexArray<T> c, const typename ComplexArray<T>::value_type &value)
+    {
+        c *= value;
+        return c;
+    }
+
+    template <class T>
+    ComplexArray<T> operator*(const typename ComplexArray<T>::value_type &value, ComplexArray<T> c)
+    {
+        c *= value;
+        return c;
+    }
+
+    template <class T>
+    ComplexArray<T> operator*(ComplexArray<T> c, const typename ComplexArray<T>::scalar_type &value)
+    {
+        c *= value;
+        return c;
+    }
+
+    template <class T>
+    ComplexArray<T> operator*(const typename ComplexArray<T>::scalar_type &value, ComplexArray<T> c)
+    {
+        c *= value;
+        return c;
+    }
+
+    template <class T>
+    ComplexArray<T> operator/(ComplexArray<T> c, const typename ComplexArray<T>::scalar_type &value)
+    {
+        c /= value;
+        return c;
+    }
+
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <initializer_list>
+#include <iostream>
+#include <type_traits>
+#include "Complex.hpp"
+#include "Vector.hpp"
+
+namespace atMath
+{
+
+    // Structure-of-arrays counterpart of Vector<Complex<T>>: real and
+    // imaginary parts live in two separate contiguous lanes, so elementwise
+    // kernels load full SIMD registers of one component instead of
+    // deinterleaving {real, imag} pairs.
+    template <class T = float>
+    class ComplexArray
+    {
+        static_assert(std::is_arithmetic<T>::value, "ComplexArray type must be arithmetic");
+
+    protected:
+        Vector<T> c_real;
+        Vector<T> c_imag;
+
+    public:
+        using value_type = Complex<T>;
+        using scalar_type = T;
+
+        ComplexArray();
+        ComplexArray(size_t size);
+        ComplexArray(size_t size, const Complex<T> &value);
+        ComplexArray(size_t size, uninitialized_t);
+        ComplexArray(Vector<T> real, Vector<T> imag);
+        ComplexArray(const Vector<Complex<T>> &v);
+        ComplexArray(std::initializer_list<Complex<T>> list);
+        template <class U>
+        ComplexArray(const ComplexArray<U> &c);
+
+        size_t size() const { return c_real.size(); }
+        Vector<T> &real() { return c_real; }
+        const Vector<T> &real() const { return c_real; }
+        Vector<T> &imag() { return c_imag; }
+        const Vector<T> &imag() const { return c_imag; }
+
+        Complex<T> operator[](size_t index) const { return Complex<T>(c_real[index], c_imag[index]); }
+        void set(size_t index, const Complex<T> &value);
+        void push_back(const Complex<T> &value);
+        void reserve(size_t capacity);
+        void clear();
+
+        // Back to the interleaved layout.
+        Vector<Complex<T>> toVector() const;
+
+        ComplexArray<T> &operator+=(const ComplexArray<T> &c);
+        ComplexArray<T> &operator-=(const ComplexArray<T> &c);
+        ComplexArray<T> &operator*=(const ComplexArray<T> &c);
+        ComplexArray<T> &operator/=(const ComplexArray<T> &c);
+        ComplexArray<T> &operator*=(const Complex<T> &value);
+        ComplexArray<T> &operator*=(const T &value);
+        ComplexArray<T> &operator/=(const T &value);
+
+        bool operator==(const ComplexArray<T> &c) const;
+        bool operator!=(const ComplexArray<T> &c) const;
+
+        ComplexArray<T> conjugate() const;
+        Vector<T> squared_modulus() const;
+        Vector<double> modulus() const;
+        Vector<double> argz() const;
+
+        friend std::ostream &operator<<(std::ostream &os, const ComplexArray<T> &c)
+        {
+            os << "[";
+            for (size_t i = 0; i < c.size(); i++)
+            {
+                os << c[i];
+                if (i + 1 != c.size())
+                {
+                    os << ", ";
+                }
+            }
+            os << "]";
+            return os;
+        }
+    };
+
+    template <class T>
+    ComplexArray<T> operator+(ComplexArray<T> c1, const ComplexArray<T> &c2);
+    template <class T>
+    ComplexArray<T> operator-(ComplexArray<T> c1, const ComplexArray<T> &c2);
+    template <class T>
+    ComplexArray<T> operator*(ComplexArray<T> c1, const ComplexArray<T> &c2);
+    template <class T>
+    ComplexArray<T> operator/(ComplexArray<T> c1, const ComplexArray<T> &c2);
+    template <class T>
+    ComplexArray<T> operator*(ComplexArray<T> c, const typename ComplexArray<T>::value_type &value);
+    template <class T>
+    ComplexArray<T> operator*(const typename ComplexArray<T>::value_type &value, ComplexArray<T> c);
+    template <class T>
+    ComplexArray<T> operator*(ComplexArray<T> c, const typename ComplexArray<T>::scalar_type &value);
+    template <class T>
+    ComplexArray<T> operator*(const typename ComplexArray<T>::scalar_type &value, ComplexArray<T> c);
+    template <class T>
+    ComplexArray<T> operator/(ComplexArray<T> c, const typename ComplexArray<T>::scalar_type &value);
+
+}
+
+// Definitions; see the end of Vector.hpp for ATMATH_EXTERN_TEMPLATES.
+#include "ComplexArray.cpp"
+
+#define ATMATH_COMPLEX_ARRAY_INSTANCES(PREFIX, T)                            \
+    PREFIX class ComplexArray<T>;
+
+#if ATMATH_EXTERN_TEMPLATES
+namespace atMath
+{
+    ATMATH_COMPLEX_ARRAY_INSTANCES(extern template, float)
+    ATMATH_COMPLEX_ARRAY_INSTANCES(extern template, double)
+}
+#endif
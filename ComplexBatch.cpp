@@ -0,0 +1,325 @@
+#pragma once
+
+#include "ComplexBatch.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include "Simd.hpp"
+
+namespace atMath
+{
+
+    // Vector<Complex<T>> storage as 2 * size() interleaved T values.
+    template <class T>
+    T *interleaved(Vector<Complex<T>> &v) { return reinterpret_cast<T *>(v.data()); }
+    template <class T>
+    const T *interleaved(const Vector<Complex<T>> &v) { return reinterpret_cast<const T *>(v.data()); }
+
+    template <class T>
+    void prepare_binary(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out)
+    {
+        if (a.size() != b.size())
+        {
+            throw std::runtime_error("Vectors must be the same size.");
+        }
+        if (out.size() != a.size())
+        {
+            out = Vector<Complex<T>>(a.size(), uninitialized);
+        }
+    }
+
+    // Runs kernel(out, a, b, n) over matching blocks of three interleaved
+    // arrays of n complex values; out may alias a or b.
+    template <class Policy, class T, class Kernel>
+    void interleaved_blocks(const Policy &policy, T *out, const T *a, const T *b, size_t n, Kernel kernel)
+    {
+        execution::for_each_block(policy, n, execution::elementwise_block, [&](size_t begin, size_t end)
+                                  { kernel(out + 2 * begin, a + 2 * begin, b + 2 * begin, end - begin); });
+    }
+
+    template <class T>
+    void multiply(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out)
+    {
+        multiply(execution::seq, a, b, out);
+    }
+
+    template <class Policy, class T>
+    auto multiply(const Policy &policy, const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out) -> std::enable_if_t<execution::is_execution_policy<Policy>::value>
+    {
+        prepare_binary(a, b, out);
+        interleaved_blocks(policy, interleaved(out), interleaved(a), interleaved(b), a.size(), simd::complex_mul<T>);
+    }
+
+    template <class T>
+    Vector<Complex<T>> multiply(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b)
+    {
+        Vector<Complex<T>> out;
+        multiply(a, b, out);
+        return out;
+    }
+
+    template <class T>
+    void multiply_conjugate(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out)
+    {
+        multiply_conjugate(execution::seq, a, b, out);
+    }
+
+    template <class Policy, class T>
+    auto multiply_conjugate(const Policy &policy, const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out) -> std::enable_if_t<execution::is_execution_policy<Policy>::value>
+    {
+        prepare_binary(a, b, out);
+        interleaved_blocks(policy, interleaved(out), interleaved(a), interleaved(b), a.size(), simd::complex_mul_conj<T>);
+    }
+
+    template <class T>
+    Vector<Complex<T>> multiply_conjugate(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b)
+    {
+        Vector<Complex<T>> out;
+        multiply_conjugate(a, b, out);
+        return out;
+    }
+
+    template <class Policy, class T>
+    auto multiply_conjugate(const Policy &policy, const Vector<Complex<T>> &a, const Vector<Complex<T>> &b) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<Complex<T>>>
+    {
+        Vector<Complex<T>> out;
+        multiply_conjugate(policy, a, b, out);
+        return out;
+    }
+
+    template <class T>
+    void multiply_accumulate(Vector<Complex<T>> &acc, const Vector<Complex<T>> &a, const Vector<Complex<T>> &b)
+    {
+        multiply_accumulate(execution::seq, acc, a, b);
+    }
+
+    template <class Policy, class T>
+    auto multiply_accumulate(const Policy &policy, Vector<Complex<T>> &acc, const Vector<Complex<T>> &a, const Vector<Complex<T>> &b) -> std::enable_if_t<execution::is_execution_policy<Policy>::value>
+    {
+        if (a.size() != b.size() || acc.size() != a.size())
+        {
+            throw std::runtime_error("Vectors must be the same size.");
+        }
+        interleaved_blocks(policy, interleaved(acc), interleaved(a), interleaved(b), a.size(), simd::complex_mac<T>);
+    }
+
+    template <class T>
+    void divide(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out)
+    {
+        divide(execution::seq, a, b, out);
+    }
+
+    template <class Policy, class T>
+    auto divide(const Policy &policy, const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out) -> std::enable_if_t<execution::is_execution_policy<Policy>::value>
+    {
+        prepare_binary(a, b, out);
+        interleaved_blocks(policy, interleaved(out), interleaved(a), interleaved(b), a.size(), simd::complex_div<T>);
+    }
+
+    template <class T>
+    Vector<Complex<T>> divide(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b)
+    {
+        Vector<Complex<T>> out;
+        divide(a, b, out);
+        return out;
+    }
+
+    template <class T>
+    Vector<T> magnitude(const Vector<Complex<T>> &a)
+    {
+        return magnitude(execution::seq, a);
+    }
+
+    template <class Policy, class T>
+    auto magnitude(const Policy &policy, const Vector<Complex<T>> &a) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<T>>
+    {
+        Vector<T> result(a.size(), uninitialized);
+        execution::for_each_block(policy, a.size(), execution::elementwise_block, [&](size_t begin, size_t end)
+                                  { simd::complex_abs(result.data() + begin, interleaved(a) + 2 * begin, end - begin); });
+        return result;
+    }
+
+    template <class T>
+    Vector<T> phase(const Vector<Complex<T>> &a)
+    {
+        return phase(execution::seq, a);
+    }
+
+    template <class Policy, class T>
+    auto phase(const Policy &policy, const Vector<Complex<T>> &a) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<T>>
+    {
+        Vector<T> result(a.size(), uninitialized);
+        execution::for_each_block(policy, a.size(), execution::elementwise_block, [&](size_t begin, size_t end)
+                                  { simd::complex_arg(result.data() + begin, interleaved(a) + 2 * begin, end - begin); });
+        return result;
+    }
+
+    namespace fast
+    {
+
+        // Runs a split-lane kernel over interleaved storage, BLOCK elements at
+        // a time through stack buffers, so no heap scratch is needed. Each
+        // policy block converts its own range on its own stack.
+        template <class Policy, class T, class Kernel>
+        Vector<Complex<T>> apply_interleaved(const Policy &policy, const Vector<Complex<T>> &z, Kernel kernel)
+        {
+            constexpr size_t BLOCK = 256;
+            Vector<Complex<T>> result(z.size(), uninitialized);
+            const Complex<T> *src = z.data();
+            Complex<T> *dst = result.data();
+            execution::for_each_block(policy, z.size(), execution::elementwise_block, [&](size_t begin, size_t end)
+                                      {
+                T re[BLOCK], im[BLOCK];
+                for (size_t start = begin; start < end; start += BLOCK)
+                {
+                    size_t count = std::min(BLOCK, end - start);
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        re[i] = src[start + i].real;
+                        im[i] = src[start + i].imag;
+                    }
+                    kernel(re, im, re, im, count);
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        dst[start + i].real = re[i];
+                        dst[start + i].imag = im[i];
+                    }
+                } });
+            return result;
+        }
+
+        template <class Policy, class T, class Kernel>
+        ComplexArray<T> apply_split(const Policy &policy, const ComplexArray<T> &z, Kernel kernel)
+        {
+            ComplexArray<T> result(z.size(), uninitialized);
+            const T *re = z.real().data(), *im = z.imag().data();
+            T *out_re = result.real().data(), *out_im = result.imag().data();
+            execution::for_each_block(policy, z.size(), execution::elementwise_block, [&](size_t begin, size_t end)
+                                      { kernel(re + begin, im + begin, out_re + begin, out_im + begin, end - begin); });
+            return result;
+        }
+
+        template <class T>
+        ComplexArray<T> exp(const ComplexArray<T> &z)
+        {
+            return exp(execution::seq, z);
+        }
+
+        template <class Policy, class T>
+        auto exp(const Policy &policy, const ComplexArray<T> &z) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, ComplexArray<T>>
+        {
+            return apply_split(policy, z, simd::complex_exp<T>);
+        }
+
+        template <class T>
+        ComplexArray<T> log(const ComplexArray<T> &z)
+        {
+            return log(execution::seq, z);
+        }
+
+        template <class Policy, class T>
+        auto log(const Policy &policy, const ComplexArray<T> &z) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, ComplexArray<T>>
+        {
+            return apply_split(policy, z, simd::complex_log<T>);
+        }
+
+        template <class T>
+        ComplexArray<T> sqrt(const ComplexArray<T> &z)
+        {
+            return sqrt(execution::seq, z);
+        }
+
+        template <class Policy, class T>
+        auto sqrt(const Policy &policy, const ComplexArray<T> &z) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, ComplexArray<T>>
+        {
+            return apply_split(policy, z, simd::complex_sqrt<T>);
+        }
+
+        template <class T>
+        ComplexArray<T> pow(const ComplexArray<T> &z, const Complex<T> &w)
+        {
+            return pow(execution::seq, z, w);
+        }
+
+        template <class Policy, class T>
+        auto pow(const Policy &policy, const ComplexArray<T> &z, const Complex<T> &w) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, ComplexArray<T>>
+        {
+            return apply_split(policy, z, [&w](const T *re, const T *im, T *out_re, T *out_im, size_t n)
+                               { simd::complex_pow(re, im, w.real, w.imag, out_re, out_im, n); });
+        }
+
+        template <class T>
+        ComplexArray<T> pow(const ComplexArray<T> &z, typename ComplexArray<T>::scalar_type p)
+        {
+            return pow(z, Complex<T>(p, 0));
+        }
+
+        template <class Policy, class T>
+        auto pow(const Policy &policy, const ComplexArray<T> &z, typename ComplexArray<T>::scalar_type p) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, ComplexArray<T>>
+        {
+            return pow(policy, z, Complex<T>(p, 0));
+        }
+
+        template <class T>
+        Vector<Complex<T>> exp(const Vector<Complex<T>> &z)
+        {
+            return exp(execution::seq, z);
+        }
+
+        template <class Policy, class T>
+        auto exp(const Policy &policy, const Vector<Complex<T>> &z) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<Complex<T>>>
+        {
+            return apply_interleaved(policy, z, simd::complex_exp<T>);
+        }
+
+        template <class T>
+        Vector<Complex<T>> log(const Vector<Complex<T>> &z)
+        {
+            return log(execution::seq, z);
+        }
+
+        template <class Policy, class T>
+        auto log(const Policy &policy, const Vector<Complex<T>> &z) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<Complex<T>>>
+        {
+            return apply_interleaved(policy, z, simd::complex_log<T>);
+        }
+
+        template <class T>
+        Vector<Complex<T>> sqrt(const Vector<Complex<T>> &z)
+        {
+            return sqrt(execution::seq, z);
+        }
+
+        template <class Policy, class T>
+        auto sqrt(const Policy &policy, const Vector<Complex<T>> &z) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<Complex<T>>>
+        {
+            return apply_interleaved(policy, z, simd::complex_sqrt<T>);
+        }
+
+        template <class T>
+        Vector<Complex<T>> pow(const Vector<Complex<T>> &z, const Complex<T> &w)
+        {
+            return pow(execution::seq, z, w);
+        }
+
+        template <class Policy, class T>
+        auto pow(const Policy &policy, const Vector<Complex<T>> &z, const Complex<T> &w) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<Complex<T>>>
+        {
+            return apply_interleaved(policy, z, [&w](const T *re, const T *im, T *out_re, T *out_im, size_t n)
+                                     { simd::complex_pow(re, im, w.real, w.imag, out_re, out_im, n); });
+        }
+
+        template <class T>
+        Vector<Complex<T>> pow(const Vector<Complex<T>> &z, typename ComplexArray<T>::scalar_type p)
+        {
+            return pow(z, Complex<T>(p, 0));
+        }
+
+        template <class Policy, class T>
+        auto pow(const Policy &policy, const Vector<Complex<T>> &z, typename ComplexArray<T>::scalar_type p) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<Complex<T>>>
+        {
+            return pow(policy, z, Complex<T>(p, 0));
+        }
+
+    }
+
+}
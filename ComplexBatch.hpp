@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cstddef>
+#include "Complex.hpp"
+#include "ComplexArray.hpp"
+#include "Vector.hpp"
+
+// Elementwise kernels over Vector<Complex<float>> and Vector<Complex<double>>
+// that work on the interleaved storage directly through the SIMD kernels in
+// Simd.hpp (FMA where available), instead of one Complex operator call per
+// element. These are the inner loops of correlation and beamforming: x * y,
+// x * conj(y), acc += x * y.
+//
+// The out-parameter forms resize out only when its size differs, so a reused
+// output buffer is never reallocated; out may be the same vector as a or b.
+namespace atMath
+{
+
+    template <class T>
+    void multiply(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out);
+    template <class T>
+    Vector<Complex<T>> multiply(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b);
+
+    // out[i] = a[i] * conj(b[i]).
+    template <class T>
+    void multiply_conjugate(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out);
+    template <class T>
+    Vector<Complex<T>> multiply_conjugate(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b);
+
+    // acc[i] += a[i] * b[i].
+    template <class T>
+    void multiply_accumulate(Vector<Complex<T>> &acc, const Vector<Complex<T>> &a, const Vector<Complex<T>> &b);
+
+    // out[i] = a[i] / b[i], computed as a[i] * conj(b[i]) / |b[i]|^2.
+    template <class T>
+    void divide(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out);
+    template <class T>
+    Vector<Complex<T>> divide(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b);
+
+    // |a[i]| and arg(a[i]) in the element type. Unlike Complex::modulus and
+    // Complex::argz these stay in T, and the phase comes from fast::atan2
+    // (|error| <= 2e-8 before rounding to T).
+    template <class T>
+    Vector<T> magnitude(const Vector<Complex<T>> &a);
+    template <class T>
+    Vector<T> phase(const Vector<Complex<T>> &a);
+
+    // The same kernels under an execution policy; par and par_unseq split
+    // large vectors across ThreadPool::global() as add/multiply do in
+    // Vector.hpp. multiply and divide returning a new vector are already
+    // covered by those overloads.
+    template <class Policy, class T>
+    auto multiply(const Policy &policy, const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out) -> std::enable_if_t<execution::is_execution_policy<Policy>::value>;
+    template <class Policy, class T>
+    auto multiply_conjugate(const Policy &policy, const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out) -> std::enable_if_t<execution::is_execution_policy<Policy>::value>;
+    template <class Policy, class T>
+    auto multiply_conjugate(const Policy &policy, const Vector<Complex<T>> &a, const Vector<Complex<T>> &b) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<Complex<T>>>;
+    template <class Policy, class T>
+    auto multiply_accumulate(const Policy &policy, Vector<Complex<T>> &acc, const Vector<Complex<T>> &a, const Vector<Complex<T>> &b) -> std::enable_if_t<execution::is_execution_policy<Policy>::value>;
+    template <class Policy, class T>
+    auto divide(const Policy &policy, const Vector<Complex<T>> &a, const Vector<Complex<T>> &b, Vector<Complex<T>> &out) -> std::enable_if_t<execution::is_execution_policy<Policy>::value>;
+    template <class Policy, class T>
+    auto magnitude(const Policy &policy, const Vector<Complex<T>> &a) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<T>>;
+    template <class Policy, class T>
+    auto phase(const Policy &policy, const Vector<Complex<T>> &a) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<T>>;
+
+    namespace fast
+    {
+
+        // Batch fast::exp, log, sqrt and pow (FastMath.hpp) for T = float,
+        // vectorized over split real/imaginary lanes; Vector<Complex<float>>
+        // inputs are split block by block on the stack. Measured against
+        // double-precision std::complex, as ulps of |result|:
+        //   exp   <= 3 ulps, for |imag| <= 8192
+        //   log   <= 2 ulps of max(|log z|, 1)
+        //   sqrt  <= 2 ulps
+        //   pow   <= 3 (1 + |w log z|) ulps, the rounding of w log z
+        // for 1e-18 < |z| < 1e18. Results below FLT_MIN flush to 0.
+        template <class T>
+        ComplexArray<T> exp(const ComplexArray<T> &z);
+        template <class T>
+        ComplexArray<T> log(const ComplexArray<T> &z);
+        template <class T>
+        ComplexArray<T> sqrt(const ComplexArray<T> &z);
+        template <class T>
+        ComplexArray<T> pow(const ComplexArray<T> &z, const Complex<T> &w);
+        template <class T>
+        ComplexArray<T> pow(const ComplexArray<T> &z, typename ComplexArray<T>::scalar_type p);
+
+        template <class T>
+        Vector<Complex<T>> exp(const Vector<Complex<T>> &z);
+        template <class T>
+        Vector<Complex<T>> log(const Vector<Complex<T>> &z);
+        template <class T>
+        Vector<Complex<T>> sqrt(const Vector<Complex<T>> &z);
+        template <class T>
+        Vector<Complex<T>> pow(const Vector<Complex<T>> &z, const Complex<T> &w);
+        template <class T>
+        Vector<Complex<T>> pow(const Vector<Complex<T>> &z, typename ComplexArray<T>::scalar_type p);
+
+        // Policy forms of the above.
+        template <class Policy, class T>
+        auto exp(const Policy &policy, const ComplexArray<T> &z) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, ComplexArray<T>>;
+        template <class Policy, class T>
+        auto log(const Policy &policy, const ComplexArray<T> &z) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, ComplexArray<T>>;
+        template <class Policy, class T>
+        auto sqrt(const Policy &policy, const ComplexArray<T> &z) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, ComplexArray<T>>;
+        template <class Policy, class T>
+        auto pow(const Policy &policy, const ComplexArray<T> &z, const Complex<T> &w) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, ComplexArray<T>>;
+        template <class Policy, class T>
+        auto pow(const Policy &policy, const ComplexArray<T> &z, typename ComplexArray<T>::scalar_type p) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, ComplexArray<T>>;
+        template <class Policy, class T>
+        auto exp(const Policy &policy, const Vector<Complex<T>> &z) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<Complex<T>>>;
+        template <class Policy, class T>
+        auto log(const Policy &policy, const Vector<Complex<T>> &z) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<Complex<T>>>;
+        template <class Policy, class T>
+        auto sqrt(const Policy &policy, const Vector<Complex<T>> &z) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<Complex<T>>>;
+        template <class Policy, class T>
+        auto pow(const Policy &policy, const Vector<Complex<T>> &z, const Complex<T> &w) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<Complex<T>>>;
+        template <class Policy, class T>
+        auto pow(const Policy &policy, const Vector<Complex<T>> &z, typename ComplexArray<T>::scalar_type p) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<Complex<T>>>;
+
+    }
+
+}
+
+// Definitions; see the end of Vector.hpp for ATMATH_EXTERN_TEMPLATES.
+#include "ComplexBatch.cpp"
+
+#define ATMATH_COMPLEX_BATCH_INSTANCES(PREFIX, T)                            \
+    PREFIX void multiply(const Vector<Complex<T>> &,                         \
+        const Vector<Complex<T>> &, Vector<Complex<T>> &);                   \
+    PREFIX Vector<Complex<T>> multiply(const Vector<Complex<T>> &,           \
+        const Vector<Complex<T>> &);                                         \
+    PREFIX void multiply_conjugate(const Vector<Complex<T>> &,               \
+        const Vector<Complex<T>> &, Vector<Complex<T>> &);                   \
+    PREFIX Vector<Complex<T>> multiply_conjugate(const Vector<Complex<T>> &, \
+        const Vector<Complex<T>> &);                                         \
+    PREFIX void divide(const Vector<Complex<T>> &,                           \
+        const Vector<Complex<T>> &, Vector<Complex<T>> &);                   \
+    PREFIX Vector<Complex<T>> divide(const Vector<Complex<T>> &,             \
+        const Vector<Complex<T>> &);                                         \
+    PREFIX void multiply_accumulate(Vector<Complex<T>> &,                    \
+        const Vector<Complex<T>> &, const Vector<Complex<T>> &);             \
+    PREFIX Vector<T> magnitude(const Vector<Complex<T>> &);                  \
+    PREFIX Vector<T> phase(const Vector<Complex<T>> &);
+
+#if ATMATH_EXTERN_TEMPLATES
+namespace atMath
+{
+    ATMATH_COMPLEX_BATCH_INSTANCES(extern template, float)
+    ATMATH_COMPLEX_BATCH_INSTANCES(extern template, double)
+}
+#endif
@@ -0,0 +1,29 @@
+#include "Complex.hpp"
+#include "ComplexArray.hpp"
+#include "ComplexBatch.hpp"
+#include "FFT.hpp"
+
+// Explicit instantiations compiled into the atMath library; the matching
+// extern template declarations are at the end of each header.
+namespace atMath
+{
+    ATMATH_COMPLEX_INSTANCES(template, int)
+    ATMATH_COMPLEX_INSTANCES(template, float)
+    ATMATH_COMPLEX_INSTANCES(template, double)
+    ATMATH_COMPLEX_INSTANCES(template, uint32_t)
+    ATMATH_COMPLEX_INSTANCES(template, uint64_t)
+    ATMATH_COMPLEX_INSTANCES(template, int64_t)
+    ATMATH_COMPLEX_INSTANCES(template, uint8_t)
+    ATMATH_COMPLEX_INSTANCES(template, int8_t)
+    ATMATH_COMPLEX_INSTANCES(template, uint16_t)
+    ATMATH_COMPLEX_INSTANCES(template, int16_t)
+
+    ATMATH_COMPLEX_ARRAY_INSTANCES(template, float)
+    ATMATH_COMPLEX_ARRAY_INSTANCES(template, double)
+
+    ATMATH_COMPLEX_BATCH_INSTANCES(template, float)
+    ATMATH_COMPLEX_BATCH_INSTANCES(template, double)
+
+    ATMATH_FFT_INSTANCES(template, float)
+    ATMATH_FFT_INSTANCES(template, double)
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include <typeinfo>
+
+// Vector operations that convert between element types (float += double,
+// appending an int to a Vector<float>, ...) are reported through
+// note_conversion<From, To>(). What that does is chosen at compile time:
+//
+//   default                          nothing, the call compiles away
+//   ATMATH_CONVERSION_DIAGNOSTICS    count every converting call and forward
+//                                    it to an optional user sink
+//   ATMATH_STRICT_CONVERSIONS        reject converting calls at compile time
+namespace atMath
+{
+    namespace diagnostics
+    {
+
+        using ConversionSink = void (*)(const std::type_info &from, const std::type_info &to);
+
+        inline std::atomic<size_t> &conversion_count()
+        {
+            static std::atomic<size_t> count{0};
+            return count;
+        }
+
+        inline std::atomic<ConversionSink> &conversion_sink()
+        {
+            static std::atomic<ConversionSink> sink{nullptr};
+            return sink;
+        }
+
+        inline void set_conversion_sink(ConversionSink sink)
+        {
+            conversion_sink().store(sink);
+        }
+
+        template <class From, class To>
+        inline void note_conversion()
+        {
+#ifdef ATMATH_STRICT_CONVERSIONS
+            static_assert(std::is_same<From, To>::value, "Implicit element type conversion; convert the operand explicitly.");
+#endif
+#ifdef ATMATH_CONVERSION_DIAGNOSTICS
+            if constexpr (!std::is_same<From, To>::value)
+            {
+                conversion_count().fetch_add(1, std::memory_order_relaxed);
+                if (ConversionSink sink = conversion_sink().load(std::memory_order_relaxed))
+                {
+                    sink(typeid(From), typeid(To));
+                }
+            }
+#endif
+        }
+
+    }
+}
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <vector>
+#include "ThreadPool.hpp"
+
+// Execution policies for the Vector reductions and elementwise operations
+// and the batch kernels over ComplexArray, QuaternionArray and Vec3Array,
+// modelled on std::execution. seq runs on the calling thread; par and
+// par_unseq spread blocks over ThreadPool::global() once a vector is large
+// enough to amortize the hand-off. Block bodies always use the SIMD kernels,
+// so par and par_unseq behave the same.
+//
+// Reductions are deterministic: the input is cut into fixed blocks of
+// reduction_block elements, each block is reduced on its own, and the block
+// results are combined pairwise in a fixed tree. The split depends only on
+// the length, so seq, par and par_unseq return bit-identical results for any
+// thread count, and a vector shorter than one block gives exactly what the
+// policy-free call gives.
+namespace atMath
+{
+    namespace execution
+    {
+
+        struct sequenced_policy
+        {
+        };
+        struct parallel_policy
+        {
+        };
+        struct parallel_unsequenced_policy
+        {
+        };
+
+        constexpr sequenced_policy seq{};
+        constexpr parallel_policy par{};
+        constexpr parallel_unsequenced_policy par_unseq{};
+
+        template <class Policy>
+        struct is_execution_policy : std::false_type
+        {
+        };
+        template <>
+        struct is_execution_policy<sequenced_policy> : std::true_type
+        {
+        };
+        template <>
+        struct is_execution_policy<parallel_policy> : std::true_type
+        {
+        };
+        template <>
+        struct is_execution_policy<parallel_unsequenced_policy> : std::true_type
+        {
+        };
+
+        template <class Policy>
+        constexpr bool is_parallel = !std::is_same<Policy, sequenced_policy>::value;
+
+        // 16K elements: 64 KB of float, about one L2 slice per block.
+        constexpr size_t reduction_block = size_t(1) << 14;
+        // Elementwise operations hand out blocks of this many elements, and
+        // stay on the caller below two of them.
+        constexpr size_t elementwise_block = size_t(1) << 16;
+
+        // Runs body(begin, end) over consecutive blocks covering [0, n).
+        template <class Policy>
+        void for_each_block(const Policy &, size_t n, size_t block, const std::function<void(size_t, size_t)> &body)
+        {
+            static_assert(is_execution_policy<Policy>::value, "Expected an atMath::execution policy");
+            size_t blocks = (n + block - 1) / block;
+            auto run = [&](size_t b)
+            { body(b * block, std::min(n, (b + 1) * block)); };
+            if (is_parallel<Policy> && blocks > 1)
+            {
+                ThreadPool::global().parallel_for(blocks, run);
+                return;
+            }
+            for (size_t b = 0; b < blocks; b++)
+            {
+                run(b);
+            }
+        }
+
+        // Reduces [0, n) as block_result(begin, end) per reduction_block
+        // elements, then sums the block results pairwise: (b0 + b1) + (b2 + b3)
+        // and so on up the tree.
+        template <class R, class Policy, class F>
+        R reduce_blocks(const Policy &policy, size_t n, F block_result)
+        {
+            if (n <= reduction_block)
+            {
+                return block_result(0, n);
+            }
+            std::vector<R> partials((n + reduction_block - 1) / reduction_block);
+            for_each_block(policy, n, reduction_block, [&](size_t begin, size_t end)
+                           { partials[begin / reduction_block] = block_result(begin, end); });
+            for (size_t width = 1; width < partials.size(); width *= 2)
+            {
+                for (size_t i = 0; i + width < partials.size(); i += 2 * width)
+                {
+                    partials[i] += partials[i + width];
+                }
+            }
+            return partials[0];
+        }
+
+    }
+}
@@ -0,0 +1,589 @@
+#pragma once
+
+#include "FFT.hpp"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+
+namespace atMath
+{
+
+    // Radix sequence for n under a strategy, as (radix, remaining length)
+    // pairs ordered from the outermost level inwards.
+    inline std::vector<size_t> fft_factorize(size_t n, FFTStrategy strategy)
+    {
+        std::vector<size_t> radices;
+        size_t remaining = n;
+        size_t radix = strategy == FFTStrategy::radix2 ? 2 : 4;
+        while (remaining > 1)
+        {
+            while (remaining % radix != 0)
+            {
+                radix = radix == 4 ? 2 : radix == 2 ? 3 : radix + 2;
+                if (radix * radix > remaining)
+                {
+                    radix = remaining;
+                }
+            }
+            remaining /= radix;
+            radices.push_back(radix);
+        }
+        if (strategy == FFTStrategy::odd_first)
+        {
+            std::stable_partition(radices.begin(), radices.end(), [](size_t p) { return p % 2 != 0; });
+        }
+
+        std::vector<size_t> factors;
+        remaining = n;
+        for (size_t p : radices)
+        {
+            remaining /= p;
+            factors.push_back(p);
+            factors.push_back(remaining);
+        }
+        return factors;
+    }
+
+    template <class T>
+    std::shared_ptr<const FFTTwiddles<T>> fft_twiddles(size_t n, FFTStrategy strategy)
+    {
+        static_assert(std::is_floating_point<T>::value, "FFT requires floating point data");
+        static std::mutex mutex;
+        static std::map<std::pair<size_t, FFTStrategy>, std::shared_ptr<const FFTTwiddles<T>>> cache;
+        std::lock_guard<std::mutex> lock(mutex);
+        auto found = cache.find({n, strategy});
+        if (found != cache.end())
+        {
+            return found->second;
+        }
+
+        auto table = std::make_shared<FFTTwiddles<T>>();
+        table->n = n;
+        table->strategy = strategy;
+        table->factors = fft_factorize(n, strategy);
+        table->max_radix = 1;
+        for (size_t f = 0; f < table->factors.size(); f += 2)
+        {
+            table->max_radix = std::max(table->max_radix, table->factors[f]);
+        }
+
+        // Generated in double and rounded once, so float tables carry no
+        // accumulated error from the angle computation.
+        const double PI = 3.14159265358979323846;
+        table->re.resize(n);
+        table->im.resize(n);
+        for (size_t k = 0; k < n; k++)
+        {
+            Complex<double> w = Complex<double>::rotate(-2 * PI * static_cast<double>(k) / static_cast<double>(n));
+            table->re[k] = static_cast<T>(w.real);
+            table->im[k] = static_cast<T>(w.imag);
+        }
+        cache[{n, strategy}] = table;
+        return table;
+    }
+
+    // One decimation-in-time level: the p sub-transforms of length m are
+    // computed recursively into consecutive blocks of the output and then
+    // merged by a radix-p butterfly. fstride is the twiddle stride of this
+    // level; sign is the sign of the exponent, +1 for the inverse transform.
+    template <class T>
+    void fft_work(T *ore, T *oim, ptrdiff_t os, const T *ire, const T *iim, ptrdiff_t is, size_t fstride,
+                  const size_t *factors, const FFTTwiddles<T> &tw, T sign, Complex<T> *scratch)
+    {
+        const size_t p = factors[0];
+        const size_t m = factors[1];
+        const ptrdiff_t step = static_cast<ptrdiff_t>(fstride) * is;
+        if (m == 1)
+        {
+            for (size_t j = 0; j < p; j++)
+            {
+                ore[j * os] = ire[j * step];
+                oim[j * os] = iim[j * step];
+            }
+        }
+        else
+        {
+            for (size_t j = 0; j < p; j++)
+            {
+                fft_work(ore + j * m * os, oim + j * m * os, os, ire + j * step, iim + j * step, is, fstride * p, factors + 2, tw, sign, scratch);
+            }
+        }
+
+        // The table holds e^{-...}; the inverse runs on its conjugate.
+        const T *wr = tw.re.data();
+        const T *wi = tw.im.data();
+        const T tw_sign = -sign;
+        const ptrdiff_t ms = static_cast<ptrdiff_t>(m) * os;
+        if (p == 2)
+        {
+            for (size_t k = 0; k < m; k++)
+            {
+                T *r0 = ore + k * os, *i0 = oim + k * os;
+                T cr = wr[k * fstride], ci = tw_sign * wi[k * fstride];
+                T tr = r0[ms] * cr - i0[ms] * ci;
+                T ti = r0[ms] * ci + i0[ms] * cr;
+                r0[ms] = *r0 - tr;
+                i0[ms] = *i0 - ti;
+                *r0 += tr;
+                *i0 += ti;
+            }
+        }
+        else if (p == 4)
+        {
+            for (size_t k = 0; k < m; k++)
+            {
+                T *r = ore + k * os, *i = oim + k * os;
+                size_t t1 = k * fstride, t2 = 2 * t1, t3 = 3 * t1;
+                T s0r = r[ms] * wr[t1] - i[ms] * tw_sign * wi[t1];
+                T s0i = r[ms] * tw_sign * wi[t1] + i[ms] * wr[t1];
+                T s1r = r[2 * ms] * wr[t2] - i[2 * ms] * tw_sign * wi[t2];
+                T s1i = r[2 * ms] * tw_sign * wi[t2] + i[2 * ms] * wr[t2];
+                T s2r = r[3 * ms] * wr[t3] - i[3 * ms] * tw_sign * wi[t3];
+                T s2i = r[3 * ms] * tw_sign * wi[t3] + i[3 * ms] * wr[t3];
+                T s5r = r[0] - s1r, s5i = i[0] - s1i;
+                T f0r = r[0] + s1r, f0i = i[0] + s1i;
+                T s3r = s0r + s2r, s3i = s0i + s2i;
+                T s4r = s0r - s2r, s4i = s0i - s2i;
+                r[2 * ms] = f0r - s3r;
+                i[2 * ms] = f0i - s3i;
+                r[0] = f0r + s3r;
+                i[0] = f0i + s3i;
+                // Multiply s4 by -i (forward) or +i (inverse).
+                r[ms] = s5r - sign * s4i;
+                i[ms] = s5i + sign * s4r;
+                r[3 * ms] = s5r + sign * s4i;
+                i[3 * ms] = s5i - sign * s4r;
+            }
+        }
+        else
+        {
+            const size_t n = tw.n;
+            for (size_t u = 0; u < m; u++)
+            {
+                for (size_t q = 0; q < p; q++)
+                {
+                    scratch[q] = Complex<T>(ore[(u + q * m) * os], oim[(u + q * m) * os]);
+                }
+                for (size_t q1 = 0; q1 < p; q1++)
+                {
+                    size_t k = u + q1 * m;
+                    T accr = scratch[0].real, acci = scratch[0].imag;
+                    size_t twidx = 0;
+                    for (size_t q = 1; q < p; q++)
+                    {
+                        twidx += fstride * k;
+                        if (twidx >= n)
+                        {
+                            twidx %= n;
+                        }
+                        T cr = wr[twidx], ci = tw_sign * wi[twidx];
+                        accr += scratch[q].real * cr - scratch[q].imag * ci;
+                        acci += scratch[q].real * ci + scratch[q].imag * cr;
+                    }
+                    ore[k * os] = accr;
+                    oim[k * os] = acci;
+                }
+            }
+        }
+    }
+
+    // Runs a transform of tw.n > 1 points; scratch holds tw.max_radix values.
+    template <class T>
+    void fft_execute(const FFTTwiddles<T> &tw, Complex<T> *scratch, const T *in_re, const T *in_im, ptrdiff_t in_stride,
+                     T *out_re, T *out_im, ptrdiff_t out_stride, bool inverse)
+    {
+        fft_work(out_re, out_im, out_stride, in_re, in_im, in_stride, 1, tw.factors.data(), tw, inverse ? T(1) : T(-1), scratch);
+        if (inverse)
+        {
+            T scale = T(1) / static_cast<T>(tw.n);
+            for (size_t k = 0; k < tw.n; k++)
+            {
+                out_re[k * out_stride] *= scale;
+                out_im[k * out_stride] *= scale;
+            }
+        }
+    }
+
+    template <class T>
+    void fft_strided(const T *in_re, const T *in_im, ptrdiff_t in_stride, T *out_re, T *out_im, ptrdiff_t out_stride, size_t n, bool inverse)
+    {
+        static_assert(std::is_floating_point<T>::value, "FFT requires floating point data");
+        if (n <= 1)
+        {
+            if (n == 1)
+            {
+                *out_re = *in_re;
+                *out_im = *in_im;
+            }
+            return;
+        }
+        std::shared_ptr<const FFTTwiddles<T>> tw = fft_twiddles<T>(n);
+        std::vector<Complex<T>> scratch(tw->max_radix);
+        fft_execute(*tw, scratch.data(), in_re, in_im, in_stride, out_re, out_im, out_stride, inverse);
+    }
+
+    // Interleaved Complex<T> storage seen as two T lanes with stride 2. Pointer
+    // arithmetic rather than member access, so an empty vector's null data()
+    // passes through untouched.
+    template <class T>
+    T *real_lane(Complex<T> *data) { return reinterpret_cast<T *>(data); }
+    template <class T>
+    T *imag_lane(Complex<T> *data) { return reinterpret_cast<T *>(data) + 1; }
+    template <class T>
+    const T *real_lane(const Complex<T> *data) { return reinterpret_cast<const T *>(data); }
+    template <class T>
+    const T *imag_lane(const Complex<T> *data) { return reinterpret_cast<const T *>(data) + 1; }
+
+    template <class T>
+    void fft(const Vector<Complex<T>> &x, Vector<Complex<T>> &out)
+    {
+        if (&out == &x)
+        {
+            fft_inplace(out);
+            return;
+        }
+        if (out.size() != x.size())
+        {
+            out = Vector<Complex<T>>(x.size(), uninitialized);
+        }
+        fft_strided(real_lane(x.data()), imag_lane(x.data()), 2, real_lane(out.data()), imag_lane(out.data()), 2, x.size(), false);
+    }
+
+    template <class T>
+    void ifft(const Vector<Complex<T>> &x, Vector<Complex<T>> &out)
+    {
+        if (&out == &x)
+        {
+            ifft_inplace(out);
+            return;
+        }
+        if (out.size() != x.size())
+        {
+            out = Vector<Complex<T>>(x.size(), uninitialized);
+        }
+        fft_strided(real_lane(x.data()), imag_lane(x.data()), 2, real_lane(out.data()), imag_lane(out.data()), 2, x.size(), true);
+    }
+
+    template <class T>
+    Vector<Complex<T>> fft(const Vector<Complex<T>> &x)
+    {
+        Vector<Complex<T>> out(x.size(), uninitialized);
+        fft(x, out);
+        return out;
+    }
+
+    template <class T>
+    Vector<Complex<T>> ifft(const Vector<Complex<T>> &x)
+    {
+        Vector<Complex<T>> out(x.size(), uninitialized);
+        ifft(x, out);
+        return out;
+    }
+
+    template <class T>
+    void fft_inplace(Vector<Complex<T>> &x)
+    {
+        Vector<Complex<T>> input(x);
+        fft(input, x);
+    }
+
+    template <class T>
+    void ifft_inplace(Vector<Complex<T>> &x)
+    {
+        Vector<Complex<T>> input(x);
+        ifft(input, x);
+    }
+
+    template <class T>
+    ComplexArray<T> fft(const ComplexArray<T> &x)
+    {
+        ComplexArray<T> out(x.size(), uninitialized);
+        fft_strided(x.real().data(), x.imag().data(), 1, out.real().data(), out.imag().data(), 1, x.size(), false);
+        return out;
+    }
+
+    template <class T>
+    ComplexArray<T> ifft(const ComplexArray<T> &x)
+    {
+        ComplexArray<T> out(x.size(), uninitialized);
+        fft_strided(x.real().data(), x.imag().data(), 1, out.real().data(), out.imag().data(), 1, x.size(), true);
+        return out;
+    }
+
+    template <class T>
+    void fft_inplace(ComplexArray<T> &x)
+    {
+        x = fft(static_cast<const ComplexArray<T> &>(x));
+    }
+
+    template <class T>
+    void ifft_inplace(ComplexArray<T> &x)
+    {
+        x = ifft(static_cast<const ComplexArray<T> &>(x));
+    }
+
+    template <class T>
+    Vector<Complex<T>> rfft(const Vector<T> &x)
+    {
+        static_assert(std::is_floating_point<T>::value, "FFT requires floating point data");
+        const size_t n = x.size();
+        if (n == 0)
+        {
+            return Vector<Complex<T>>();
+        }
+        Vector<Complex<T>> result(n / 2 + 1, uninitialized);
+        if (n % 2 != 0)
+        {
+            Vector<Complex<T>> full(n, uninitialized);
+            for (size_t j = 0; j < n; j++)
+            {
+                full.at_unchecked(j) = Complex<T>(x.at_unchecked(j), 0);
+            }
+            Vector<Complex<T>> spectrum = fft(full);
+            for (size_t k = 0; k <= n / 2; k++)
+            {
+                result.at_unchecked(k) = spectrum.at_unchecked(k);
+            }
+            return result;
+        }
+
+        // Even samples as the real part and odd samples as the imaginary part
+        // of a half-length signal z; its spectrum Z is then split into the
+        // even and odd halves and recombined: X[k] = E[k] + W^k O[k].
+        const size_t h = n / 2;
+        Vector<Complex<T>> z(h, uninitialized);
+        const T *src = x.data();
+        fft_strided(src, src + 1, 2, real_lane(z.data()), imag_lane(z.data()), 2, h, false);
+        std::shared_ptr<const FFTTwiddles<T>> tw = fft_twiddles<T>(n);
+        for (size_t k = 0; k <= h; k++)
+        {
+            const Complex<T> &a = z.at_unchecked(k % h);
+            const Complex<T> &b = z.at_unchecked((h - k) % h);
+            T er = (a.real + b.real) / 2, ei = (a.imag - b.imag) / 2;
+            T orr = (a.imag + b.imag) / 2, oi = (b.real - a.real) / 2;
+            T wr = tw->re[k], wi = tw->im[k];
+            result.at_unchecked(k) = Complex<T>(er + orr * wr - oi * wi, ei + orr * wi + oi * wr);
+        }
+        return result;
+    }
+
+    template <class T>
+    Vector<T> irfft(const Vector<Complex<T>> &spectrum, size_t n)
+    {
+        static_assert(std::is_floating_point<T>::value, "FFT requires floating point data");
+        if (spectrum.size() != n / 2 + 1)
+        {
+            throw std::runtime_error("Spectrum must hold n / 2 + 1 bins.");
+        }
+        Vector<T> result(n, uninitialized);
+        if (n == 0)
+        {
+            return result;
+        }
+        if (n % 2 != 0)
+        {
+            Vector<Complex<T>> full(n, uninitialized);
+            for (size_t k = 0; k <= n / 2; k++)
+            {
+                full.at_unchecked(k) = spectrum.at_unchecked(k);
+                if (k != 0)
+                {
+                    full.at_unchecked(n - k) = spectrum.at_unchecked(k).conjugate();
+                }
+            }
+            Vector<Complex<T>> signal = ifft(full);
+            for (size_t j = 0; j < n; j++)
+            {
+                result.at_unchecked(j) = signal.at_unchecked(j).real;
+            }
+            return result;
+        }
+
+        // Undo the rfft recombination: E[k] = (X[k] + conj(X[h-k])) / 2,
+        // O[k] = (X[k] - conj(X[h-k])) / 2 * W^-k, Z[k] = E[k] + i O[k].
+        const size_t h = n / 2;
+        Vector<Complex<T>> z(h, uninitialized);
+        std::shared_ptr<const FFTTwiddles<T>> tw = fft_twiddles<T>(n);
+        for (size_t k = 0; k < h; k++)
+        {
+            const Complex<T> &a = spectrum.at_unchecked(k);
+            const Complex<T> &b = spectrum.at_unchecked(h - k);
+            T er = (a.real + b.real) / 2, ei = (a.imag - b.imag) / 2;
+            T dr = (a.real - b.real) / 2, di = (a.imag + b.imag) / 2;
+            T wr = tw->re[k], wi = -tw->im[k];
+            T orr = dr * wr - di * wi, oi = dr * wi + di * wr;
+            z.at_unchecked(k) = Complex<T>(er - oi, ei + orr);
+        }
+        T *dst = result.data();
+        fft_strided(real_lane(z.data()), imag_lane(z.data()), 2, dst, dst + 1, 2, h, true);
+        return result;
+    }
+
+    template <class T>
+    FFTPlan<T>::FFTPlan(size_t size, FFTStrategy strategy) : p_size(size)
+    {
+        p_twiddles = fft_twiddles<T>(size, strategy);
+        p_scratch.resize(p_twiddles->max_radix);
+        p_work.resize(2 * size);
+    }
+
+    template <class T>
+    FFTPlan<T>::FFTPlan(size_t size, FFTPlanMode mode) : FFTPlan(size, FFTStrategy::radix4)
+    {
+        if (mode != FFTPlanMode::measure || size <= 1)
+        {
+            return;
+        }
+
+        std::vector<T> in(2 * size), out(2 * size);
+        for (size_t k = 0; k < 2 * size; k++)
+        {
+            in[k] = static_cast<T>((k * 7919) % 1024) / T(1024);
+        }
+        const size_t reps = std::max<size_t>(1, (1 << 16) / size);
+        double best = 0;
+        for (FFTStrategy candidate : {FFTStrategy::radix4, FFTStrategy::radix2, FFTStrategy::odd_first})
+        {
+            std::shared_ptr<const FFTTwiddles<T>> tw = fft_twiddles<T>(size, candidate);
+            if (candidate != FFTStrategy::radix4 && tw->factors == p_twiddles->factors)
+            {
+                continue;
+            }
+            std::vector<Complex<T>> scratch(tw->max_radix);
+            double elapsed = 0;
+            // Best of three rounds, to shrug off a preempted round.
+            for (int round = 0; round < 3; round++)
+            {
+                auto start = std::chrono::steady_clock::now();
+                for (size_t r = 0; r < reps; r++)
+                {
+                    fft_execute(*tw, scratch.data(), in.data(), in.data() + 1, 2, out.data(), out.data() + 1, 2, false);
+                }
+                double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+                elapsed = round == 0 ? t : std::min(elapsed, t);
+            }
+            if (candidate == FFTStrategy::radix4 || elapsed < best)
+            {
+                best = elapsed;
+                p_twiddles = tw;
+            }
+        }
+        p_scratch.resize(p_twiddles->max_radix);
+    }
+
+    template <class T>
+    void FFTPlan<T>::transform(const T *in_re, const T *in_im, ptrdiff_t in_stride, T *out_re, T *out_im, ptrdiff_t out_stride, bool inverse)
+    {
+        if (p_size <= 1)
+        {
+            if (p_size == 1)
+            {
+                *out_re = *in_re;
+                *out_im = *in_im;
+            }
+            return;
+        }
+        fft_execute(*p_twiddles, p_scratch.data(), in_re, in_im, in_stride, out_re, out_im, out_stride, inverse);
+    }
+
+    template <class T>
+    void FFTPlan<T>::transform(Vector<Complex<T>> &x, bool inverse)
+    {
+        if (x.size() != p_size)
+        {
+            throw std::runtime_error("Input size does not match the FFT plan.");
+        }
+        std::copy(real_lane(x.data()), real_lane(x.data()) + 2 * p_size, p_work.begin());
+        transform(p_work.data(), p_work.data() + 1, 2, real_lane(x.data()), imag_lane(x.data()), 2, inverse);
+    }
+
+    template <class T>
+    void FFTPlan<T>::transform(ComplexArray<T> &x, bool inverse)
+    {
+        if (x.size() != p_size)
+        {
+            throw std::runtime_error("Input size does not match the FFT plan.");
+        }
+        std::copy(x.real().data(), x.real().data() + p_size, p_work.begin());
+        std::copy(x.imag().data(), x.imag().data() + p_size, p_work.begin() + p_size);
+        transform(p_work.data(), p_work.data() + p_size, 1, x.real().data(), x.imag().data(), 1, inverse);
+    }
+
+    template <class T>
+    void FFTPlan<T>::forward(const Vector<Complex<T>> &x, Vector<Complex<T>> &out)
+    {
+        if (&out == &x)
+        {
+            transform(out, false);
+            return;
+        }
+        if (x.size() != p_size)
+        {
+            throw std::runtime_error("Input size does not match the FFT plan.");
+        }
+        if (out.size() != p_size)
+        {
+            out = Vector<Complex<T>>(p_size, uninitialized);
+        }
+        transform(real_lane(x.data()), imag_lane(x.data()), 2, real_lane(out.data()), imag_lane(out.data()), 2, false);
+    }
+
+    template <class T>
+    void FFTPlan<T>::inverse(const Vector<Complex<T>> &x, Vector<Complex<T>> &out)
+    {
+        if (&out == &x)
+        {
+            transform(out, true);
+            return;
+        }
+        if (x.size() != p_size)
+        {
+            throw std::runtime_error("Input size does not match the FFT plan.");
+        }
+        if (out.size() != p_size)
+        {
+            out = Vector<Complex<T>>(p_size, uninitialized);
+        }
+        transform(real_lane(x.data()), imag_lane(x.data()), 2, real_lane(out.data()), imag_lane(out.data()), 2, true);
+    }
+
+    template <class T>
+    void FFTPlan<T>::forward(const ComplexArray<T> &x, ComplexArray<T> &out)
+    {
+        if (&out == &x)
+        {
+            transform(out, false);
+            return;
+        }
+        if (x.size() != p_size)
+        {
+            throw std::runtime_error("Input size does not match the FFT plan.");
+        }
+        if (out.size() != p_size)
+        {
+            out = ComplexArray<T>(p_size, uninitialized);
+        }
+        transform(x.real().data(), x.imag().data(), 1, out.real().data(), out.imag().data(), 1, false);
+    }
+
+    template <class T>
+    void FFTPlan<T>::inverse(const ComplexArray<T> &x, ComplexArray<T> &out)
+    {
+        if (&out == &x)
+        {
+            transform(out, true);
+            return;
+        }
+        if (x.size() != p_size)
+        {
+            throw std::runtime_error("Input size does not match the FFT plan.");
+        }
+        if (out.size() != p_size)
+        {
+            out = ComplexArray<T>(p_size, uninitialized);
+        }
+        transform(x.real().data(), x.imag().data(), 1, out.real().data(), out.imag().data(), 1, true);
+    }
+
+}
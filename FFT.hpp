@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include "Complex.hpp"
+#include "ComplexArray.hpp"
+#include "Vector.hpp"
+
+// Discrete Fourier transforms over Vector<Complex<T>> (interleaved) and
+// ComplexArray<T> (split real/imaginary lanes), for any length. Lengths are
+// factored into radix-4 and radix-2 stages with dedicated butterflies, and
+// any remaining prime factors use a generic DFT butterfly. Twiddle tables are
+// built once per (type, length) and cached process-wide.
+//
+// Conventions: fft computes X[k] = sum x[j] e^{-2 pi i jk / n}; ifft uses
+// e^{+2 pi i jk / n} and divides by n, so ifft(fft(x)) == x.
+namespace atMath
+{
+
+    // Order in which a length is split into butterfly stages. radix4 takes
+    // factors of 4 first, radix2 only uses 2 for the power-of-two part, and
+    // odd_first moves the generic odd-radix stages to the outermost levels.
+    enum class FFTStrategy
+    {
+        radix4,
+        radix2,
+        odd_first
+    };
+
+    // Factorization and twiddles e^{-2 pi i k / n}, k < n, for one length.
+    template <class T>
+    struct FFTTwiddles
+    {
+        size_t n;
+        FFTStrategy strategy;
+        size_t max_radix;
+        std::vector<size_t> factors; // (radix, remaining length) pairs
+        std::vector<T> re;
+        std::vector<T> im;
+    };
+
+    template <class T>
+    std::shared_ptr<const FFTTwiddles<T>> fft_twiddles(size_t n, FFTStrategy strategy = FFTStrategy::radix4);
+
+    // Transforms n points read at (in_re[j * in_stride], in_im[j * in_stride])
+    // into (out_re, out_im, out_stride). Both layouts reduce to this: stride 2
+    // over the interleaved storage of Vector<Complex<T>>, stride 1 over the
+    // lanes of a ComplexArray. Input and output must not overlap.
+    template <class T>
+    void fft_strided(const T *in_re, const T *in_im, ptrdiff_t in_stride, T *out_re, T *out_im, ptrdiff_t out_stride, size_t n, bool inverse);
+
+    template <class T>
+    Vector<Complex<T>> fft(const Vector<Complex<T>> &x);
+    template <class T>
+    Vector<Complex<T>> ifft(const Vector<Complex<T>> &x);
+    template <class T>
+    void fft(const Vector<Complex<T>> &x, Vector<Complex<T>> &out);
+    template <class T>
+    void ifft(const Vector<Complex<T>> &x, Vector<Complex<T>> &out);
+    template <class T>
+    void fft_inplace(Vector<Complex<T>> &x);
+    template <class T>
+    void ifft_inplace(Vector<Complex<T>> &x);
+
+    template <class T>
+    ComplexArray<T> fft(const ComplexArray<T> &x);
+    template <class T>
+    ComplexArray<T> ifft(const ComplexArray<T> &x);
+    template <class T>
+    void fft_inplace(ComplexArray<T> &x);
+    template <class T>
+    void ifft_inplace(ComplexArray<T> &x);
+
+    // estimate picks the strategy from the factorization alone; measure times
+    // every distinct strategy on the plan's own buffers and keeps the fastest.
+    enum class FFTPlanMode
+    {
+        estimate,
+        measure
+    };
+
+    // A transform of one fixed length, set up once and reused. Construction
+    // resolves the factorization and twiddle table and allocates all working
+    // storage, so forward/inverse never allocate as long as the output
+    // already has the plan's size. The recursion is depth-first, so the
+    // innermost sub-transforms work on blocks small enough to stay in cache.
+    // A plan owns mutable scratch: use one plan per thread.
+    template <class T>
+    class FFTPlan
+    {
+        static_assert(std::is_floating_point<T>::value, "FFT requires floating point data");
+
+    protected:
+        size_t p_size;
+        std::shared_ptr<const FFTTwiddles<T>> p_twiddles;
+        std::vector<Complex<T>> p_scratch;
+        std::vector<T> p_work;
+
+        void transform(const T *in_re, const T *in_im, ptrdiff_t in_stride, T *out_re, T *out_im, ptrdiff_t out_stride, bool inverse);
+        void transform(Vector<Complex<T>> &x, bool inverse);
+        void transform(ComplexArray<T> &x, bool inverse);
+
+    public:
+        FFTPlan(size_t size, FFTPlanMode mode = FFTPlanMode::estimate);
+        FFTPlan(size_t size, FFTStrategy strategy);
+
+        size_t size() const { return p_size; }
+        FFTStrategy strategy() const { return p_twiddles->strategy; }
+        // (radix, remaining length) pairs, outermost stage first.
+        const std::vector<size_t> &factors() const { return p_twiddles->factors; }
+
+        void forward(const Vector<Complex<T>> &x, Vector<Complex<T>> &out);
+        void inverse(const Vector<Complex<T>> &x, Vector<Complex<T>> &out);
+        void forward(Vector<Complex<T>> &x) { transform(x, false); }
+        void inverse(Vector<Complex<T>> &x) { transform(x, true); }
+
+        void forward(const ComplexArray<T> &x, ComplexArray<T> &out);
+        void inverse(const ComplexArray<T> &x, ComplexArray<T> &out);
+        void forward(ComplexArray<T> &x) { transform(x, false); }
+        void inverse(ComplexArray<T> &x) { transform(x, true); }
+    };
+
+    // Real-input transform: returns the n / 2 + 1 non-redundant bins. Even
+    // lengths run as a half-length complex FFT.
+    template <class T>
+    Vector<Complex<T>> rfft(const Vector<T> &x);
+    // Inverse of rfft; n is the length of the original real signal.
+    template <class T>
+    Vector<T> irfft(const Vector<Complex<T>> &spectrum, size_t n);
+
+}
+
+// Definitions; see the end of Vector.hpp for ATMATH_EXTERN_TEMPLATES.
+#include "FFT.cpp"
+
+#define ATMATH_FFT_INSTANCES(PREFIX, T)                                      \
+    PREFIX class FFTPlan<T>;                                                 \
+    PREFIX std::shared_ptr<const FFTTwiddles<T>> fft_twiddles(size_t,        \
+        FFTStrategy);                                                        \
+    PREFIX Vector<Complex<T>> fft(const Vector<Complex<T>> &);               \
+    PREFIX Vector<Complex<T>> ifft(const Vector<Complex<T>> &);              \
+    PREFIX void fft_inplace(Vector<Complex<T>> &);                           \
+    PREFIX void ifft_inplace(Vector<Complex<T>> &);                          \
+    PREFIX ComplexArray<T> fft(const ComplexArray<T> &);                     \
+    PREFIX ComplexArray<T> ifft(const ComplexArray<T> &);                    \
+    PREFIX Vector<Complex<T>> rfft(const Vector<T> &);                       \
+    PREFIX Vector<T> irfft(const Vector<Complex<T>> &, size_t);
+
+#if ATMATH_EXTERN_TEMPLATES
+namespace atMath
+{
+    ATMATH_FFT_INSTANCES(extern template, float)
+    ATMATH_FFT_INSTANCES(extern template, double)
+}
+#endif
@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include "Complex.hpp"
+
+// Branch-free polynomial approximations for batch kernels. Unlike the libm
+// calls they inline into straight-line code, and the same coefficients drive
+// the explicit SIMD kernels in Simd.hpp. Bounds below are for the
+// approximation itself, evaluated in double; in float the rounding of the
+// evaluation (a few ulps) dominates.
+namespace atMath
+{
+    namespace fast
+    {
+
+        // Abramowitz & Stegun 4.4.46, highest power first:
+        // acos(x) = sqrt(1 - x) * p(x) for x in [0, 1].
+        constexpr double acos_coefficients[8] = {-0.0012624911, 0.0066700901, -0.0170881256, 0.0308918810,
+                                                 -0.0501743046, 0.0889789874, -0.2145988016, 1.5707963050};
+
+        // sin(x) = x (1 - x^2/(2*3) (1 - x^2/(4*5) (... (1 - x^2/(12*13))))),
+        // the Taylor series through x^13, innermost factor first.
+        constexpr double sin_factors[6] = {1.0 / 156, 1.0 / 110, 1.0 / 72, 1.0 / 42, 1.0 / 20, 1.0 / 6};
+
+        // Abramowitz & Stegun 4.4.49, highest power first:
+        // atan(x) = x * p(x^2) for x in [0, 1].
+        constexpr double atan_coefficients[9] = {0.0028662257, -0.0161657367, 0.0429096138, -0.0752896400, 0.1065626393,
+                                                 -0.1420889944, 0.1999355085, -0.3333314528, 1.0};
+
+        // Single-precision minimax polynomials from Cephes (expf, logf, sinf,
+        // cosf), highest power first. exp and sincos work on a reduced
+        // argument r: x = n ln2 + r and x = q pi/2 + r, with ln2 and pi/2 split
+        // in parts so that n * part and q * part are exact in float.
+        constexpr double exp_coefficients[6] = {1.9875691500e-4, 1.3981999507e-3, 8.3334519073e-3,
+                                                4.1665795894e-2, 1.6666665459e-1, 5.0000001201e-1};
+        constexpr double log_coefficients[9] = {7.0376836292e-2, -1.1514610310e-1, 1.1676998740e-1,
+                                                -1.2420140846e-1, 1.4249322787e-1, -1.6668057665e-1,
+                                                2.0000714765e-1, -2.4999993993e-1, 3.3333331174e-1};
+        constexpr double sinf_coefficients[3] = {-1.9515295891e-4, 8.3321608736e-3, -1.6666654611e-1};
+        constexpr double cosf_coefficients[3] = {2.443315711809948e-5, -1.388731625493765e-3, 4.166664568298827e-2};
+        constexpr double ln2_parts[2] = {0.693359375, -2.12194440e-4};
+        constexpr double pio2_parts[3] = {1.5703125, 4.837512969970703125e-4, 7.54978995489188216e-8};
+        // exp under/overflows outside [ln(FLT_MIN), ln(FLT_MAX)), where the
+        // bounds keep n within the normal exponent range.
+        constexpr double exp_min = -87.3365447504;
+        constexpr double exp_max = 88.3762626647;
+
+        // acos(x) for x in [-1, 1], |error| <= 2.2e-8.
+        template <class T>
+        inline T acos(T x)
+        {
+            T a = std::abs(x);
+            T p = T(acos_coefficients[0]);
+            for (size_t n = 1; n < 8; n++)
+            {
+                p = p * a + T(acos_coefficients[n]);
+            }
+            T r = std::sqrt(T(1) - a) * p;
+            return x < 0 ? T(3.14159265358979323846) - r : r;
+        }
+
+        // atan2(y, x) by reducing to atan of min(|x|, |y|) / max(|x|, |y|) in
+        // [0, 1] and unfolding by octant; |error| <= 2e-8. atan2(+-0, 0) is +-0.
+        template <class T>
+        inline T atan2(T y, T x)
+        {
+            T ax = std::abs(x), ay = std::abs(y);
+            T r = std::min(ax, ay) / std::max(std::max(ax, ay), std::numeric_limits<T>::min());
+            T r2 = r * r;
+            T p = T(atan_coefficients[0]);
+            for (size_t n = 1; n < 9; n++)
+            {
+                p = p * r2 + T(atan_coefficients[n]);
+            }
+            T a = r * p;
+            a = ax < ay ? T(1.57079632679489661923) - a : a;
+            a = x < 0 ? T(3.14159265358979323846) - a : a;
+            return std::copysign(a, y);
+        }
+
+        // sin(x) for x in [-pi/2, pi/2], |error| <= (pi/2)^15 / 15! < 7e-10.
+        template <class T>
+        inline T sin(T x)
+        {
+            T x2 = x * x;
+            T p = T(1);
+            for (double factor : sin_factors)
+            {
+                p = T(1) - x2 * T(factor) * p;
+            }
+            return x * p;
+        }
+
+        // e^x within 1 ulp in float; 0 below exp_min and inf above exp_max.
+        template <class T>
+        inline T exp(T x)
+        {
+            T xc = std::min(std::max(x, T(exp_min)), T(exp_max));
+            T n = std::nearbyint(xc * T(1.44269504088896341));
+            T r = xc - n * T(ln2_parts[0]) - n * T(ln2_parts[1]);
+            T p = T(exp_coefficients[0]);
+            for (size_t k = 1; k < 6; k++)
+            {
+                p = p * r + T(exp_coefficients[k]);
+            }
+            T y = std::ldexp(p * r * r + r + T(1), static_cast<int>(n));
+            return x < T(exp_min) ? T(0) : x > T(exp_max) ? std::numeric_limits<T>::infinity() : y;
+        }
+
+        // Natural log within 1 ulp in float for positive normal x; -inf for
+        // x below the smallest normal.
+        template <class T>
+        inline T log(T x)
+        {
+            int exponent;
+            T m = std::frexp(x, &exponent);
+            T e = static_cast<T>(exponent);
+            if (m < T(0.70710678118654752))
+            {
+                e -= 1;
+                m = m + m;
+            }
+            m -= 1;
+            T z = m * m;
+            T p = T(log_coefficients[0]);
+            for (size_t k = 1; k < 9; k++)
+            {
+                p = p * m + T(log_coefficients[k]);
+            }
+            T y = m * z * p + e * T(ln2_parts[1]) - T(0.5) * z;
+            T result = m + y + e * T(ln2_parts[0]);
+            return x < std::numeric_limits<T>::min() ? -std::numeric_limits<T>::infinity() : result;
+        }
+
+        // sin(x) and cos(x) from one range reduction, within 2 ulps of the
+        // larger of the two in float for |x| <= 8192; accuracy degrades
+        // gradually beyond that as q * pio2_parts[1] stops being exact.
+        template <class T>
+        inline void sincos(T x, T &s, T &c)
+        {
+            T q = std::nearbyint(x * T(0.636619772367581343));
+            T r = x - q * T(pio2_parts[0]) - q * T(pio2_parts[1]) - q * T(pio2_parts[2]);
+            T z = r * r;
+            T ps = T(sinf_coefficients[0]), pc = T(cosf_coefficients[0]);
+            for (size_t k = 1; k < 3; k++)
+            {
+                ps = ps * z + T(sinf_coefficients[k]);
+                pc = pc * z + T(cosf_coefficients[k]);
+            }
+            T sr = ps * z * r + r;
+            T cr = pc * z * z + (T(1) - T(0.5) * z);
+            // Quadrant k = q mod 4: (sin, cos) = (s, c), (c, -s), (-s, -c), (-c, s).
+            T k = q - 4 * std::floor(q * T(0.25));
+            bool odd = k == 1 || k == 3;
+            s = odd ? cr : sr;
+            c = odd ? sr : cr;
+            s = k >= 2 ? -s : s;
+            c = k == 1 || k == 2 ? -c : c;
+        }
+
+        // Complex<float> counterparts of the exp, log, sqrt and pow free
+        // functions in Complex.hpp, which promote to double and call libm per
+        // component. Accurate to a few float ulps of |result| (see
+        // ComplexBatch.hpp for the measured bounds) for 1e-18 < |z| < 1e18.
+        template <class T>
+        inline Complex<T> exp(const Complex<T> &z)
+        {
+            T s, c;
+            sincos(z.imag, s, c);
+            T m = exp(z.real);
+            return Complex<T>(m * c, m * s);
+        }
+
+        template <class T>
+        inline Complex<T> log(const Complex<T> &z)
+        {
+            return Complex<T>(T(0.5) * log(z.real * z.real + z.imag * z.imag), atan2(z.imag, z.real));
+        }
+
+        // Principal root, from the cancellation-free form
+        // t = sqrt((|re| + |z|) / 2).
+        template <class T>
+        inline Complex<T> sqrt(const Complex<T> &z)
+        {
+            T t = std::sqrt((std::abs(z.real) + std::sqrt(z.real * z.real + z.imag * z.imag)) * T(0.5));
+            T u = z.imag / (2 * std::max(t, std::numeric_limits<T>::min()));
+            if (z.real >= 0)
+            {
+                return Complex<T>(t, u);
+            }
+            return Complex<T>(std::abs(u), std::copysign(t, z.imag));
+        }
+
+        // z^w = exp(w log z), with 0^w = 0.
+        template <class T>
+        inline Complex<T> pow(const Complex<T> &z, const Complex<T> &w)
+        {
+            if (z.real * z.real + z.imag * z.imag < std::numeric_limits<T>::min())
+            {
+                return Complex<T>(0, 0);
+            }
+            Complex<T> l = log(z);
+            return exp(Complex<T>(w.real * l.real - w.imag * l.imag, w.real * l.imag + w.imag * l.real));
+        }
+
+        template <class T>
+        inline Complex<T> pow(const Complex<T> &z, T p)
+        {
+            return pow(z, Complex<T>(p, 0));
+        }
+
+    }
+}
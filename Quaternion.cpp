@@ -1,61 +1,44 @@
+#pragma once
+
 #include "Quaternion.hpp"
 
 namespace atMath{
 
     template <class T>
-    Quaternion<T>::Quaternion(T real, T i, T j, T k) : real(real), i(i), j(j), k(k){
+    constexpr Quaternion<T>::Quaternion(T real, T i, T j, T k) noexcept : real(real), i(i), j(j), k(k){
         static_assert(std::is_arithmetic<T>::value, "Quaternion type must be arithmetic");
     }
 
     template <class T>
-    Quaternion<T>::Quaternion(const T real) : real(real), i(0), j(0), k(0){
+    constexpr Quaternion<T>::Quaternion(const T real) noexcept : real(real), i(0), j(0), k(0){
         static_assert(std::is_arithmetic<T>::value, "Quaternion type must be arithmetic");
     }
 
     template <class T>
-    Quaternion<T>::Quaternion(const Complex<T> &c) : real(c.real), i(c.imag), j(0), k(0){
+    constexpr Quaternion<T>::Quaternion(const Complex<T> &c) noexcept : real(c.real), i(c.imag), j(0), k(0){
         static_assert(std::is_arithmetic<T>::value, "Quaternion type must be arithmetic");
     }
 
     template <class T>
     template <class U>
-    Quaternion<T>::Quaternion(const Complex<U> &c) : real(static_cast<T>(c.real)), i(static_cast<T>(c.imag)), j(0), k(0){
-        static_assert(std::is_arithmetic<T>::value, "Quaternion type must be arithmetic");
-    }
-
-    template <class T>
-    Quaternion<T>::Quaternion(const Quaternion<T> &q) : real(q.real), i(q.i), j(q.j), k(q.k){
+    constexpr Quaternion<T>::Quaternion(const Complex<U> &c) noexcept : real(static_cast<T>(c.real)), i(static_cast<T>(c.imag)), j(0), k(0){
         static_assert(std::is_arithmetic<T>::value, "Quaternion type must be arithmetic");
     }
 
     template <class T>
     template <class U>
-    Quaternion<T>::Quaternion(const Quaternion<U> &q) : real(static_cast<T>(q.real)), i(static_cast<T>(q.i)), j(static_cast<T>(q.j)), k(static_cast<T>(q.k)){
+    constexpr Quaternion<T>::Quaternion(const Quaternion<U> &q) noexcept : real(static_cast<T>(q.real)), i(static_cast<T>(q.i)), j(static_cast<T>(q.j)), k(static_cast<T>(q.k)){
         static_assert(std::is_arithmetic<T>::value, "Quaternion type must be arithmetic");
     }
 
     template <class T>
-    Quaternion<T>::Quaternion() : real(0), i(0), j(0), k(0){
+    constexpr Quaternion<T>::Quaternion() noexcept : real(0), i(0), j(0), k(0){
         static_assert(std::is_arithmetic<T>::value, "Quaternion type must be arithmetic");
     }
 
-    template <class T>
-    Quaternion<T>::~Quaternion(){}
-
-    template <class T>
-    Quaternion<T> &Quaternion<T>::operator=(const Quaternion<T> &q){
-        if (this != &q){
-            real = q.real;
-            i = q.i;
-            j = q.j;
-            k = q.k;
-        }
-        return *this;
-    }
-
     template <class T>
     template <class U>
-    Quaternion<T> &Quaternion<T>::operator=(const Quaternion<U> &q){
+    constexpr Quaternion<T> &Quaternion<T>::operator=(const Quaternion<U> &q) noexcept{
         real = static_cast<T>(q.real);
         i = static_cast<T>(q.i);
         j = static_cast<T>(q.j);
@@ -65,7 +48,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Quaternion<T> &Quaternion<T>::operator+=(const Quaternion<U> &q){
+    constexpr Quaternion<T> &Quaternion<T>::operator+=(const Quaternion<U> &q) noexcept{
         real += static_cast<T>(q.real);
         i += static_cast<T>(q.i);
         j += static_cast<T>(q.j);
@@ -75,7 +58,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Quaternion<T> &Quaternion<T>::operator-=(const Quaternion<U> &q){
+    constexpr Quaternion<T> &Quaternion<T>::operator-=(const Quaternion<U> &q) noexcept{
         real -= static_cast<T>(q.real);
         i -= static_cast<T>(q.i);
         j -= static_cast<T>(q.j);
@@ -85,7 +68,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Quaternion<T> &Quaternion<T>::operator*=(const Quaternion<U> &q){
+    constexpr Quaternion<T> &Quaternion<T>::operator*=(const Quaternion<U> &q) noexcept{
         T a = real;
         T b = i;
         T c = j;
@@ -105,7 +88,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Quaternion<T> &Quaternion<T>::operator/=(const Quaternion<U> &q){
+    constexpr Quaternion<T> &Quaternion<T>::operator/=(const Quaternion<U> &q) noexcept{
         T q0 = real;
         T q1 = i;
         T q2 = j;
@@ -128,7 +111,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Quaternion<T> &Quaternion<T>::operator=(const Complex<U> &c){
+    constexpr Quaternion<T> &Quaternion<T>::operator=(const Complex<U> &c) noexcept{
         real = static_cast<T>(c.real);
         i = static_cast<T>(c.imag);
         return *this;
@@ -136,7 +119,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Quaternion<T> &Quaternion<T>::operator+=(const Complex<U> &c){
+    constexpr Quaternion<T> &Quaternion<T>::operator+=(const Complex<U> &c) noexcept{
         real += static_cast<T>(c.real);
         i += static_cast<T>(c.imag);
         return *this;
@@ -144,7 +127,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Quaternion<T> &Quaternion<T>::operator-=(const Complex<U> &c){
+    constexpr Quaternion<T> &Quaternion<T>::operator-=(const Complex<U> &c) noexcept{
         real -= static_cast<T>(c.real);
         i -= static_cast<T>(c.imag);
         return *this;
@@ -152,21 +135,21 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    Quaternion<T> &Quaternion<T>::operator*=(const Complex<U> &c){
+    constexpr Quaternion<T> &Quaternion<T>::operator*=(const Complex<U> &c) noexcept{
         Quaternion<T> q(c);
         return *this *= q;
     }
 
     template <class T>
     template <class U>
-    Quaternion<T> &Quaternion<T>::operator/=(const Complex<U> &c){
+    constexpr Quaternion<T> &Quaternion<T>::operator/=(const Complex<U> &c) noexcept{
         Quaternion<T> q(c);
         return *this /= q;
     }
 
     template <class T>
     template <class U>
-    std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> Quaternion<T>::operator=(const U &value){
+    constexpr std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> Quaternion<T>::operator=(const U &value) noexcept{
         real = static_cast<T>(value);
         i = 0;
         j = 0;
@@ -176,21 +159,21 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> Quaternion<T>::operator+=(const U &value){
+    constexpr std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> Quaternion<T>::operator+=(const U &value) noexcept{
         real += static_cast<T>(value);
         return *this;
     }
 
     template <class T>
     template <class U>
-    std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> Quaternion<T>::operator-=(const U &value){
+    constexpr std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> Quaternion<T>::operator-=(const U &value) noexcept{
         real -= static_cast<T>(value);
         return *this;
     }
 
     template <class T>
     template <class U>
-    std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> Quaternion<T>::operator*=(const U &value){
+    constexpr std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> Quaternion<T>::operator*=(const U &value) noexcept{
         real *= static_cast<T>(value);
         i *= static_cast<T>(value);
         j *= static_cast<T>(value);
@@ -200,7 +183,7 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> Quaternion<T>::operator/=(const U &value){
+    constexpr std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> Quaternion<T>::operator/=(const U &value) noexcept{
         real /= static_cast<T>(value);
         i /= static_cast<T>(value);
         j /= static_cast<T>(value);
@@ -210,14 +193,14 @@ namespace atMath{
 
     template <class T>
     template <class U>
-    bool Quaternion<T>::operator==(const Quaternion<U> &q) const{
+    constexpr bool Quaternion<T>::operator==(const Quaternion<U> &q) const noexcept{
         float epsilon = 0.00001f;
-        return std::abs(real - static_cast<T>(q.real)) < epsilon && std::abs(i - static_cast<T>(q.i)) < epsilon && std::abs(j - static_cast<T>(q.j)) < epsilon && std::abs(k - static_cast<T>(q.k)) < epsilon;
+        return nearly_equal(real, static_cast<T>(q.real), epsilon) && nearly_equal(i, static_cast<T>(q.i), epsilon) && nearly_equal(j, static_cast<T>(q.j), epsilon) && nearly_equal(k, static_cast<T>(q.k), epsilon);
     }
 
     template <class T>
     template <class U>
-    bool Quaternion<T>::operator!=(const Quaternion<U> &q) const{
+    constexpr bool Quaternion<T>::operator!=(const Quaternion<U> &q) const noexcept{
         return !(*this == q);
     }
 
@@ -227,7 +210,7 @@ namespace atMath{
     }
 
     template <class T>
-    T Quaternion<T>::modulus_squared() const{
+    constexpr T Quaternion<T>::modulus_squared() const noexcept{
         return real * real + i * i + j * j + k * k;
     }
 
@@ -259,12 +242,12 @@ namespace atMath{
     }
     
     template <class T>
-    Quaternion<T> Quaternion<T>::conjugate() const{
+    constexpr Quaternion<T> Quaternion<T>::conjugate() const noexcept{
         return Quaternion<T>(real, -i, -j, -k);
     }
 
     template <class T>
-    auto Quaternion<T>::inverse() const -> Quaternion<decltype(1.f / (real * real + i * i + j * j + k * k))>{
+    constexpr auto Quaternion<T>::inverse() const noexcept -> Quaternion<decltype(1.f / (real * real + i * i + j * j + k * k))>{
         T norm_squared = real * real + i * i + j * j + k * k;
         Quaternion<decltype(1.f / norm_squared)> q(real, -i, -j, -k);
         q /= norm_squared;
@@ -272,133 +255,133 @@ namespace atMath{
     }
 
     template <class T, class U>
-    auto operator+(const Quaternion<T> &q1, const Quaternion<U> &q2) -> Quaternion<decltype(q1.real + q2.real)>{
+    constexpr auto operator+(const Quaternion<T> &q1, const Quaternion<U> &q2) noexcept -> Quaternion<decltype(q1.real + q2.real)>{
         Quaternion<decltype(q1.real + q2.real)> q(q1);
         q += q2;
         return q;
     }
 
     template <class T, class U>
-    auto operator-(const Quaternion<T> &q1, const Quaternion<U> &q2) -> Quaternion<decltype(q1.real - q2.real)>{
+    constexpr auto operator-(const Quaternion<T> &q1, const Quaternion<U> &q2) noexcept -> Quaternion<decltype(q1.real - q2.real)>{
         Quaternion<decltype(q1.real - q2.real)> q(q1);
         q -= q2;
         return q;
     }
 
     template <class T, class U>
-    auto operator*(const Quaternion<T> &q1, const Quaternion<U> &q2) -> Quaternion<decltype(q1.real * q2.real)>{
+    constexpr auto operator*(const Quaternion<T> &q1, const Quaternion<U> &q2) noexcept -> Quaternion<decltype(q1.real * q2.real)>{
         Quaternion<decltype(q1.real * q2.real)> q(q1);
         q *= q2;
         return q;
     }
     
     template <class T, class U>
-    auto operator/(const Quaternion<T> &q1, const Quaternion<U> &q2) -> Quaternion<decltype(1.f /(q2.real * q2.real + q2.i * q2.i + q2.j * q2.j + q2.k * q2.k))>{
+    constexpr auto operator/(const Quaternion<T> &q1, const Quaternion<U> &q2) noexcept -> Quaternion<decltype(1.f /(q2.real * q2.real + q2.i * q2.i + q2.j * q2.j + q2.k * q2.k))>{
         Quaternion<decltype(1.f /(q2.real * q2.real + q2.i * q2.i + q2.j * q2.j + q2.k * q2.k))> q(1.f * q1);
         q /= q2;
         return q;
     }
 
     template <class T, class U>
-    auto operator+(const Quaternion<T> &q, const Complex<U> &c) -> Quaternion<decltype(q.real + c.real)>{
+    constexpr auto operator+(const Quaternion<T> &q, const Complex<U> &c) noexcept -> Quaternion<decltype(q.real + c.real)>{
         Quaternion<decltype(q.real + c.real)> q1(q);
         q1 += c;
         return q1;
     }
 
     template <class T, class U>
-    auto operator+(const Complex<T> &c, const Quaternion<U> &q) -> Quaternion<decltype(c.real + q.real)>{
+    constexpr auto operator+(const Complex<T> &c, const Quaternion<U> &q) noexcept -> Quaternion<decltype(c.real + q.real)>{
         Quaternion<decltype(c.real + q.real)> q1(q);
         q1 += c;
         return q1;
     }
 
     template <class T, class U>
-    auto operator-(const Quaternion<T> &q, const Complex<U> &c) -> Quaternion<decltype(q.real - c.real)>{
+    constexpr auto operator-(const Quaternion<T> &q, const Complex<U> &c) noexcept -> Quaternion<decltype(q.real - c.real)>{
         Quaternion<decltype(q.real - c.real)> q1(q);
         q1 -= c;
         return q1;
     }
 
     template <class T, class U>
-    auto operator-(const Complex<T> &c, const Quaternion<U> &q) -> Quaternion<decltype(c.real - q.real)>{
+    constexpr auto operator-(const Complex<T> &c, const Quaternion<U> &q) noexcept -> Quaternion<decltype(c.real - q.real)>{
         Quaternion<decltype(c.real - q.real)> q1(-q);
         q1 += c;
         return q1;
     }
 
     template <class T, class U>
-    auto operator*(const Quaternion<T> &q, const Complex<U> &c) -> Quaternion<decltype(q.real * c.real)>{
+    constexpr auto operator*(const Quaternion<T> &q, const Complex<U> &c) noexcept -> Quaternion<decltype(q.real * c.real)>{
         Quaternion<decltype(q.real * c.real)> q1(q);
         q1 *= c;
         return q1;
     }
 
     template <class T, class U>
-    auto operator*(const Complex<T> &c, const Quaternion<U> &q) -> Quaternion<decltype(c.real * q.real)>{
+    constexpr auto operator*(const Complex<T> &c, const Quaternion<U> &q) noexcept -> Quaternion<decltype(c.real * q.real)>{
         Quaternion<decltype(c.real * q.real)> q1(c);
         q1 *= q;
         return q1;
     }
 
     template <class T, class U>
-    auto operator/(const Quaternion<T> &q, const Complex<U> &c) -> Quaternion<decltype(1.f / (c.real * c.real + c.imag * c.image))>{
+    constexpr auto operator/(const Quaternion<T> &q, const Complex<U> &c) noexcept -> Quaternion<decltype(1.f / (c.real * c.real + c.imag * c.image))>{
         Quaternion<decltype(1.f / (c.real * c.real + c.imag * c.image))> q1(1.f * q);
         q1 /= c;
         return q1;
     }
 
     template <class T, class U> 
-    auto operator/(const Complex<T> &c, const Quaternion<U> &q) -> Quaternion<decltype(1.f / (q.real * q.real + q.i * q.i + q.j * q.j + q.k * q.k))>{
+    constexpr auto operator/(const Complex<T> &c, const Quaternion<U> &q) noexcept -> Quaternion<decltype(1.f / (q.real * q.real + q.i * q.i + q.j * q.j + q.k * q.k))>{
         Quaternion<decltype(1.f / (q.real * q.real + q.i * q.i + q.j * q.j + q.k * q.k))> q1(1.f *c);
         q1 /= q;
         return q1;
     }
 
     template <class T, class U>
-    auto operator+(const Quaternion<T> &q, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(q.real + value)>>{
+    constexpr auto operator+(const Quaternion<T> &q, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(q.real + value)>>{
         Quaternion<decltype(q.real + value)> q1(q);
         q1 += value;
         return q1;
     }
 
     template <class T, class U>
-    auto operator+(const U &value, const Quaternion<T> &q) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(value + q.real)>>{
+    constexpr auto operator+(const U &value, const Quaternion<T> &q) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(value + q.real)>>{
         Quaternion<decltype(value + q.real)> q1(q);
         q1 += value;
         return q1;
     }
 
     template <class T, class U>
-    auto operator-(const Quaternion<T> &q, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(q.real - value)>>{
+    constexpr auto operator-(const Quaternion<T> &q, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(q.real - value)>>{
         Quaternion<decltype(q.real - value)> q1(q);
         q1 -= value;
         return q1;
     }
 
     template <class T, class U>
-    auto operator-(const U &value, const Quaternion<T> &q) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(value - q.real)>>{
+    constexpr auto operator-(const U &value, const Quaternion<T> &q) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(value - q.real)>>{
         Quaternion<decltype(value - q.real)> q1(-q);
         q1 += value;
         return q1;
     }
 
     template <class T, class U>
-    auto operator*(const Quaternion<T> &q, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(q.real * value)>>{
+    constexpr auto operator*(const Quaternion<T> &q, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(q.real * value)>>{
         Quaternion<decltype(q.real * value)> q1(q);
         q1 *= value;
         return q1;
     }
 
     template <class T, class U>
-    auto operator*(const U &value, const Quaternion<T> &q) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(value * q.real)>>{
+    constexpr auto operator*(const U &value, const Quaternion<T> &q) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(value * q.real)>>{
         Quaternion<decltype(value * q.real)> q1(q);
         q1 *= value;
         return q1;
     }
 
     template <class T, class U>
-    auto operator/(const Quaternion<T> &q, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(1.f * q.real / value)>>{
+    constexpr auto operator/(const Quaternion<T> &q, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(1.f * q.real / value)>>{
         Quaternion<decltype(1.f * q.real / value)> q1 = 1.f * q;
         //std::cout << 1.f *q << std::endl;
         q1 /= 1.f * value;
@@ -406,14 +389,68 @@ namespace atMath{
     }
 
     template <class T, class U>
-    auto operator/(const U &value, const Quaternion<T> &q) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(1.f / (q.real * q.real + q.i * q.i + q.j * q.j + q.k * q.k))>>{
+    constexpr auto operator/(const U &value, const Quaternion<T> &q) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(1.f / (q.real * q.real + q.i * q.i + q.j * q.j + q.k * q.k))>>{
         Quaternion<decltype(1.f / (q.real * q.real + q.i * q.i + q.j * q.j + q.k * q.k))> q1(1.f *value);
         q1 /= q;
         return q1;
     }
 
-    const Quaternion<int> j(0, 0, 1, 0);
-    const Quaternion<int> k(0, 0, 0, 1); 
+    template <class T>
+    Quaternion<T> nlerp(const Quaternion<T> &q0, const Quaternion<T> &q1, double t){
+        double sign = (q0.real * q1.real + q0.i * q1.i + q0.j * q1.j + q0.k * q1.k) < 0 ? -1 : 1;
+        double a = 1 - t;
+        double b = sign * t;
+        Quaternion<double> q(a * q0.real + b * q1.real, a * q0.i + b * q1.i, a * q0.j + b * q1.j, a * q0.k + b * q1.k);
+        return Quaternion<T>(q / q.modulus());
+    }
+
+    template <class T>
+    Quaternion<T> slerp(const Quaternion<T> &q0, const Quaternion<T> &q1, double t){
+        double d = q0.real * q1.real + q0.i * q1.i + q0.j * q1.j + q0.k * q1.k;
+        double sign = d < 0 ? -1 : 1;
+        d = std::abs(d);
+        // Nearly parallel: sin(theta) -> 0 and the arc is indistinguishable
+        // from the chord.
+        if (d > 0.9995){
+            return nlerp(q0, q1, t);
+        }
+        double theta = std::acos(d);
+        double s = std::sqrt(1 - d * d);
+        double a = std::sin((1 - t) * theta) / s;
+        double b = sign * std::sin(t * theta) / s;
+        return Quaternion<T>(static_cast<T>(a * q0.real + b * q1.real), static_cast<T>(a * q0.i + b * q1.i),
+                             static_cast<T>(a * q0.j + b * q1.j), static_cast<T>(a * q0.k + b * q1.k));
+    }
+
+    template <class T>
+    Quaternion<T> squad(const Quaternion<T> &q0, const Quaternion<T> &q1, const Quaternion<T> &s0, const Quaternion<T> &s1, double t){
+        return slerp(slerp(q0, q1, t), slerp(s0, s1, t), 2 * t * (1 - t));
+    }
+
+    // s = q exp(-(log(q^-1 next) + log(q^-1 previous)) / 4), with log and exp
+    // written out for unit quaternions so equal neighbouring keys (a zero
+    // vector part) do not divide by zero.
+    template <class T>
+    Quaternion<T> squad_tangent(const Quaternion<T> &previous, const Quaternion<T> &q, const Quaternion<T> &next){
+        Quaternion<double> inv(q.real, -q.i, -q.j, -q.k);
+        Quaternion<double> sum(0, 0, 0, 0);
+        for (Quaternion<double> r : {inv * next, inv * previous}){
+            if (r.real < 0){
+                r = -r;
+            }
+            double v_norm = std::sqrt(r.i * r.i + r.j * r.j + r.k * r.k);
+            double scale = v_norm > 1e-12 ? std::atan2(v_norm, r.real) / v_norm : 1;
+            sum += Quaternion<double>(0, scale * r.i, scale * r.j, scale * r.k);
+        }
+        sum *= -0.25;
+        double v_norm = std::sqrt(sum.i * sum.i + sum.j * sum.j + sum.k * sum.k);
+        double scale = v_norm > 1e-12 ? std::sin(v_norm) / v_norm : 1;
+        Quaternion<double> e(std::cos(v_norm), scale * sum.i, scale * sum.j, scale * sum.k);
+        return Quaternion<T>(Quaternion<double>(q) * e);
+    }
+
+    constexpr Quaternion<int> j(0, 0, 1, 0);
+    constexpr Quaternion<int> k(0, 0, 0, 1); 
 
 }
 
@@ -16,62 +16,62 @@ namespace atMath{
         T j;
         T k;
 
-        Quaternion(T real, T i, T j, T k);
-        Quaternion(const T real);
-        Quaternion(const Complex<T> &c);
+        ATMATH_FORCE_INLINE constexpr Quaternion(T real, T i, T j, T k) noexcept;
+        ATMATH_FORCE_INLINE constexpr Quaternion(const T real) noexcept;
+        ATMATH_FORCE_INLINE constexpr Quaternion(const Complex<T> &c) noexcept;
         template <class U>
-        Quaternion(const Complex<U> &c);
-        Quaternion(const Quaternion<T> &q);
+        ATMATH_FORCE_INLINE constexpr Quaternion(const Complex<U> &c) noexcept;
+        Quaternion(const Quaternion<T> &q) = default;
         template <class U>
-        Quaternion(const Quaternion<U> &q);
-        Quaternion();
-        ~Quaternion();
+        ATMATH_FORCE_INLINE constexpr Quaternion(const Quaternion<U> &q) noexcept;
+        ATMATH_FORCE_INLINE constexpr Quaternion() noexcept;
+        ~Quaternion() = default;
 
-        Quaternion<T> &operator=(const Quaternion<T> &q);
+        Quaternion<T> &operator=(const Quaternion<T> &q) = default;
         template <class U>
-        Quaternion<T> &operator=(const Quaternion<U> &q);
+        ATMATH_FORCE_INLINE constexpr Quaternion<T> &operator=(const Quaternion<U> &q) noexcept;
         template <class U>
-        Quaternion<T> &operator+=(const Quaternion<U> &q);
+        ATMATH_FORCE_INLINE constexpr Quaternion<T> &operator+=(const Quaternion<U> &q) noexcept;
         template <class U>
-        Quaternion<T> &operator-=(const Quaternion<U> &q);
+        ATMATH_FORCE_INLINE constexpr Quaternion<T> &operator-=(const Quaternion<U> &q) noexcept;
         template <class U>
-        Quaternion<T> &operator*=(const Quaternion<U> &q);
+        ATMATH_FORCE_INLINE constexpr Quaternion<T> &operator*=(const Quaternion<U> &q) noexcept;
         template <class U>
-        Quaternion<T> &operator/=(const Quaternion<U> &q);
+        ATMATH_FORCE_INLINE constexpr Quaternion<T> &operator/=(const Quaternion<U> &q) noexcept;
 
         template <class U>
-        Quaternion<T> &operator=(const Complex<U> &c);
+        ATMATH_FORCE_INLINE constexpr Quaternion<T> &operator=(const Complex<U> &c) noexcept;
         template <class U>
-        Quaternion<T> &operator+=(const Complex<U> &c);
+        ATMATH_FORCE_INLINE constexpr Quaternion<T> &operator+=(const Complex<U> &c) noexcept;
         template <class U>
-        Quaternion<T> &operator-=(const Complex<U> &c);
+        ATMATH_FORCE_INLINE constexpr Quaternion<T> &operator-=(const Complex<U> &c) noexcept;
         template <class U>
-        Quaternion<T> &operator*=(const Complex<U> &c);
+        ATMATH_FORCE_INLINE constexpr Quaternion<T> &operator*=(const Complex<U> &c) noexcept;
         template <class U>
-        Quaternion<T> &operator/=(const Complex<U> &c);
+        ATMATH_FORCE_INLINE constexpr Quaternion<T> &operator/=(const Complex<U> &c) noexcept;
 
         template <class U>
-        std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> operator=(const U &value);
+        ATMATH_FORCE_INLINE constexpr std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> operator=(const U &value) noexcept;
         template <class U>
-        std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> operator+=(const U &value);
+        ATMATH_FORCE_INLINE constexpr std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> operator+=(const U &value) noexcept;
         template <class U>
-        std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> operator-=(const U &value);
+        ATMATH_FORCE_INLINE constexpr std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> operator-=(const U &value) noexcept;
         template <class U>
-        std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> operator*=(const U &value);
+        ATMATH_FORCE_INLINE constexpr std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> operator*=(const U &value) noexcept;
         template <class U>
-        std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> operator/=(const U &value);
+        ATMATH_FORCE_INLINE constexpr std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<T> &> operator/=(const U &value) noexcept;
 
-        Quaternion<T> operator-() const{
+        ATMATH_FORCE_INLINE constexpr Quaternion<T> operator-() const noexcept{
             return Quaternion<T>(-real, -i, -j, -k);
         }
 
         template <class U>
-        bool operator==(const Quaternion<U> &q) const;
+        ATMATH_FORCE_INLINE constexpr bool operator==(const Quaternion<U> &q) const noexcept;
         template <class U>
-        bool operator!=(const Quaternion<U> &q) const;
+        ATMATH_FORCE_INLINE constexpr bool operator!=(const Quaternion<U> &q) const noexcept;
 
         double modulus() const;
-        T modulus_squared() const;
+        ATMATH_FORCE_INLINE constexpr T modulus_squared() const noexcept;
 
         Quaternion<double> pow(const double &exp) const;
         template <class U>
@@ -80,9 +80,9 @@ namespace atMath{
         Quaternion<double> pow(const Quaternion<U> &exp) const;
 
 
-        Quaternion<T> conjugate() const;
+        ATMATH_FORCE_INLINE constexpr Quaternion<T> conjugate() const noexcept;
 
-        auto inverse() const -> Quaternion<decltype(1.f / (real * real + i * i + j * j + k * k))>;
+        ATMATH_FORCE_INLINE constexpr auto inverse() const noexcept -> Quaternion<decltype(1.f / (real * real + i * i + j * j + k * k))>;
 
         friend std::ostream &operator<<(std::ostream &os, const Quaternion<T> &q){
             os << std::fixed << std::setprecision(3);
@@ -128,48 +128,71 @@ namespace atMath{
 
     };
 
+    // Quaternion<T> is trivially copyable and laid out as T[4] in the order
+    // real, i, j, k.
+    template <class T>
+    constexpr bool has_quaternion_layout = std::is_trivially_copyable<Quaternion<T>>::value && std::is_standard_layout<Quaternion<T>>::value &&
+                                           sizeof(Quaternion<T>) == sizeof(T[4]) && alignof(Quaternion<T>) == alignof(T) &&
+                                           offsetof(Quaternion<T>, i) == sizeof(T) && offsetof(Quaternion<T>, j) == 2 * sizeof(T) && offsetof(Quaternion<T>, k) == 3 * sizeof(T);
+    static_assert(has_quaternion_layout<float> && has_quaternion_layout<double>, "Quaternion<T> must match the layout of T[4]");
+
     template <class T, class U>
-    auto operator+(const Quaternion<T> &q1, const Quaternion<U> &q2) -> Quaternion<decltype(q1.real + q2.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator+(const Quaternion<T> &q1, const Quaternion<U> &q2) noexcept -> Quaternion<decltype(q1.real + q2.real)>;
     template <class T, class U>
-    auto operator-(const Quaternion<T> &q1, const Quaternion<U> &q2) -> Quaternion<decltype(q1.real - q2.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator-(const Quaternion<T> &q1, const Quaternion<U> &q2) noexcept -> Quaternion<decltype(q1.real - q2.real)>;
     template <class T, class U>
-    auto operator*(const Quaternion<T> &q1, const Quaternion<U> &q2) -> Quaternion<decltype(q1.real * q2.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator*(const Quaternion<T> &q1, const Quaternion<U> &q2) noexcept -> Quaternion<decltype(q1.real * q2.real)>;
     template <class T, class U>
-    auto operator/(const Quaternion<T> &q1, const Quaternion<U> &q2) -> Quaternion<decltype(1.f /(q2.real * q2.real + q2.i * q2.i + q2.j * q2.j + q2.k * q2.k))>;
+    ATMATH_FORCE_INLINE constexpr auto operator/(const Quaternion<T> &q1, const Quaternion<U> &q2) noexcept -> Quaternion<decltype(1.f /(q2.real * q2.real + q2.i * q2.i + q2.j * q2.j + q2.k * q2.k))>;
 
     template <class T, class U>
-    auto operator+(const Quaternion<T> &q, const Complex<U> &c) -> Quaternion<decltype(q.real + c.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator+(const Quaternion<T> &q, const Complex<U> &c) noexcept -> Quaternion<decltype(q.real + c.real)>;
     template <class T, class U>
-    auto operator+(const Complex<T> &c, const Quaternion<U> &q) -> Quaternion<decltype(c.real + q.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator+(const Complex<T> &c, const Quaternion<U> &q) noexcept -> Quaternion<decltype(c.real + q.real)>;
     template <class T, class U>
-    auto operator-(const Quaternion<T> &q, const Complex<U> &c) -> Quaternion<decltype(q.real - c.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator-(const Quaternion<T> &q, const Complex<U> &c) noexcept -> Quaternion<decltype(q.real - c.real)>;
     template <class T, class U>
-    auto operator-(const Complex<T> &c, const Quaternion<U> &q) -> Quaternion<decltype(c.real - q.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator-(const Complex<T> &c, const Quaternion<U> &q) noexcept -> Quaternion<decltype(c.real - q.real)>;
     template <class T, class U>
-    auto operator*(const Quaternion<T> &q, const Complex<U> &c) -> Quaternion<decltype(q.real * c.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator*(const Quaternion<T> &q, const Complex<U> &c) noexcept -> Quaternion<decltype(q.real * c.real)>;
     template <class T, class U>
-    auto operator*(const Complex<T> &c, const Quaternion<U> &q) -> Quaternion<decltype(c.real * q.real)>;
+    ATMATH_FORCE_INLINE constexpr auto operator*(const Complex<T> &c, const Quaternion<U> &q) noexcept -> Quaternion<decltype(c.real * q.real)>;
     template <class T, class U>
-    auto operator/(const Quaternion<T> &q, const Complex<U> &c) -> Quaternion<decltype(1.f / (c.real * c.real + c.imag * c.image))>;
+    ATMATH_FORCE_INLINE constexpr auto operator/(const Quaternion<T> &q, const Complex<U> &c) noexcept -> Quaternion<decltype(1.f / (c.real * c.real + c.imag * c.image))>;
     template <class T, class U> 
-    auto operator/(const Complex<T> &c, const Quaternion<U> &q) -> Quaternion<decltype(1.f / (q.real * q.real + q.i * q.i + q.j * q.j + q.k * q.k))>;
+    ATMATH_FORCE_INLINE constexpr auto operator/(const Complex<T> &c, const Quaternion<U> &q) noexcept -> Quaternion<decltype(1.f / (q.real * q.real + q.i * q.i + q.j * q.j + q.k * q.k))>;
 
     template <class T, class U>
-    auto operator+(const Quaternion<T> &q, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(q.real + value)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator+(const Quaternion<T> &q, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(q.real + value)>>;
     template <class T, class U>
-    auto operator+(const U &value, const Quaternion<T> &q) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(value + q.real)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator+(const U &value, const Quaternion<T> &q) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(value + q.real)>>;
     template <class T, class U>
-    auto operator-(const Quaternion<T> &q, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(q.real - value)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator-(const Quaternion<T> &q, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(q.real - value)>>;
     template <class T, class U>
-    auto operator-(const U &value, const Quaternion<T> &q) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(value - q.real)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator-(const U &value, const Quaternion<T> &q) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(value - q.real)>>;
     template <class T, class U>
-    auto operator*(const Quaternion<T> &q, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(q.real * value)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator*(const Quaternion<T> &q, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(q.real * value)>>;
     template <class T, class U>
-    auto operator*(const U &value, const Quaternion<T> &q) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(value * q.real)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator*(const U &value, const Quaternion<T> &q) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(value * q.real)>>;
     template <class T, class U>
-    auto operator/(const Quaternion<T> &q, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(1.f * q.real / value)>>;
+    ATMATH_FORCE_INLINE constexpr auto operator/(const Quaternion<T> &q, const U &value) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(1.f * q.real / value)>>;
     template <class T, class U>
-    auto operator/(const U &value, const Quaternion<T> &q) -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(1.f / (q.real * q.real + q.i * q.i + q.j * q.j + q.k * q.k))>>;
+    ATMATH_FORCE_INLINE constexpr auto operator/(const U &value, const Quaternion<T> &q) noexcept -> std::enable_if_t<std::is_arithmetic<U>::value, Quaternion<decltype(1.f / (q.real * q.real + q.i * q.i + q.j * q.j + q.k * q.k))>>;
+
+    // Interpolation between unit quaternions, t in [0, 1]. All of them take
+    // the shorter arc, i.e. q1 is negated when q0 . q1 < 0.
+    //   nlerp  normalized linear blend; cheap, not constant angular speed
+    //   slerp  constant angular speed along the great arc
+    //   squad  C1-continuous spline through keys q0, q1 whose inner control
+    //          points s0, s1 come from squad_tangent(previous, key, next)
+    template <class T>
+    Quaternion<T> nlerp(const Quaternion<T> &q0, const Quaternion<T> &q1, double t);
+    template <class T>
+    Quaternion<T> slerp(const Quaternion<T> &q0, const Quaternion<T> &q1, double t);
+    template <class T>
+    Quaternion<T> squad(const Quaternion<T> &q0, const Quaternion<T> &q1, const Quaternion<T> &s0, const Quaternion<T> &s1, double t);
+    template <class T>
+    Quaternion<T> squad_tangent(const Quaternion<T> &previous, const Quaternion<T> &q, const Quaternion<T> &next);
 
 }
 
@@ -180,3 +203,25 @@ template <class T>
 atMath::Quaternion<double> log(const atMath::Quaternion<T> &q);
 
 
+
+// Definitions; see the end of Vector.hpp for ATMATH_EXTERN_TEMPLATES.
+#include "Quaternion.cpp"
+
+#define ATMATH_QUATERNION_INSTANCES(PREFIX, T)                               \
+    PREFIX class Quaternion<T>;
+
+#if ATMATH_EXTERN_TEMPLATES
+namespace atMath
+{
+    ATMATH_QUATERNION_INSTANCES(extern template, int)
+    ATMATH_QUATERNION_INSTANCES(extern template, float)
+    ATMATH_QUATERNION_INSTANCES(extern template, double)
+    ATMATH_QUATERNION_INSTANCES(extern template, uint32_t)
+    ATMATH_QUATERNION_INSTANCES(extern template, uint64_t)
+    ATMATH_QUATERNION_INSTANCES(extern template, int64_t)
+    ATMATH_QUATERNION_INSTANCES(extern template, uint8_t)
+    ATMATH_QUATERNION_INSTANCES(extern template, int8_t)
+    ATMATH_QUATERNION_INSTANCES(extern template, uint16_t)
+    ATMATH_QUATERNION_INSTANCES(extern template, int16_t)
+}
+#endif
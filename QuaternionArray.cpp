@@ -0,0 +1,434 @@
+#pragma once
+
+#include "QuaternionArray.hpp"
+#include "Simd.hpp"
+#include <cmath>
+
+namespace atMath
+{
+
+    template <class T>
+    QuaternionArray<T>::QuaternionArray() : q_real(), q_i(), q_j(), q_k() {}
+
+    template <class T>
+    QuaternionArray<T>::QuaternionArray(size_t size) : q_real(size), q_i(size), q_j(size), q_k(size) {}
+
+    template <class T>
+    QuaternionArray<T>::QuaternionArray(size_t size, const Quaternion<T> &value) : q_real(size, value.real), q_i(size, value.i), q_j(size, value.j), q_k(size, value.k) {}
+
+    template <class T>
+    QuaternionArray<T>::QuaternionArray(size_t size, uninitialized_t) : q_real(size, uninitialized), q_i(size, uninitialized), q_j(size, uninitialized), q_k(size, uninitialized) {}
+
+    template <class T>
+    QuaternionArray<T>::QuaternionArray(Vector<T> real, Vector<T> i, Vector<T> j, Vector<T> k) : q_real(std::move(real)), q_i(std::move(i)), q_j(std::move(j)), q_k(std::move(k))
+    {
+        if (q_i.size() != q_real.size() || q_j.size() != q_real.size() || q_k.size() != q_real.size())
+        {
+            throw std::runtime_error("Quaternion lanes must be the same size.");
+        }
+    }
+
+    template <class T>
+    QuaternionArray<T>::QuaternionArray(const Vector<Quaternion<T>> &v) : QuaternionArray(v.size(), uninitialized)
+    {
+        const Quaternion<T> *src = v.data();
+        T *r = q_real.data();
+        T *qi = q_i.data();
+        T *qj = q_j.data();
+        T *qk = q_k.data();
+        for (size_t n = 0; n < v.size(); n++)
+        {
+            r[n] = src[n].real;
+            qi[n] = src[n].i;
+            qj[n] = src[n].j;
+            qk[n] = src[n].k;
+        }
+    }
+
+    template <class T>
+    QuaternionArray<T>::QuaternionArray(std::initializer_list<Quaternion<T>> list) : QuaternionArray(list.size(), uninitialized)
+    {
+        size_t n = 0;
+        for (const Quaternion<T> &q : list)
+        {
+            set(n++, q);
+        }
+    }
+
+    template <class T>
+    template <class U>
+    QuaternionArray<T>::QuaternionArray(const QuaternionArray<U> &q) : q_real(q.real()), q_i(q.i()), q_j(q.j()), q_k(q.k()) {}
+
+    template <class T>
+    void QuaternionArray<T>::set(size_t index, const Quaternion<T> &value)
+    {
+        q_real[index] = value.real;
+        q_i[index] = value.i;
+        q_j[index] = value.j;
+        q_k[index] = value.k;
+    }
+
+    template <class T>
+    void QuaternionArray<T>::push_back(const Quaternion<T> &value)
+    {
+        q_real.push_back(value.real);
+        q_i.push_back(value.i);
+        q_j.push_back(value.j);
+        q_k.push_back(value.k);
+    }
+
+    template <class T>
+    void QuaternionArray<T>::reserve(size_t capacity)
+    {
+        q_real.reserve(capacity);
+        q_i.reserve(capacity);
+        q_j.reserve(capacity);
+        q_k.reserve(capacity);
+    }
+
+    template <class T>
+    void QuaternionArray<T>::clear()
+    {
+        q_real.clear();
+        q_i.clear();
+        q_j.clear();
+        q_k.clear();
+    }
+
+    template <class T>
+    Vector<Quaternion<T>> QuaternionArray<T>::toVector() const
+    {
+        Vector<Quaternion<T>> result(size(), uninitialized);
+        Quaternion<T> *dst = result.data();
+        const T *r = q_real.data();
+        const T *qi = q_i.data();
+        const T *qj = q_j.data();
+        const T *qk = q_k.data();
+        for (size_t n = 0; n < size(); n++)
+        {
+            dst[n].real = r[n];
+            dst[n].i = qi[n];
+            dst[n].j = qj[n];
+            dst[n].k = qk[n];
+        }
+        return result;
+    }
+
+    template <class T>
+    QuaternionArray<T> &QuaternionArray<T>::operator+=(const QuaternionArray<T> &q)
+    {
+        q_real += q.q_real;
+        q_i += q.q_i;
+        q_j += q.q_j;
+        q_k += q.q_k;
+        return *this;
+    }
+
+    template <class T>
+    QuaternionArray<T> &QuaternionArray<T>::operator-=(const QuaternionArray<T> &q)
+    {
+        q_real -= q.q_real;
+        q_i -= q.q_i;
+        q_j -= q.q_j;
+        q_k -= q.q_k;
+        return *this;
+    }
+
+    template <class T>
+    QuaternionArray<T> &QuaternionArray<T>::operator*=(const QuaternionArray<T> &q)
+    {
+        if (size() != q.size())
+        {
+            throw std::runtime_error("Arrays must be the same size to multiply.");
+        }
+        T *r = q_real.data();
+        T *qi = q_i.data();
+        T *qj = q_j.data();
+        T *qk = q_k.data();
+        const T *e = q.q_real.data();
+        const T *f = q.q_i.data();
+        const T *g = q.q_j.data();
+        const T *h = q.q_k.data();
+        for (size_t n = 0; n < size(); n++)
+        {
+            T a = r[n], b = qi[n], c = qj[n], d = qk[n];
+            r[n] = a * e[n] - b * f[n] - c * g[n] - d * h[n];
+            qi[n] = a * f[n] + b * e[n] + c * h[n] - d * g[n];
+            qj[n] = a * g[n] - b * h[n] + c * e[n] + d * f[n];
+            qk[n] = a * h[n] + b * g[n] - c * f[n] + d * e[n];
+        }
+        return *this;
+    }
+
+    template <class T>
+    QuaternionArray<T> &QuaternionArray<T>::operator*=(const Quaternion<T> &value)
+    {
+        const T e = value.real, f = value.i, g = value.j, h = value.k;
+        T *r = q_real.data();
+        T *qi = q_i.data();
+        T *qj = q_j.data();
+        T *qk = q_k.data();
+        for (size_t n = 0; n < size(); n++)
+        {
+            T a = r[n], b = qi[n], c = qj[n], d = qk[n];
+            r[n] = a * e - b * f - c * g - d * h;
+            qi[n] = a * f + b * e + c * h - d * g;
+            qj[n] = a * g - b * h + c * e + d * f;
+            qk[n] = a * h + b * g - c * f + d * e;
+        }
+        return *this;
+    }
+
+    template <class T>
+    QuaternionArray<T> &QuaternionArray<T>::operator*=(const T &value)
+    {
+        q_real *= value;
+        q_i *= value;
+        q_j *= value;
+        q_k *= value;
+        return *this;
+    }
+
+    template <class T>
+    QuaternionArray<T> &QuaternionArray<T>::operator/=(const T &value)
+    {
+        q_real /= value;
+        q_i /= value;
+        q_j /= value;
+        q_k /= value;
+        return *this;
+    }
+
+    template <class T>
+    bool QuaternionArray<T>::operator==(const QuaternionArray<T> &q) const
+    {
+        return q_real == q.q_real && q_i == q.q_i && q_j == q.q_j && q_k == q.q_k;
+    }
+
+    template <class T>
+    bool QuaternionArray<T>::operator!=(const QuaternionArray<T> &q) const
+    {
+        return !(*this == q);
+    }
+
+    template <class T>
+    QuaternionArray<T> QuaternionArray<T>::conjugate() const
+    {
+        QuaternionArray<T> result(size(), uninitialized);
+        result.q_real = q_real;
+        T *qi = result.q_i.data();
+        T *qj = result.q_j.data();
+        T *qk = result.q_k.data();
+        for (size_t n = 0; n < size(); n++)
+        {
+            qi[n] = -q_i.at_unchecked(n);
+            qj[n] = -q_j.at_unchecked(n);
+            qk[n] = -q_k.at_unchecked(n);
+        }
+        return result;
+    }
+
+    template <class T>
+    QuaternionArray<T> QuaternionArray<T>::inverse() const
+    {
+        QuaternionArray<T> result(size(), uninitialized);
+        for (size_t n = 0; n < size(); n++)
+        {
+            T a = q_real.at_unchecked(n), b = q_i.at_unchecked(n), c = q_j.at_unchecked(n), d = q_k.at_unchecked(n);
+            T norm_squared = a * a + b * b + c * c + d * d;
+            result.q_real.at_unchecked(n) = a / norm_squared;
+            result.q_i.at_unchecked(n) = -b / norm_squared;
+            result.q_j.at_unchecked(n) = -c / norm_squared;
+            result.q_k.at_unchecked(n) = -d / norm_squared;
+        }
+        return result;
+    }
+
+    template <class T>
+    QuaternionArray<T> QuaternionArray<T>::normalize() const
+    {
+        QuaternionArray<T> result(size(), uninitialized);
+        for (size_t n = 0; n < size(); n++)
+        {
+            T a = q_real.at_unchecked(n), b = q_i.at_unchecked(n), c = q_j.at_unchecked(n), d = q_k.at_unchecked(n);
+            T norm = static_cast<T>(sqrt(a * a + b * b + c * c + d * d));
+            result.q_real.at_unchecked(n) = a / norm;
+            result.q_i.at_unchecked(n) = b / norm;
+            result.q_j.at_unchecked(n) = c / norm;
+            result.q_k.at_unchecked(n) = d / norm;
+        }
+        return result;
+    }
+
+    template <class T>
+    Vector<T> QuaternionArray<T>::modulus_squared() const
+    {
+        Vector<T> result(size(), uninitialized);
+        for (size_t n = 0; n < size(); n++)
+        {
+            T a = q_real.at_unchecked(n), b = q_i.at_unchecked(n), c = q_j.at_unchecked(n), d = q_k.at_unchecked(n);
+            result.at_unchecked(n) = a * a + b * b + c * c + d * d;
+        }
+        return result;
+    }
+
+    template <class T>
+    Vector<double> QuaternionArray<T>::modulus() const
+    {
+        Vector<double> result(size(), uninitialized);
+        for (size_t n = 0; n < size(); n++)
+        {
+            double a = q_real.at_unchecked(n), b = q_i.at_unchecked(n), c = q_j.at_unchecked(n), d = q_k.at_unchecked(n);
+            result.at_unchecked(n) = sqrt(a * a + b * b + c * c + d * d);
+        }
+        return result;
+    }
+
+    template <class T>
+    QuaternionArray<T> operator+(QuaternionArray<T> q1, const QuaternionArray<T> &q2)
+    {
+        q1 += q2;
+        return q1;
+    }
+
+    template <class T>
+    QuaternionArray<T> operator-(QuaternionArray<T> q1, const QuaternionArray<T> &q2)
+    {
+        q1 -= q2;
+        return q1;
+    }
+
+    template <class T>
+    QuaternionArray<T> operator*(QuaternionArray<T> q1, const QuaternionArray<T> &q2)
+    {
+        q1 *= q2;
+        return q1;
+    }
+
+    template <class T>
+    QuaternionArray<T> operator*(QuaternionArray<T> q, const typename QuaternionArray<T>::value_type &value)
+    {
+        q *= value;
+        return q;
+    }
+
+    // Quaternion products do not commute, so value * q multiplies each
+    // element from the left.
+    template <class T>
+    QuaternionArray<T> operator*(const typename QuaternionArray<T>::value_type &value, const QuaternionArray<T> &q)
+    {
+        QuaternionArray<T> result(q.size(), value);
+        result *= q;
+        return result;
+    }
+
+    template <class T>
+    QuaternionArray<T> operator*(QuaternionArray<T> q, const typename QuaternionArray<T>::scalar_type &value)
+    {
+        q *= value;
+        return q;
+    }
+
+    template <class T>
+    QuaternionArray<T> operator*(const typename QuaternionArray<T>::scalar_type &value, QuaternionArray<T> q)
+    {
+        q *= value;
+        return q;
+    }
+
+    template <class T>
+    QuaternionArray<T> operator/(QuaternionArray<T> q, const typename QuaternionArray<T>::scalar_type &value)
+    {
+        q /= value;
+        return q;
+    }
+
+    // Shared entry of the batch interpolations; t_step is 0 for one shared t
+    // and 1 for a per-element t.
+    template <class Policy, class T>
+    QuaternionArray<T> interpolate_lanes(const Policy &policy, const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const T *t, size_t t_step, bool spherical)
+    {
+        static_assert(std::is_floating_point<T>::value, "Interpolation requires floating point quaternions");
+        if (q0.size() != q1.size())
+        {
+            throw std::runtime_error("Arrays must be the same size to interpolate.");
+        }
+        QuaternionArray<T> result(q0.size(), uninitialized);
+        execution::for_each_block(policy, q0.size(), execution::elementwise_block, [&](size_t begin, size_t end)
+                                  {
+            const T *a[4] = {q0.real().data() + begin, q0.i().data() + begin, q0.j().data() + begin, q0.k().data() + begin};
+            const T *b[4] = {q1.real().data() + begin, q1.i().data() + begin, q1.j().data() + begin, q1.k().data() + begin};
+            T *out[4] = {result.real().data() + begin, result.i().data() + begin, result.j().data() + begin, result.k().data() + begin};
+            simd::interpolate(a, b, t + begin * t_step, t_step, spherical, out, end - begin); });
+        return result;
+    }
+
+    template <class T>
+    QuaternionArray<T> nlerp(const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, typename QuaternionArray<T>::scalar_type t)
+    {
+        return nlerp(execution::seq, q0, q1, t);
+    }
+
+    template <class T>
+    QuaternionArray<T> nlerp(const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const Vector<T> &t)
+    {
+        return nlerp(execution::seq, q0, q1, t);
+    }
+
+    template <class Policy, class T>
+    auto nlerp(const Policy &policy, const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, typename QuaternionArray<T>::scalar_type t) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, QuaternionArray<T>>
+    {
+        return interpolate_lanes(policy, q0, q1, &t, 0, false);
+    }
+
+    template <class Policy, class T>
+    auto nlerp(const Policy &policy, const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const Vector<T> &t) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, QuaternionArray<T>>
+    {
+        if (t.size() != q0.size())
+        {
+            throw std::runtime_error("Need one t per element.");
+        }
+        return interpolate_lanes(policy, q0, q1, t.data(), 1, false);
+    }
+
+    template <class T>
+    QuaternionArray<T> slerp(const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, typename QuaternionArray<T>::scalar_type t)
+    {
+        return slerp(execution::seq, q0, q1, t);
+    }
+
+    template <class T>
+    QuaternionArray<T> slerp(const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const Vector<T> &t)
+    {
+        return slerp(execution::seq, q0, q1, t);
+    }
+
+    template <class Policy, class T>
+    auto slerp(const Policy &policy, const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, typename QuaternionArray<T>::scalar_type t) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, QuaternionArray<T>>
+    {
+        return interpolate_lanes(policy, q0, q1, &t, 0, true);
+    }
+
+    template <class Policy, class T>
+    auto slerp(const Policy &policy, const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const Vector<T> &t) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, QuaternionArray<T>>
+    {
+        if (t.size() != q0.size())
+        {
+            throw std::runtime_error("Need one t per element.");
+        }
+        return interpolate_lanes(policy, q0, q1, t.data(), 1, true);
+    }
+
+    template <class T>
+    QuaternionArray<T> squad(const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const QuaternionArray<T> &s0, const QuaternionArray<T> &s1, typename QuaternionArray<T>::scalar_type t)
+    {
+        return squad(execution::seq, q0, q1, s0, s1, t);
+    }
+
+    template <class Policy, class T>
+    auto squad(const Policy &policy, const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const QuaternionArray<T> &s0, const QuaternionArray<T> &s1, typename QuaternionArray<T>::scalar_type t) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, QuaternionArray<T>>
+    {
+        return slerp(policy, slerp(policy, q0, q1, t), slerp(policy, s0, s1, t), 2 * t * (1 - t));
+    }
+
+}
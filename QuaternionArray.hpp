@@ -0,0 +1,157 @@
+#pragma once
+
+#include <initializer_list>
+#include <iostream>
+#include <type_traits>
+#include "Quaternion.hpp"
+#include "Vector.hpp"
+
+namespace atMath
+{
+
+    // Structure-of-arrays counterpart of Vector<Quaternion<T>>: the real, i,
+    // j and k components each live in their own contiguous lane, so a batch
+    // Hamilton product or rotation is four independent streams that vectorize
+    // without shuffles.
+    template <class T = float>
+    class QuaternionArray
+    {
+        static_assert(std::is_arithmetic<T>::value, "QuaternionArray type must be arithmetic");
+
+    protected:
+        Vector<T> q_real;
+        Vector<T> q_i;
+        Vector<T> q_j;
+        Vector<T> q_k;
+
+    public:
+        using value_type = Quaternion<T>;
+        using scalar_type = T;
+
+        QuaternionArray();
+        QuaternionArray(size_t size);
+        QuaternionArray(size_t size, const Quaternion<T> &value);
+        QuaternionArray(size_t size, uninitialized_t);
+        QuaternionArray(Vector<T> real, Vector<T> i, Vector<T> j, Vector<T> k);
+        QuaternionArray(const Vector<Quaternion<T>> &v);
+        QuaternionArray(std::initializer_list<Quaternion<T>> list);
+        template <class U>
+        QuaternionArray(const QuaternionArray<U> &q);
+
+        size_t size() const { return q_real.size(); }
+        Vector<T> &real() { return q_real; }
+        const Vector<T> &real() const { return q_real; }
+        Vector<T> &i() { return q_i; }
+        const Vector<T> &i() const { return q_i; }
+        Vector<T> &j() { return q_j; }
+        const Vector<T> &j() const { return q_j; }
+        Vector<T> &k() { return q_k; }
+        const Vector<T> &k() const { return q_k; }
+
+        Quaternion<T> operator[](size_t index) const { return Quaternion<T>(q_real[index], q_i[index], q_j[index], q_k[index]); }
+        void set(size_t index, const Quaternion<T> &value);
+        void push_back(const Quaternion<T> &value);
+        void reserve(size_t capacity);
+        void clear();
+
+        // Back to the interleaved layout.
+        Vector<Quaternion<T>> toVector() const;
+
+        QuaternionArray<T> &operator+=(const QuaternionArray<T> &q);
+        QuaternionArray<T> &operator-=(const QuaternionArray<T> &q);
+        QuaternionArray<T> &operator*=(const QuaternionArray<T> &q);
+        QuaternionArray<T> &operator*=(const Quaternion<T> &value);
+        QuaternionArray<T> &operator*=(const T &value);
+        QuaternionArray<T> &operator/=(const T &value);
+
+        bool operator==(const QuaternionArray<T> &q) const;
+        bool operator!=(const QuaternionArray<T> &q) const;
+
+        QuaternionArray<T> conjugate() const;
+        QuaternionArray<T> inverse() const;
+        QuaternionArray<T> normalize() const;
+        Vector<T> modulus_squared() const;
+        Vector<double> modulus() const;
+
+        friend std::ostream &operator<<(std::ostream &os, const QuaternionArray<T> &q)
+        {
+            os << "[";
+            for (size_t i = 0; i < q.size(); i++)
+            {
+                os << q[i];
+                if (i + 1 != q.size())
+                {
+                    os << ", ";
+                }
+            }
+            os << "]";
+            return os;
+        }
+    };
+
+    template <class T>
+    QuaternionArray<T> operator+(QuaternionArray<T> q1, const QuaternionArray<T> &q2);
+    template <class T>
+    QuaternionArray<T> operator-(QuaternionArray<T> q1, const QuaternionArray<T> &q2);
+    template <class T>
+    QuaternionArray<T> operator*(QuaternionArray<T> q1, const QuaternionArray<T> &q2);
+    template <class T>
+    QuaternionArray<T> operator*(QuaternionArray<T> q, const typename QuaternionArray<T>::value_type &value);
+    template <class T>
+    QuaternionArray<T> operator*(const typename QuaternionArray<T>::value_type &value, const QuaternionArray<T> &q);
+    template <class T>
+    QuaternionArray<T> operator*(QuaternionArray<T> q, const typename QuaternionArray<T>::scalar_type &value);
+    template <class T>
+    QuaternionArray<T> operator*(const typename QuaternionArray<T>::scalar_type &value, QuaternionArray<T> q);
+    template <class T>
+    QuaternionArray<T> operator/(QuaternionArray<T> q, const typename QuaternionArray<T>::scalar_type &value);
+
+    // Batch counterparts of nlerp/slerp/squad in Quaternion.hpp, element n
+    // blending q0[n] and q1[n] either at one shared t or at t[n]. They run
+    // through simd::interpolate, whose slerp weights come from the
+    // fast::acos and fast::sin polynomials (FastMath.hpp) instead of libm;
+    // for unit float inputs the result stays within 1e-6 of the exact
+    // slerp. t must lie in [0, 1].
+    template <class T>
+    QuaternionArray<T> nlerp(const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, typename QuaternionArray<T>::scalar_type t);
+    template <class T>
+    QuaternionArray<T> nlerp(const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const Vector<T> &t);
+    template <class T>
+    QuaternionArray<T> slerp(const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, typename QuaternionArray<T>::scalar_type t);
+    template <class T>
+    QuaternionArray<T> slerp(const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const Vector<T> &t);
+    template <class T>
+    QuaternionArray<T> squad(const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const QuaternionArray<T> &s0, const QuaternionArray<T> &s1, typename QuaternionArray<T>::scalar_type t);
+
+    // Policy forms; par and par_unseq split large arrays across
+    // ThreadPool::global(). Each element gets the same result under any policy.
+    template <class Policy, class T>
+    auto nlerp(const Policy &policy, const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, typename QuaternionArray<T>::scalar_type t) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, QuaternionArray<T>>;
+    template <class Policy, class T>
+    auto nlerp(const Policy &policy, const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const Vector<T> &t) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, QuaternionArray<T>>;
+    template <class Policy, class T>
+    auto slerp(const Policy &policy, const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, typename QuaternionArray<T>::scalar_type t) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, QuaternionArray<T>>;
+    template <class Policy, class T>
+    auto slerp(const Policy &policy, const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const Vector<T> &t) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, QuaternionArray<T>>;
+    template <class Policy, class T>
+    auto squad(const Policy &policy, const QuaternionArray<T> &q0, const QuaternionArray<T> &q1, const QuaternionArray<T> &s0, const QuaternionArray<T> &s1, typename QuaternionArray<T>::scalar_type t) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, QuaternionArray<T>>;
+
+}
+
+// Definitions; see the end of Vector.hpp for ATMATH_EXTERN_TEMPLATES.
+#include "QuaternionArray.cpp"
+
+#define ATMATH_QUATERNION_ARRAY_INSTANCES(PREFIX, T)                         \
+    PREFIX class QuaternionArray<T>;                                         \
+    PREFIX QuaternionArray<T> slerp(const QuaternionArray<T> &,              \
+        const QuaternionArray<T> &, T);                                      \
+    PREFIX QuaternionArray<T> nlerp(const QuaternionArray<T> &,              \
+        const QuaternionArray<T> &, T);
+
+#if ATMATH_EXTERN_TEMPLATES
+namespace atMath
+{
+    ATMATH_QUATERNION_ARRAY_INSTANCES(extern template, float)
+    ATMATH_QUATERNION_ARRAY_INSTANCES(extern template, double)
+}
+#endif
@@ -0,0 +1,25 @@
+#include "Quaternion.hpp"
+#include "QuaternionArray.hpp"
+#include "Vec3Array.hpp"
+
+// Explicit instantiations compiled into the atMath library; the matching
+// extern template declarations are at the end of each header.
+namespace atMath
+{
+    ATMATH_QUATERNION_INSTANCES(template, int)
+    ATMATH_QUATERNION_INSTANCES(template, float)
+    ATMATH_QUATERNION_INSTANCES(template, double)
+    ATMATH_QUATERNION_INSTANCES(template, uint32_t)
+    ATMATH_QUATERNION_INSTANCES(template, uint64_t)
+    ATMATH_QUATERNION_INSTANCES(template, int64_t)
+    ATMATH_QUATERNION_INSTANCES(template, uint8_t)
+    ATMATH_QUATERNION_INSTANCES(template, int8_t)
+    ATMATH_QUATERNION_INSTANCES(template, uint16_t)
+    ATMATH_QUATERNION_INSTANCES(template, int16_t)
+
+    ATMATH_QUATERNION_ARRAY_INSTANCES(template, float)
+    ATMATH_QUATERNION_ARRAY_INSTANCES(template, double)
+
+    ATMATH_VEC3_ARRAY_INSTANCES(template, float)
+    ATMATH_VEC3_ARRAY_INSTANCES(template, double)
+}
@@ -0,0 +1,1472 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include "FastMath.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ATMATH_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+// Explicitly vectorized kernels behind Vector<float>, Vector<double> and
+// Vector<int>. Each kernel exists in an SSE4.1, AVX2/FMA and AVX-512 flavour,
+// compiled with per-function target attributes so the library itself can be
+// built for a baseline ISA. The widest variant supported by the running CPU is
+// picked once through CPUID; other compilers and architectures use the scalar
+// loops.
+namespace atMath
+{
+    namespace simd
+    {
+
+        enum class Level
+        {
+            Scalar,
+            SSE,
+            AVX2,
+            AVX512
+        };
+
+        inline Level detect()
+        {
+#ifdef ATMATH_SIMD_X86
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+            {
+                return Level::AVX512;
+            }
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+            {
+                return Level::AVX2;
+            }
+            if (__builtin_cpu_supports("sse4.1"))
+            {
+                return Level::SSE;
+            }
+#endif
+            return Level::Scalar;
+        }
+
+        inline Level level()
+        {
+            static const Level detected = detect();
+            return detected;
+        }
+
+        template <class T>
+        struct is_simd_type : std::integral_constant<bool, std::is_same<T, float>::value || std::is_same<T, double>::value || std::is_same<T, int>::value>
+        {
+        };
+
+        namespace scalar
+        {
+            template <class T>
+            T dot(const T *a, const T *b, size_t n)
+            {
+                T result = 0;
+                for (size_t i = 0; i < n; i++)
+                {
+                    result += a[i] * b[i];
+                }
+                return result;
+            }
+
+            template <class T>
+            T sum(const T *a, size_t n)
+            {
+                T result = 0;
+                for (size_t i = 0; i < n; i++)
+                {
+                    result += a[i];
+                }
+                return result;
+            }
+
+            // Running compensated sum. Kahan keeps the rounding error of the
+            // last addition in c (total = s - c) and subtracts it from the
+            // next addend. Neumaier accumulates the exact error of every
+            // addition (branch-free TwoSum, total = s + c), so it stays
+            // accurate when an addend is larger than the running sum. The
+            // errors are themselves Kahan-summed into c (k is that
+            // compensation); added plainly, millions of same-signed float
+            // errors drift further than Kahan's own result.
+            template <bool Neumaier, class T>
+            struct Compensated
+            {
+                T s = 0;
+                T c = 0;
+                T k = 0;
+
+                void add(T x)
+                {
+                    if (Neumaier)
+                    {
+                        T t = s + x;
+                        T z = t - s;
+                        T y = ((s - (t - z)) + (x - z)) - k;
+                        T u = c + y;
+                        k = (u - c) - y;
+                        c = u;
+                        s = t;
+                    }
+                    else
+                    {
+                        T y = x - c;
+                        T t = s + y;
+                        c = (t - s) - y;
+                        s = t;
+                    }
+                }
+
+                T result() const { return Neumaier ? s + (c - k) : s - c; }
+            };
+
+            // Compensated sum of a[i], or of a[i] * b[i] when b is non-null.
+            template <bool Neumaier, class T>
+            T sum_compensated(const T *a, const T *b, size_t n)
+            {
+                Compensated<Neumaier, T> acc;
+                for (size_t i = 0; i < n; i++)
+                {
+                    acc.add(b ? a[i] * b[i] : a[i]);
+                }
+                return acc.result();
+            }
+
+            // Sum of a[i], or of a[i] * b[i] when b is non-null, in double.
+            template <class T>
+            double sum_widened(const T *a, const T *b, size_t n)
+            {
+                double result = 0;
+                for (size_t i = 0; i < n; i++)
+                {
+                    result += b ? double(a[i]) * double(b[i]) : double(a[i]);
+                }
+                return result;
+            }
+
+            template <class T>
+            void add(T *a, const T *b, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    a[i] += b[i];
+                }
+            }
+
+            template <class T>
+            void sub(T *a, const T *b, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    a[i] -= b[i];
+                }
+            }
+
+            template <class T>
+            void mul(T *a, const T *b, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    a[i] *= b[i];
+                }
+            }
+
+            template <class T>
+            void scale(T *a, T value, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    a[i] *= value;
+                }
+            }
+
+            template <class T>
+            void transform3(const T *m, const T *x, const T *y, const T *z, T *ox, T *oy, T *oz, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    T vx = x[i], vy = y[i], vz = z[i];
+                    ox[i] = m[0] * vx + m[1] * vy + m[2] * vz;
+                    oy[i] = m[3] * vx + m[4] * vy + m[5] * vz;
+                    oz[i] = m[6] * vx + m[7] * vy + m[8] * vz;
+                }
+            }
+
+            // Element i of the quaternion interpolation behind
+            // QuaternionArray's slerp/nlerp: q0, q1 and out are the
+            // (real, i, j, k) lanes. Both weight sets are computed and then
+            // selected so the SIMD kernels can mirror this exactly.
+            template <class T>
+            void interpolate_one(const T *const *q0, const T *const *q1, T t, bool spherical, T *const *out, size_t i)
+            {
+                T d = q0[0][i] * q1[0][i] + q0[1][i] * q1[1][i] + q0[2][i] * q1[2][i] + q0[3][i] * q1[3][i];
+                T sign = d < 0 ? T(-1) : T(1);
+                d = std::min(d * sign, T(1));
+                bool linear = !spherical || d > T(0.9995);
+                T theta = fast::acos(d);
+                T inv_sin = 1 / std::sqrt(std::max(1 - d * d, T(1e-12)));
+                T a = linear ? 1 - t : fast::sin((1 - t) * theta) * inv_sin;
+                T b = sign * (linear ? t : fast::sin(t * theta) * inv_sin);
+                T r[4];
+                for (size_t c = 0; c < 4; c++)
+                {
+                    r[c] = a * q0[c][i] + b * q1[c][i];
+                }
+                T scale = linear ? 1 / std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]) : T(1);
+                for (size_t c = 0; c < 4; c++)
+                {
+                    out[c][i] = r[c] * scale;
+                }
+            }
+
+            template <class T>
+            void interpolate(const T *const *q0, const T *const *q1, const T *t, size_t t_step, bool spherical, T *const *out, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    interpolate_one(q0, q1, t[i * t_step], spherical, out, i);
+                }
+            }
+
+            // Interleaved complex kernels: every pointer addresses n
+            // (real, imag) pairs. Each element is read before out is written,
+            // so out may alias either input.
+            template <class T>
+            void complex_mul(T *out, const T *a, const T *b, size_t n)
+            {
+                for (size_t i = 0; i < 2 * n; i += 2)
+                {
+                    T ar = a[i], ai = a[i + 1], br = b[i], bi = b[i + 1];
+                    out[i] = ar * br - ai * bi;
+                    out[i + 1] = ar * bi + ai * br;
+                }
+            }
+
+            // out = a * conj(b), the correlation product.
+            template <class T>
+            void complex_mul_conj(T *out, const T *a, const T *b, size_t n)
+            {
+                for (size_t i = 0; i < 2 * n; i += 2)
+                {
+                    T ar = a[i], ai = a[i + 1], br = b[i], bi = b[i + 1];
+                    out[i] = ar * br + ai * bi;
+                    out[i + 1] = ai * br - ar * bi;
+                }
+            }
+
+            // acc += a * b.
+            template <class T>
+            void complex_mac(T *acc, const T *a, const T *b, size_t n)
+            {
+                for (size_t i = 0; i < 2 * n; i += 2)
+                {
+                    T ar = a[i], ai = a[i + 1], br = b[i], bi = b[i + 1];
+                    acc[i] += ar * br - ai * bi;
+                    acc[i + 1] += ar * bi + ai * br;
+                }
+            }
+
+            // out = a * conj(b) / |b|^2, without guarding against overflow of
+            // |b|^2 (as Complex's operator/).
+            template <class T>
+            void complex_div(T *out, const T *a, const T *b, size_t n)
+            {
+                for (size_t i = 0; i < 2 * n; i += 2)
+                {
+                    T ar = a[i], ai = a[i + 1], br = b[i], bi = b[i + 1];
+                    T d = br * br + bi * bi;
+                    out[i] = (ar * br + ai * bi) / d;
+                    out[i + 1] = (ai * br - ar * bi) / d;
+                }
+            }
+
+            // out[i] = |a[i]|; out holds n values.
+            template <class T>
+            void complex_abs(T *out, const T *a, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    out[i] = std::sqrt(a[2 * i] * a[2 * i] + a[2 * i + 1] * a[2 * i + 1]);
+                }
+            }
+
+            // out[i] = arg(a[i]) through fast::atan2; out holds n values.
+            template <class T>
+            void complex_arg(T *out, const T *a, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    out[i] = fast::atan2(a[2 * i + 1], a[2 * i]);
+                }
+            }
+
+            // Split-lane (ComplexArray) kernels for the fast::exp, log, sqrt
+            // and pow of FastMath.hpp: element i is (re[i], im[i]) and the
+            // result goes to (out_re[i], out_im[i]), which may alias the input.
+            template <class T>
+            void complex_exp(const T *re, const T *im, T *out_re, T *out_im, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    Complex<T> r = fast::exp(Complex<T>(re[i], im[i]));
+                    out_re[i] = r.real;
+                    out_im[i] = r.imag;
+                }
+            }
+
+            template <class T>
+            void complex_log(const T *re, const T *im, T *out_re, T *out_im, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    Complex<T> r = fast::log(Complex<T>(re[i], im[i]));
+                    out_re[i] = r.real;
+                    out_im[i] = r.imag;
+                }
+            }
+
+            template <class T>
+            void complex_sqrt(const T *re, const T *im, T *out_re, T *out_im, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    Complex<T> r = fast::sqrt(Complex<T>(re[i], im[i]));
+                    out_re[i] = r.real;
+                    out_im[i] = r.imag;
+                }
+            }
+
+            // (re[i], im[i]) ^ (wr, wi).
+            template <class T>
+            void complex_pow(const T *re, const T *im, T wr, T wi, T *out_re, T *out_im, size_t n)
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    Complex<T> r = fast::pow(Complex<T>(re[i], im[i]), Complex<T>(wr, wi));
+                    out_re[i] = r.real;
+                    out_im[i] = r.imag;
+                }
+            }
+        }
+
+#ifdef ATMATH_SIMD_X86
+
+// The kernel bodies are the same for every ISA; only the register helpers
+// (load, store, add, sub, mul, madd, set1, hsum) differ. Each namespace below
+// defines those helpers for float, double and int and then expands this macro
+// under its own target attribute. The complex kernels additionally use the
+// float/double pair helpers: swap_pairs, dup_real and dup_imag act on each
+// (real, imag) pair, fmaddsub/fmsubadd compute a * b -/+ c and a * b +/- c on
+// real/imag slots, and real_parts/imag_parts gather the reals and the
+// imaginaries of two registers of pairs into one register each, in order;
+// copysign(a, b) is a with the sign bit of b.
+// The float-only exp/log helpers are round and floor, scale2 (v * 2^n for
+// integral n in the normal exponent range) and exponent/mantissa, which split
+// a positive normal v into m * 2^e with m in [0.5, 1).
+#define ATMATH_SIMD_KERNELS(TARGET)                                          \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) T dot(const T *a, const T *b, size_t n)  \
+    {                                                                        \
+        using reg = decltype(load(a));                                       \
+        constexpr size_t width = sizeof(reg) / sizeof(T);                    \
+        reg acc0 = set1(T(0));                                               \
+        reg acc1 = set1(T(0));                                               \
+        size_t i = 0;                                                        \
+        for (; i + 2 * width <= n; i += 2 * width)                           \
+        {                                                                    \
+            acc0 = madd(load(a + i), load(b + i), acc0);                     \
+            acc1 = madd(load(a + i + width), load(b + i + width), acc1);     \
+        }                                                                    \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            acc0 = madd(load(a + i), load(b + i), acc0);                     \
+        }                                                                    \
+        T result = hsum(add(acc0, acc1));                                    \
+        for (; i < n; i++)                                                   \
+        {                                                                    \
+            result += a[i] * b[i];                                           \
+        }                                                                    \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) T sum(const T *a, size_t n)              \
+    {                                                                        \
+        using reg = decltype(load(a));                                       \
+        constexpr size_t width = sizeof(reg) / sizeof(T);                    \
+        reg acc0 = set1(T(0));                                               \
+        reg acc1 = set1(T(0));                                               \
+        size_t i = 0;                                                        \
+        for (; i + 2 * width <= n; i += 2 * width)                           \
+        {                                                                    \
+            acc0 = add(acc0, load(a + i));                                   \
+            acc1 = add(acc1, load(a + i + width));                           \
+        }                                                                    \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            acc0 = add(acc0, load(a + i));                                   \
+        }                                                                    \
+        T result = hsum(add(acc0, acc1));                                    \
+        for (; i < n; i++)                                                   \
+        {                                                                    \
+            result += a[i];                                                  \
+        }                                                                    \
+        return result;                                                       \
+    }                                                                        \
+                                                                             \
+    template <bool Neumaier, class T>                                        \
+    __attribute__((target(TARGET))) T sum_compensated(const T *a,            \
+        const T *b, size_t n)                                                \
+    {                                                                        \
+        using reg = decltype(load(a));                                       \
+        constexpr size_t width = sizeof(reg) / sizeof(T);                    \
+        reg s = set1(T(0));                                                  \
+        reg c = set1(T(0));                                                  \
+        reg k = set1(T(0));                                                  \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            reg x = b ? mul(load(a + i), load(b + i)) : load(a + i);         \
+            if (Neumaier)                                                    \
+            {                                                                \
+                /* TwoSum error, Kahan-added into c as in Compensated. */    \
+                reg t = add(s, x);                                           \
+                reg z = sub(t, s);                                           \
+                reg y = sub(add(sub(s, sub(t, z)), sub(x, z)), k);           \
+                reg u = add(c, y);                                           \
+                k = sub(sub(u, c), y);                                       \
+                c = u;                                                       \
+                s = t;                                                       \
+            }                                                                \
+            else                                                             \
+            {                                                                \
+                reg y = sub(x, c);                                           \
+                reg t = add(s, y);                                           \
+                c = sub(sub(t, s), y);                                       \
+                s = t;                                                       \
+            }                                                                \
+        }                                                                    \
+        /* Fold the lanes, their corrections and the tail together. */       \
+        T lanes[width], corrections[width], residuals[width];                \
+        store(lanes, s);                                                     \
+        store(corrections, c);                                               \
+        store(residuals, k);                                                 \
+        scalar::Compensated<Neumaier, T> acc;                                \
+        for (size_t l = 0; l < width; l++)                                   \
+        {                                                                    \
+            acc.add(lanes[l]);                                               \
+            acc.add(Neumaier ? corrections[l] : -corrections[l]);            \
+            if (Neumaier)                                                    \
+            {                                                                \
+                acc.add(-residuals[l]);                                      \
+            }                                                                \
+        }                                                                    \
+        for (; i < n; i++)                                                   \
+        {                                                                    \
+            acc.add(b ? a[i] * b[i] : a[i]);                                 \
+        }                                                                    \
+        return acc.result();                                                 \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) double sum_widened(const T *a,           \
+        const T *b, size_t n)                                                \
+    {                                                                        \
+        using reg = decltype(load(a));                                       \
+        constexpr size_t width = sizeof(reg) / sizeof(T);                    \
+        auto acc0 = set1(0.0);                                               \
+        auto acc1 = set1(0.0);                                               \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            reg x = load(a + i);                                             \
+            if (b)                                                           \
+            {                                                                \
+                reg y = load(b + i);                                         \
+                acc0 = madd(widen_low(x), widen_low(y), acc0);               \
+                acc1 = madd(widen_high(x), widen_high(y), acc1);             \
+            }                                                                \
+            else                                                             \
+            {                                                                \
+                acc0 = add(acc0, widen_low(x));                              \
+                acc1 = add(acc1, widen_high(x));                             \
+            }                                                                \
+        }                                                                    \
+        return hsum(add(acc0, acc1)) + scalar::sum_widened(a + i,            \
+            b ? b + i : nullptr, n - i);                                     \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void add(T *a, const T *b, size_t n)     \
+    {                                                                        \
+        constexpr size_t width = sizeof(decltype(load(a))) / sizeof(T);      \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            store(a + i, add(load(a + i), load(b + i)));                     \
+        }                                                                    \
+        for (; i < n; i++)                                                   \
+        {                                                                    \
+            a[i] += b[i];                                                    \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void sub(T *a, const T *b, size_t n)     \
+    {                                                                        \
+        constexpr size_t width = sizeof(decltype(load(a))) / sizeof(T);      \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            store(a + i, sub(load(a + i), load(b + i)));                     \
+        }                                                                    \
+        for (; i < n; i++)                                                   \
+        {                                                                    \
+            a[i] -= b[i];                                                    \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void mul(T *a, const T *b, size_t n)     \
+    {                                                                        \
+        constexpr size_t width = sizeof(decltype(load(a))) / sizeof(T);      \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            store(a + i, mul(load(a + i), load(b + i)));                     \
+        }                                                                    \
+        for (; i < n; i++)                                                   \
+        {                                                                    \
+            a[i] *= b[i];                                                    \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void scale(T *a, T value, size_t n)      \
+    {                                                                        \
+        constexpr size_t width = sizeof(decltype(load(a))) / sizeof(T);      \
+        auto factor = set1(value);                                           \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            store(a + i, mul(load(a + i), factor));                          \
+        }                                                                    \
+        for (; i < n; i++)                                                   \
+        {                                                                    \
+            a[i] *= value;                                                   \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void transform3(const T *m, const T *x,  \
+        const T *y, const T *z, T *ox, T *oy, T *oz, size_t n)               \
+    {                                                                        \
+        constexpr size_t width = sizeof(decltype(load(x))) / sizeof(T);      \
+        auto m0 = set1(m[0]), m1 = set1(m[1]), m2 = set1(m[2]);              \
+        auto m3 = set1(m[3]), m4 = set1(m[4]), m5 = set1(m[5]);              \
+        auto m6 = set1(m[6]), m7 = set1(m[7]), m8 = set1(m[8]);              \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            auto vx = load(x + i);                                           \
+            auto vy = load(y + i);                                           \
+            auto vz = load(z + i);                                           \
+            store(ox + i, madd(m2, vz, madd(m1, vy, mul(m0, vx))));          \
+            store(oy + i, madd(m5, vz, madd(m4, vy, mul(m3, vx))));          \
+            store(oz + i, madd(m8, vz, madd(m7, vy, mul(m6, vx))));          \
+        }                                                                    \
+        for (; i < n; i++)                                                   \
+        {                                                                    \
+            T vx = x[i], vy = y[i], vz = z[i];                               \
+            ox[i] = m[0] * vx + m[1] * vy + m[2] * vz;                       \
+            oy[i] = m[3] * vx + m[4] * vy + m[5] * vz;                       \
+            oz[i] = m[6] * vx + m[7] * vy + m[8] * vz;                       \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void interpolate(const T *const *q0,     \
+        const T *const *q1, const T *t, size_t t_step, bool spherical,       \
+        T *const *out, size_t n)                                             \
+    {                                                                        \
+        using reg = decltype(load(t));                                       \
+        constexpr size_t width = sizeof(reg) / sizeof(T);                    \
+        const reg one = set1(T(1));                                          \
+        const reg threshold = set1(spherical ? T(0.9995) : T(-1));           \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            reg a[4], b[4];                                                  \
+            for (size_t c = 0; c < 4; c++)                                   \
+            {                                                                \
+                a[c] = load(q0[c] + i);                                      \
+                b[c] = load(q1[c] + i);                                      \
+            }                                                                \
+            reg tn = t_step ? load(t + i) : set1(t[0]);                      \
+            reg d = madd(a[3], b[3], madd(a[2], b[2],                        \
+                madd(a[1], b[1], mul(a[0], b[0]))));                         \
+            reg sign = select(less(d, set1(T(0))), set1(T(-1)), one);        \
+            d = min(mul(d, sign), one);                                      \
+            auto linear = less(threshold, d);                                \
+            reg p = set1(T(fast::acos_coefficients[0]));                     \
+            for (size_t c = 1; c < 8; c++)                                   \
+            {                                                                \
+                p = madd(p, d, set1(T(fast::acos_coefficients[c])));         \
+            }                                                                \
+            reg theta = mul(sqrt(sub(one, d)), p);                           \
+            reg inv_sin = div(one, sqrt(max(sub(one, mul(d, d)),             \
+                set1(T(1e-12)))));                                           \
+            reg x[2] = {mul(sub(one, tn), theta), mul(tn, theta)};           \
+            for (reg &v : x)                                                 \
+            {                                                                \
+                reg x2 = mul(v, v);                                          \
+                reg s = one;                                                 \
+                for (double factor : fast::sin_factors)                      \
+                {                                                            \
+                    s = sub(one, mul(mul(x2, set1(T(factor))), s));          \
+                }                                                            \
+                v = mul(mul(v, s), inv_sin);                                 \
+            }                                                                \
+            reg wa = select(linear, sub(one, tn), x[0]);                     \
+            reg wb = mul(sign, select(linear, tn, x[1]));                    \
+            reg r[4];                                                        \
+            for (size_t c = 0; c < 4; c++)                                   \
+            {                                                                \
+                r[c] = madd(wa, a[c], mul(wb, b[c]));                        \
+            }                                                                \
+            reg norm = madd(r[3], r[3], madd(r[2], r[2],                     \
+                madd(r[1], r[1], mul(r[0], r[0]))));                         \
+            reg scale = select(linear, div(one, sqrt(norm)), one);           \
+            for (size_t c = 0; c < 4; c++)                                   \
+            {                                                                \
+                store(out[c] + i, mul(r[c], scale));                         \
+            }                                                                \
+        }                                                                    \
+        for (; i < n; i++)                                                   \
+        {                                                                    \
+            scalar::interpolate_one(q0, q1, t[i * t_step], spherical, out, i); \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void complex_mul(T *out, const T *a,     \
+        const T *b, size_t n)                                                \
+    {                                                                        \
+        constexpr size_t width = sizeof(decltype(load(a))) / sizeof(T);      \
+        size_t i = 0;                                                        \
+        for (; i + width <= 2 * n; i += width)                               \
+        {                                                                    \
+            auto va = load(a + i);                                           \
+            auto vb = load(b + i);                                           \
+            store(out + i, fmaddsub(dup_real(va), vb,                        \
+                mul(dup_imag(va), swap_pairs(vb))));                         \
+        }                                                                    \
+        scalar::complex_mul(out + i, a + i, b + i, n - i / 2);               \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void complex_mul_conj(T *out,            \
+        const T *a, const T *b, size_t n)                                    \
+    {                                                                        \
+        constexpr size_t width = sizeof(decltype(load(a))) / sizeof(T);      \
+        size_t i = 0;                                                        \
+        for (; i + width <= 2 * n; i += width)                               \
+        {                                                                    \
+            auto va = load(a + i);                                           \
+            auto vb = load(b + i);                                           \
+            store(out + i, fmsubadd(dup_real(vb), va,                        \
+                mul(dup_imag(vb), swap_pairs(va))));                         \
+        }                                                                    \
+        scalar::complex_mul_conj(out + i, a + i, b + i, n - i / 2);          \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void complex_mac(T *acc, const T *a,     \
+        const T *b, size_t n)                                                \
+    {                                                                        \
+        constexpr size_t width = sizeof(decltype(load(a))) / sizeof(T);      \
+        size_t i = 0;                                                        \
+        for (; i + width <= 2 * n; i += width)                               \
+        {                                                                    \
+            auto va = load(a + i);                                           \
+            auto vb = load(b + i);                                           \
+            auto product = fmaddsub(dup_real(va), vb,                        \
+                mul(dup_imag(va), swap_pairs(vb)));                          \
+            store(acc + i, add(load(acc + i), product));                     \
+        }                                                                    \
+        scalar::complex_mac(acc + i, a + i, b + i, n - i / 2);               \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void complex_div(T *out, const T *a,     \
+        const T *b, size_t n)                                                \
+    {                                                                        \
+        constexpr size_t width = sizeof(decltype(load(a))) / sizeof(T);      \
+        size_t i = 0;                                                        \
+        for (; i + width <= 2 * n; i += width)                               \
+        {                                                                    \
+            auto va = load(a + i);                                           \
+            auto vb = load(b + i);                                           \
+            auto num = fmsubadd(dup_real(vb), va,                            \
+                mul(dup_imag(vb), swap_pairs(va)));                          \
+            auto squares = mul(vb, vb);                                      \
+            store(out + i, div(num, add(squares, swap_pairs(squares))));     \
+        }                                                                    \
+        scalar::complex_div(out + i, a + i, b + i, n - i / 2);               \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void complex_abs(T *out, const T *a,     \
+        size_t n)                                                            \
+    {                                                                        \
+        constexpr size_t width = sizeof(decltype(load(a))) / sizeof(T);      \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            auto lo = load(a + 2 * i);                                       \
+            auto hi = load(a + 2 * i + width);                               \
+            auto re = real_parts(lo, hi);                                    \
+            auto im = imag_parts(lo, hi);                                    \
+            store(out + i, sqrt(madd(re, re, mul(im, im))));                 \
+        }                                                                    \
+        scalar::complex_abs(out + i, a + 2 * i, n - i);                      \
+    }                                                                        \
+                                                                             \
+    /* Register forms of the fast:: functions, mirroring FastMath.hpp step   \
+       for step; the complex kernels below are built from them. */           \
+    template <class T, class R>                                              \
+    __attribute__((target(TARGET))) inline R fast_atan2(R y, R x)            \
+    {                                                                        \
+        const R zero = set1(T(0));                                           \
+        R ax = max(x, sub(zero, x));                                         \
+        R ay = max(y, sub(zero, y));                                         \
+        R r = div(min(ax, ay), max(max(ax, ay),                              \
+            set1(std::numeric_limits<T>::min())));                           \
+        R r2 = mul(r, r);                                                    \
+        R p = set1(T(fast::atan_coefficients[0]));                           \
+        for (size_t c = 1; c < 9; c++)                                       \
+        {                                                                    \
+            p = madd(p, r2, set1(T(fast::atan_coefficients[c])));            \
+        }                                                                    \
+        R angle = mul(r, p);                                                 \
+        angle = select(less(ax, ay),                                         \
+            sub(set1(T(1.57079632679489661923)), angle), angle);             \
+        angle = select(less(x, zero),                                        \
+            sub(set1(T(3.14159265358979323846)), angle), angle);             \
+        return copysign(angle, y);                                           \
+    }                                                                        \
+                                                                             \
+    template <class T, class R>                                              \
+    __attribute__((target(TARGET))) inline R fast_exp(R x)                   \
+    {                                                                        \
+        const R low = set1(T(fast::exp_min));                                \
+        const R high = set1(T(fast::exp_max));                               \
+        R xc = min(max(x, low), high);                                       \
+        R n = round(mul(xc, set1(T(1.44269504088896341))));                  \
+        R r = sub(sub(xc, mul(n, set1(T(fast::ln2_parts[0])))),              \
+            mul(n, set1(T(fast::ln2_parts[1]))));                            \
+        R p = set1(T(fast::exp_coefficients[0]));                            \
+        for (size_t k = 1; k < 6; k++)                                       \
+        {                                                                    \
+            p = madd(p, r, set1(T(fast::exp_coefficients[k])));              \
+        }                                                                    \
+        R y = scale2(add(madd(mul(p, r), r, r), set1(T(1))), n);             \
+        y = select(less(x, low), set1(T(0)), y);                             \
+        return select(less(high, x),                                         \
+            set1(std::numeric_limits<T>::infinity()), y);                    \
+    }                                                                        \
+                                                                             \
+    template <class T, class R>                                              \
+    __attribute__((target(TARGET))) inline R fast_log(R x)                   \
+    {                                                                        \
+        const R one = set1(T(1));                                            \
+        R e = exponent(x);                                                   \
+        R m = mantissa(x);                                                   \
+        auto small = less(m, set1(T(0.70710678118654752)));                  \
+        e = select(small, sub(e, one), e);                                   \
+        m = sub(select(small, add(m, m), m), one);                           \
+        R z = mul(m, m);                                                     \
+        R p = set1(T(fast::log_coefficients[0]));                            \
+        for (size_t k = 1; k < 9; k++)                                       \
+        {                                                                    \
+            p = madd(p, m, set1(T(fast::log_coefficients[k])));              \
+        }                                                                    \
+        R y = sub(madd(e, set1(T(fast::ln2_parts[1])), mul(mul(m, z), p)),   \
+            mul(set1(T(0.5)), z));                                           \
+        R result = madd(e, set1(T(fast::ln2_parts[0])), add(m, y));          \
+        return select(less(x, set1(std::numeric_limits<T>::min())),          \
+            set1(-std::numeric_limits<T>::infinity()), result);              \
+    }                                                                        \
+                                                                             \
+    template <class T, class R>                                              \
+    __attribute__((target(TARGET))) inline void fast_sincos(R x, R &s, R &c) \
+    {                                                                        \
+        const R zero = set1(T(0));                                           \
+        const R one = set1(T(1));                                            \
+        const R half = set1(T(0.5));                                         \
+        const R three_halves = set1(T(1.5));                                 \
+        R q = round(mul(x, set1(T(0.636619772367581343))));                  \
+        R r = sub(x, mul(q, set1(T(fast::pio2_parts[0]))));                  \
+        r = sub(r, mul(q, set1(T(fast::pio2_parts[1]))));                    \
+        r = sub(r, mul(q, set1(T(fast::pio2_parts[2]))));                    \
+        R z = mul(r, r);                                                     \
+        R ps = set1(T(fast::sinf_coefficients[0]));                          \
+        R pc = set1(T(fast::cosf_coefficients[0]));                          \
+        for (size_t k = 1; k < 3; k++)                                       \
+        {                                                                    \
+            ps = madd(ps, z, set1(T(fast::sinf_coefficients[k])));           \
+            pc = madd(pc, z, set1(T(fast::cosf_coefficients[k])));           \
+        }                                                                    \
+        R sr = madd(mul(ps, z), r, r);                                       \
+        R cr = madd(mul(pc, z), z, sub(one, mul(half, z)));                  \
+        R k = sub(q, mul(set1(T(4)), floor(mul(q, set1(T(0.25))))));         \
+        R k1 = add(k, one);                                                  \
+        k1 = sub(k1, mul(set1(T(4)), floor(mul(k1, set1(T(0.25))))));        \
+        auto odd = less(half, sub(k, add(floor(mul(k, half)),                \
+            floor(mul(k, half)))));                                          \
+        s = select(odd, cr, sr);                                             \
+        c = select(odd, sr, cr);                                             \
+        s = select(less(k, three_halves), s, sub(zero, s));                  \
+        c = select(less(k1, three_halves), c, sub(zero, c));                 \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void complex_arg(T *out, const T *a,     \
+        size_t n)                                                            \
+    {                                                                        \
+        using reg = decltype(load(a));                                       \
+        constexpr size_t width = sizeof(reg) / sizeof(T);                    \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            reg lo = load(a + 2 * i);                                        \
+            reg hi = load(a + 2 * i + width);                                \
+            store(out + i, fast_atan2<T>(imag_parts(lo, hi),                 \
+                real_parts(lo, hi)));                                        \
+        }                                                                    \
+        scalar::complex_arg(out + i, a + 2 * i, n - i);                      \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void complex_exp(const T *re,            \
+        const T *im, T *out_re, T *out_im, size_t n)                         \
+    {                                                                        \
+        using reg = decltype(load(re));                                      \
+        constexpr size_t width = sizeof(reg) / sizeof(T);                    \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            reg s, c;                                                        \
+            fast_sincos<T>(load(im + i), s, c);                              \
+            reg m = fast_exp<T>(load(re + i));                               \
+            store(out_re + i, mul(m, c));                                    \
+            store(out_im + i, mul(m, s));                                    \
+        }                                                                    \
+        scalar::complex_exp(re + i, im + i, out_re + i, out_im + i, n - i);  \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void complex_log(const T *re,            \
+        const T *im, T *out_re, T *out_im, size_t n)                         \
+    {                                                                        \
+        using reg = decltype(load(re));                                      \
+        constexpr size_t width = sizeof(reg) / sizeof(T);                    \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            reg x = load(re + i);                                            \
+            reg y = load(im + i);                                            \
+            reg norm = madd(x, x, mul(y, y));                                \
+            store(out_re + i, mul(set1(T(0.5)), fast_log<T>(norm)));         \
+            store(out_im + i, fast_atan2<T>(y, x));                          \
+        }                                                                    \
+        scalar::complex_log(re + i, im + i, out_re + i, out_im + i, n - i);  \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void complex_sqrt(const T *re,           \
+        const T *im, T *out_re, T *out_im, size_t n)                         \
+    {                                                                        \
+        using reg = decltype(load(re));                                      \
+        constexpr size_t width = sizeof(reg) / sizeof(T);                    \
+        const reg zero = set1(T(0));                                         \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            reg x = load(re + i);                                            \
+            reg y = load(im + i);                                            \
+            reg ax = max(x, sub(zero, x));                                   \
+            reg modulus = sqrt(madd(x, x, mul(y, y)));                       \
+            reg t = sqrt(mul(add(ax, modulus), set1(T(0.5))));               \
+            reg u = div(y, mul(set1(T(2)),                                   \
+                max(t, set1(std::numeric_limits<T>::min()))));               \
+            auto negative = less(x, zero);                                   \
+            store(out_re + i, select(negative, max(u, sub(zero, u)), t));    \
+            store(out_im + i, select(negative, copysign(t, y), u));          \
+        }                                                                    \
+        scalar::complex_sqrt(re + i, im + i, out_re + i, out_im + i, n - i); \
+    }                                                                        \
+                                                                             \
+    template <class T>                                                       \
+    __attribute__((target(TARGET))) void complex_pow(const T *re,            \
+        const T *im, T wr, T wi, T *out_re, T *out_im, size_t n)             \
+    {                                                                        \
+        using reg = decltype(load(re));                                      \
+        constexpr size_t width = sizeof(reg) / sizeof(T);                    \
+        const reg zero = set1(T(0));                                         \
+        const reg vr = set1(wr);                                             \
+        const reg vi = set1(wi);                                             \
+        size_t i = 0;                                                        \
+        for (; i + width <= n; i += width)                                   \
+        {                                                                    \
+            reg x = load(re + i);                                            \
+            reg y = load(im + i);                                            \
+            reg norm = madd(x, x, mul(y, y));                                \
+            reg lr = mul(set1(T(0.5)), fast_log<T>(norm));                   \
+            reg li = fast_atan2<T>(y, x);                                    \
+            reg s, c;                                                        \
+            fast_sincos<T>(add(mul(vr, li), mul(vi, lr)), s, c);             \
+            reg m = fast_exp<T>(sub(mul(vr, lr), mul(vi, li)));              \
+            auto at_zero = less(norm, set1(std::numeric_limits<T>::min()));  \
+            store(out_re + i, select(at_zero, zero, mul(m, c)));             \
+            store(out_im + i, select(at_zero, zero, mul(m, s)));             \
+        }                                                                    \
+        scalar::complex_pow(re + i, im + i, wr, wi, out_re + i, out_im + i,  \
+            n - i);                                                          \
+    }
+
+        namespace sse
+        {
+#define ATMATH_SSE __attribute__((target("sse4.1"), always_inline)) inline
+            ATMATH_SSE __m128 load(const float *p) { return _mm_loadu_ps(p); }
+            ATMATH_SSE __m128d load(const double *p) { return _mm_loadu_pd(p); }
+            ATMATH_SSE __m128i load(const int *p) { return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p)); }
+            ATMATH_SSE void store(float *p, __m128 v) { _mm_storeu_ps(p, v); }
+            ATMATH_SSE void store(double *p, __m128d v) { _mm_storeu_pd(p, v); }
+            ATMATH_SSE void store(int *p, __m128i v) { _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v); }
+            ATMATH_SSE __m128 set1(float v) { return _mm_set1_ps(v); }
+            ATMATH_SSE __m128d set1(double v) { return _mm_set1_pd(v); }
+            ATMATH_SSE __m128i set1(int v) { return _mm_set1_epi32(v); }
+            ATMATH_SSE __m128 add(__m128 a, __m128 b) { return _mm_add_ps(a, b); }
+            ATMATH_SSE __m128d add(__m128d a, __m128d b) { return _mm_add_pd(a, b); }
+            ATMATH_SSE __m128i add(__m128i a, __m128i b) { return _mm_add_epi32(a, b); }
+            ATMATH_SSE __m128 sub(__m128 a, __m128 b) { return _mm_sub_ps(a, b); }
+            ATMATH_SSE __m128d sub(__m128d a, __m128d b) { return _mm_sub_pd(a, b); }
+            ATMATH_SSE __m128i sub(__m128i a, __m128i b) { return _mm_sub_epi32(a, b); }
+            ATMATH_SSE __m128 mul(__m128 a, __m128 b) { return _mm_mul_ps(a, b); }
+            ATMATH_SSE __m128d mul(__m128d a, __m128d b) { return _mm_mul_pd(a, b); }
+            ATMATH_SSE __m128i mul(__m128i a, __m128i b) { return _mm_mullo_epi32(a, b); }
+            ATMATH_SSE __m128 madd(__m128 a, __m128 b, __m128 c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+            ATMATH_SSE __m128d madd(__m128d a, __m128d b, __m128d c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+            ATMATH_SSE __m128i madd(__m128i a, __m128i b, __m128i c) { return _mm_add_epi32(_mm_mullo_epi32(a, b), c); }
+            ATMATH_SSE float hsum(__m128 v)
+            {
+                __m128 shuf = _mm_movehdup_ps(v);
+                __m128 sums = _mm_add_ps(v, shuf);
+                shuf = _mm_movehl_ps(shuf, sums);
+                return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+            }
+            ATMATH_SSE double hsum(__m128d v)
+            {
+                return _mm_cvtsd_f64(_mm_add_sd(v, _mm_unpackhi_pd(v, v)));
+            }
+            ATMATH_SSE int hsum(__m128i v)
+            {
+                __m128i sums = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+                sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+                return _mm_cvtsi128_si32(sums);
+            }
+            ATMATH_SSE __m128 div(__m128 a, __m128 b) { return _mm_div_ps(a, b); }
+            ATMATH_SSE __m128d div(__m128d a, __m128d b) { return _mm_div_pd(a, b); }
+            ATMATH_SSE __m128 sqrt(__m128 a) { return _mm_sqrt_ps(a); }
+            ATMATH_SSE __m128d sqrt(__m128d a) { return _mm_sqrt_pd(a); }
+            ATMATH_SSE __m128 min(__m128 a, __m128 b) { return _mm_min_ps(a, b); }
+            ATMATH_SSE __m128d min(__m128d a, __m128d b) { return _mm_min_pd(a, b); }
+            ATMATH_SSE __m128 max(__m128 a, __m128 b) { return _mm_max_ps(a, b); }
+            ATMATH_SSE __m128d max(__m128d a, __m128d b) { return _mm_max_pd(a, b); }
+            ATMATH_SSE __m128 less(__m128 a, __m128 b) { return _mm_cmplt_ps(a, b); }
+            ATMATH_SSE __m128d less(__m128d a, __m128d b) { return _mm_cmplt_pd(a, b); }
+            ATMATH_SSE __m128 select(__m128 mask, __m128 a, __m128 b) { return _mm_blendv_ps(b, a, mask); }
+            ATMATH_SSE __m128d select(__m128d mask, __m128d a, __m128d b) { return _mm_blendv_pd(b, a, mask); }
+            ATMATH_SSE __m128 swap_pairs(__m128 v) { return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1)); }
+            ATMATH_SSE __m128d swap_pairs(__m128d v) { return _mm_shuffle_pd(v, v, 1); }
+            ATMATH_SSE __m128 dup_real(__m128 v) { return _mm_moveldup_ps(v); }
+            ATMATH_SSE __m128d dup_real(__m128d v) { return _mm_movedup_pd(v); }
+            ATMATH_SSE __m128 dup_imag(__m128 v) { return _mm_movehdup_ps(v); }
+            ATMATH_SSE __m128d dup_imag(__m128d v) { return _mm_unpackhi_pd(v, v); }
+            ATMATH_SSE __m128 fmaddsub(__m128 a, __m128 b, __m128 c) { return _mm_addsub_ps(_mm_mul_ps(a, b), c); }
+            ATMATH_SSE __m128d fmaddsub(__m128d a, __m128d b, __m128d c) { return _mm_addsub_pd(_mm_mul_pd(a, b), c); }
+            ATMATH_SSE __m128 fmsubadd(__m128 a, __m128 b, __m128 c) { return _mm_addsub_ps(_mm_mul_ps(a, b), _mm_xor_ps(c, _mm_set1_ps(-0.0f))); }
+            ATMATH_SSE __m128d fmsubadd(__m128d a, __m128d b, __m128d c) { return _mm_addsub_pd(_mm_mul_pd(a, b), _mm_xor_pd(c, _mm_set1_pd(-0.0))); }
+            ATMATH_SSE __m128 real_parts(__m128 a, __m128 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0)); }
+            ATMATH_SSE __m128d real_parts(__m128d a, __m128d b) { return _mm_unpacklo_pd(a, b); }
+            ATMATH_SSE __m128 imag_parts(__m128 a, __m128 b) { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1)); }
+            ATMATH_SSE __m128d imag_parts(__m128d a, __m128d b) { return _mm_unpackhi_pd(a, b); }
+            ATMATH_SSE __m128 copysign(__m128 a, __m128 b) { return _mm_or_ps(_mm_andnot_ps(_mm_set1_ps(-0.0f), a), _mm_and_ps(_mm_set1_ps(-0.0f), b)); }
+            ATMATH_SSE __m128d copysign(__m128d a, __m128d b) { return _mm_or_pd(_mm_andnot_pd(_mm_set1_pd(-0.0), a), _mm_and_pd(_mm_set1_pd(-0.0), b)); }
+            ATMATH_SSE __m128 round(__m128 v) { return _mm_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+            ATMATH_SSE __m128 floor(__m128 v) { return _mm_round_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+            ATMATH_SSE __m128 scale2(__m128 v, __m128 n)
+            {
+                __m128i bits = _mm_slli_epi32(_mm_add_epi32(_mm_cvtps_epi32(n), _mm_set1_epi32(127)), 23);
+                return _mm_mul_ps(v, _mm_castsi128_ps(bits));
+            }
+            ATMATH_SSE __m128 exponent(__m128 v)
+            {
+                __m128i biased = _mm_srli_epi32(_mm_castps_si128(v), 23);
+                return _mm_cvtepi32_ps(_mm_sub_epi32(biased, _mm_set1_epi32(126)));
+            }
+            ATMATH_SSE __m128 mantissa(__m128 v)
+            {
+                return _mm_or_ps(_mm_and_ps(v, _mm_castsi128_ps(_mm_set1_epi32(0x007FFFFF))), _mm_set1_ps(0.5f));
+            }
+            ATMATH_SSE __m128d widen_low(__m128 v) { return _mm_cvtps_pd(v); }
+            ATMATH_SSE __m128d widen_high(__m128 v) { return _mm_cvtps_pd(_mm_movehl_ps(v, v)); }
+#undef ATMATH_SSE
+
+            ATMATH_SIMD_KERNELS("sse4.1")
+        }
+
+        namespace avx2
+        {
+#define ATMATH_AVX2 __attribute__((target("avx2,fma"), always_inline)) inline
+            ATMATH_AVX2 __m256 load(const float *p) { return _mm256_loadu_ps(p); }
+            ATMATH_AVX2 __m256d load(const double *p) { return _mm256_loadu_pd(p); }
+            ATMATH_AVX2 __m256i load(const int *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+            ATMATH_AVX2 void store(float *p, __m256 v) { _mm256_storeu_ps(p, v); }
+            ATMATH_AVX2 void store(double *p, __m256d v) { _mm256_storeu_pd(p, v); }
+            ATMATH_AVX2 void store(int *p, __m256i v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+            ATMATH_AVX2 __m256 set1(float v) { return _mm256_set1_ps(v); }
+            ATMATH_AVX2 __m256d set1(double v) { return _mm256_set1_pd(v); }
+            ATMATH_AVX2 __m256i set1(int v) { return _mm256_set1_epi32(v); }
+            ATMATH_AVX2 __m256 add(__m256 a, __m256 b) { return _mm256_add_ps(a, b); }
+            ATMATH_AVX2 __m256d add(__m256d a, __m256d b) { return _mm256_add_pd(a, b); }
+            ATMATH_AVX2 __m256i add(__m256i a, __m256i b) { return _mm256_add_epi32(a, b); }
+            ATMATH_AVX2 __m256 sub(__m256 a, __m256 b) { return _mm256_sub_ps(a, b); }
+            ATMATH_AVX2 __m256d sub(__m256d a, __m256d b) { return _mm256_sub_pd(a, b); }
+            ATMATH_AVX2 __m256i sub(__m256i a, __m256i b) { return _mm256_sub_epi32(a, b); }
+            ATMATH_AVX2 __m256 mul(__m256 a, __m256 b) { return _mm256_mul_ps(a, b); }
+            ATMATH_AVX2 __m256d mul(__m256d a, __m256d b) { return _mm256_mul_pd(a, b); }
+            ATMATH_AVX2 __m256i mul(__m256i a, __m256i b) { return _mm256_mullo_epi32(a, b); }
+            ATMATH_AVX2 __m256 madd(__m256 a, __m256 b, __m256 c) { return _mm256_fmadd_ps(a, b, c); }
+            ATMATH_AVX2 __m256d madd(__m256d a, __m256d b, __m256d c) { return _mm256_fmadd_pd(a, b, c); }
+            ATMATH_AVX2 __m256i madd(__m256i a, __m256i b, __m256i c) { return _mm256_add_epi32(_mm256_mullo_epi32(a, b), c); }
+            ATMATH_AVX2 float hsum(__m256 v)
+            {
+                __m128 sums = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+                __m128 shuf = _mm_movehdup_ps(sums);
+                sums = _mm_add_ps(sums, shuf);
+                shuf = _mm_movehl_ps(shuf, sums);
+                return _mm_cvtss_f32(_mm_add_ss(sums, shuf));
+            }
+            ATMATH_AVX2 double hsum(__m256d v)
+            {
+                __m128d sums = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+                return _mm_cvtsd_f64(_mm_add_sd(sums, _mm_unpackhi_pd(sums, sums)));
+            }
+            ATMATH_AVX2 int hsum(__m256i v)
+            {
+                __m128i sums = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+                sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(1, 0, 3, 2)));
+                sums = _mm_add_epi32(sums, _mm_shuffle_epi32(sums, _MM_SHUFFLE(2, 3, 0, 1)));
+                return _mm_cvtsi128_si32(sums);
+            }
+            ATMATH_AVX2 __m256 div(__m256 a, __m256 b) { return _mm256_div_ps(a, b); }
+            ATMATH_AVX2 __m256d div(__m256d a, __m256d b) { return _mm256_div_pd(a, b); }
+            ATMATH_AVX2 __m256 sqrt(__m256 a) { return _mm256_sqrt_ps(a); }
+            ATMATH_AVX2 __m256d sqrt(__m256d a) { return _mm256_sqrt_pd(a); }
+            ATMATH_AVX2 __m256 min(__m256 a, __m256 b) { return _mm256_min_ps(a, b); }
+            ATMATH_AVX2 __m256d min(__m256d a, __m256d b) { return _mm256_min_pd(a, b); }
+            ATMATH_AVX2 __m256 max(__m256 a, __m256 b) { return _mm256_max_ps(a, b); }
+            ATMATH_AVX2 __m256d max(__m256d a, __m256d b) { return _mm256_max_pd(a, b); }
+            ATMATH_AVX2 __m256 less(__m256 a, __m256 b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+            ATMATH_AVX2 __m256d less(__m256d a, __m256d b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+            ATMATH_AVX2 __m256 select(__m256 mask, __m256 a, __m256 b) { return _mm256_blendv_ps(b, a, mask); }
+            ATMATH_AVX2 __m256d select(__m256d mask, __m256d a, __m256d b) { return _mm256_blendv_pd(b, a, mask); }
+            ATMATH_AVX2 __m256 swap_pairs(__m256 v) { return _mm256_permute_ps(v, 0xB1); }
+            ATMATH_AVX2 __m256d swap_pairs(__m256d v) { return _mm256_permute_pd(v, 0x5); }
+            ATMATH_AVX2 __m256 dup_real(__m256 v) { return _mm256_moveldup_ps(v); }
+            ATMATH_AVX2 __m256d dup_real(__m256d v) { return _mm256_movedup_pd(v); }
+            ATMATH_AVX2 __m256 dup_imag(__m256 v) { return _mm256_movehdup_ps(v); }
+            ATMATH_AVX2 __m256d dup_imag(__m256d v) { return _mm256_permute_pd(v, 0xF); }
+            ATMATH_AVX2 __m256 fmaddsub(__m256 a, __m256 b, __m256 c) { return _mm256_fmaddsub_ps(a, b, c); }
+            ATMATH_AVX2 __m256d fmaddsub(__m256d a, __m256d b, __m256d c) { return _mm256_fmaddsub_pd(a, b, c); }
+            ATMATH_AVX2 __m256 fmsubadd(__m256 a, __m256 b, __m256 c) { return _mm256_fmsubadd_ps(a, b, c); }
+            ATMATH_AVX2 __m256d fmsubadd(__m256d a, __m256d b, __m256d c) { return _mm256_fmsubadd_pd(a, b, c); }
+            // The in-lane shuffles leave 64-bit blocks in a0 b0 a1 b1 order;
+            // the cross-lane permute restores a0 a1 b0 b1.
+            ATMATH_AVX2 __m256 real_parts(__m256 a, __m256 b)
+            {
+                __m256 even = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+                return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(even), _MM_SHUFFLE(3, 1, 2, 0)));
+            }
+            ATMATH_AVX2 __m256d real_parts(__m256d a, __m256d b) { return _mm256_permute4x64_pd(_mm256_unpacklo_pd(a, b), _MM_SHUFFLE(3, 1, 2, 0)); }
+            ATMATH_AVX2 __m256 imag_parts(__m256 a, __m256 b)
+            {
+                __m256 odd = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+                return _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(odd), _MM_SHUFFLE(3, 1, 2, 0)));
+            }
+            ATMATH_AVX2 __m256d imag_parts(__m256d a, __m256d b) { return _mm256_permute4x64_pd(_mm256_unpackhi_pd(a, b), _MM_SHUFFLE(3, 1, 2, 0)); }
+            ATMATH_AVX2 __m256 copysign(__m256 a, __m256 b) { return _mm256_or_ps(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a), _mm256_and_ps(_mm256_set1_ps(-0.0f), b)); }
+            ATMATH_AVX2 __m256d copysign(__m256d a, __m256d b) { return _mm256_or_pd(_mm256_andnot_pd(_mm256_set1_pd(-0.0), a), _mm256_and_pd(_mm256_set1_pd(-0.0), b)); }
+            ATMATH_AVX2 __m256 round(__m256 v) { return _mm256_round_ps(v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+            ATMATH_AVX2 __m256 floor(__m256 v) { return _mm256_round_ps(v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+            ATMATH_AVX2 __m256 scale2(__m256 v, __m256 n)
+            {
+                __m256i bits = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127)), 23);
+                return _mm256_mul_ps(v, _mm256_castsi256_ps(bits));
+            }
+            ATMATH_AVX2 __m256 exponent(__m256 v)
+            {
+                __m256i biased = _mm256_srli_epi32(_mm256_castps_si256(v), 23);
+                return _mm256_cvtepi32_ps(_mm256_sub_epi32(biased, _mm256_set1_epi32(126)));
+            }
+            ATMATH_AVX2 __m256 mantissa(__m256 v)
+            {
+                return _mm256_or_ps(_mm256_and_ps(v, _mm256_castsi256_ps(_mm256_set1_epi32(0x007FFFFF))), _mm256_set1_ps(0.5f));
+            }
+            ATMATH_AVX2 __m256d widen_low(__m256 v) { return _mm256_cvtps_pd(_mm256_castps256_ps128(v)); }
+            ATMATH_AVX2 __m256d widen_high(__m256 v) { return _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)); }
+#undef ATMATH_AVX2
+
+            ATMATH_SIMD_KERNELS("avx2,fma")
+        }
+
+        namespace avx512
+        {
+#define ATMATH_AVX512 __attribute__((target("avx512f"), always_inline)) inline
+            ATMATH_AVX512 __m512 load(const float *p) { return _mm512_loadu_ps(p); }
+            ATMATH_AVX512 __m512d load(const double *p) { return _mm512_loadu_pd(p); }
+            ATMATH_AVX512 __m512i load(const int *p) { return _mm512_loadu_si512(p); }
+            ATMATH_AVX512 void store(float *p, __m512 v) { _mm512_storeu_ps(p, v); }
+            ATMATH_AVX512 void store(double *p, __m512d v) { _mm512_storeu_pd(p, v); }
+            ATMATH_AVX512 void store(int *p, __m512i v) { _mm512_storeu_si512(p, v); }
+            ATMATH_AVX512 __m512 set1(float v) { return _mm512_set1_ps(v); }
+            ATMATH_AVX512 __m512d set1(double v) { return _mm512_set1_pd(v); }
+            ATMATH_AVX512 __m512i set1(int v) { return _mm512_set1_epi32(v); }
+            ATMATH_AVX512 __m512 add(__m512 a, __m512 b) { return _mm512_add_ps(a, b); }
+            ATMATH_AVX512 __m512d add(__m512d a, __m512d b) { return _mm512_add_pd(a, b); }
+            ATMATH_AVX512 __m512i add(__m512i a, __m512i b) { return _mm512_add_epi32(a, b); }
+            ATMATH_AVX512 __m512 sub(__m512 a, __m512 b) { return _mm512_sub_ps(a, b); }
+            ATMATH_AVX512 __m512d sub(__m512d a, __m512d b) { return _mm512_sub_pd(a, b); }
+            ATMATH_AVX512 __m512i sub(__m512i a, __m512i b) { return _mm512_sub_epi32(a, b); }
+            ATMATH_AVX512 __m512 mul(__m512 a, __m512 b) { return _mm512_mul_ps(a, b); }
+            ATMATH_AVX512 __m512d mul(__m512d a, __m512d b) { return _mm512_mul_pd(a, b); }
+            ATMATH_AVX512 __m512i mul(__m512i a, __m512i b) { return _mm512_mullo_epi32(a, b); }
+            ATMATH_AVX512 __m512 madd(__m512 a, __m512 b, __m512 c) { return _mm512_fmadd_ps(a, b, c); }
+            ATMATH_AVX512 __m512d madd(__m512d a, __m512d b, __m512d c) { return _mm512_fmadd_pd(a, b, c); }
+            ATMATH_AVX512 __m512i madd(__m512i a, __m512i b, __m512i c) { return _mm512_add_epi32(_mm512_mullo_epi32(a, b), c); }
+            // Spilled and summed in scalar code: hsum runs once per kernel call,
+            // and the lane-shuffle intrinsics trip -Wuninitialized in GCC 12.
+            ATMATH_AVX512 float hsum(__m512 v)
+            {
+                alignas(64) float lanes[16];
+                _mm512_store_ps(lanes, v);
+                float result = 0;
+                for (float lane : lanes)
+                {
+                    result += lane;
+                }
+                return result;
+            }
+            ATMATH_AVX512 double hsum(__m512d v)
+            {
+                alignas(64) double lanes[8];
+                _mm512_store_pd(lanes, v);
+                double result = 0;
+                for (double lane : lanes)
+                {
+                    result += lane;
+                }
+                return result;
+            }
+            ATMATH_AVX512 int hsum(__m512i v)
+            {
+                alignas(64) int lanes[16];
+                _mm512_store_si512(lanes, v);
+                int result = 0;
+                for (int lane : lanes)
+                {
+                    result += lane;
+                }
+                return result;
+            }
+            // The unmasked sqrt/min/max start from _mm512_undefined_ps(), which
+            // GCC 12 reports under -Wmaybe-uninitialized; the all-ones zero-masked
+            // forms compile to the same instructions.
+            ATMATH_AVX512 __m512 div(__m512 a, __m512 b) { return _mm512_div_ps(a, b); }
+            ATMATH_AVX512 __m512d div(__m512d a, __m512d b) { return _mm512_div_pd(a, b); }
+            ATMATH_AVX512 __m512 sqrt(__m512 a) { return _mm512_maskz_sqrt_ps(0xFFFF, a); }
+            ATMATH_AVX512 __m512d sqrt(__m512d a) { return _mm512_maskz_sqrt_pd(0xFF, a); }
+            ATMATH_AVX512 __m512 min(__m512 a, __m512 b) { return _mm512_maskz_min_ps(0xFFFF, a, b); }
+            ATMATH_AVX512 __m512d min(__m512d a, __m512d b) { return _mm512_maskz_min_pd(0xFF, a, b); }
+            ATMATH_AVX512 __m512 max(__m512 a, __m512 b) { return _mm512_maskz_max_ps(0xFFFF, a, b); }
+            ATMATH_AVX512 __m512d max(__m512d a, __m512d b) { return _mm512_maskz_max_pd(0xFF, a, b); }
+            ATMATH_AVX512 __mmask16 less(__m512 a, __m512 b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+            ATMATH_AVX512 __mmask8 less(__m512d a, __m512d b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+            ATMATH_AVX512 __m512 select(__mmask16 mask, __m512 a, __m512 b) { return _mm512_mask_blend_ps(mask, b, a); }
+            ATMATH_AVX512 __m512d select(__mmask8 mask, __m512d a, __m512d b) { return _mm512_mask_blend_pd(mask, b, a); }
+            ATMATH_AVX512 __m512 swap_pairs(__m512 v) { return _mm512_maskz_permute_ps(0xFFFF, v, 0xB1); }
+            ATMATH_AVX512 __m512d swap_pairs(__m512d v) { return _mm512_maskz_permute_pd(0xFF, v, 0x55); }
+            ATMATH_AVX512 __m512 dup_real(__m512 v) { return _mm512_maskz_moveldup_ps(0xFFFF, v); }
+            ATMATH_AVX512 __m512d dup_real(__m512d v) { return _mm512_maskz_movedup_pd(0xFF, v); }
+            ATMATH_AVX512 __m512 dup_imag(__m512 v) { return _mm512_maskz_movehdup_ps(0xFFFF, v); }
+            ATMATH_AVX512 __m512d dup_imag(__m512d v) { return _mm512_maskz_permute_pd(0xFF, v, 0xFF); }
+            ATMATH_AVX512 __m512 fmaddsub(__m512 a, __m512 b, __m512 c) { return _mm512_fmaddsub_ps(a, b, c); }
+            ATMATH_AVX512 __m512d fmaddsub(__m512d a, __m512d b, __m512d c) { return _mm512_fmaddsub_pd(a, b, c); }
+            ATMATH_AVX512 __m512 fmsubadd(__m512 a, __m512 b, __m512 c) { return _mm512_fmsubadd_ps(a, b, c); }
+            ATMATH_AVX512 __m512d fmsubadd(__m512d a, __m512d b, __m512d c) { return _mm512_fmsubadd_pd(a, b, c); }
+            ATMATH_AVX512 __m512 real_parts(__m512 a, __m512 b)
+            {
+                return _mm512_permutex2var_ps(a, _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24, 26, 28, 30), b);
+            }
+            ATMATH_AVX512 __m512d real_parts(__m512d a, __m512d b) { return _mm512_permutex2var_pd(a, _mm512_setr_epi64(0, 2, 4, 6, 8, 10, 12, 14), b); }
+            ATMATH_AVX512 __m512 imag_parts(__m512 a, __m512 b)
+            {
+                return _mm512_permutex2var_ps(a, _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21, 23, 25, 27, 29, 31), b);
+            }
+            ATMATH_AVX512 __m512d imag_parts(__m512d a, __m512d b) { return _mm512_permutex2var_pd(a, _mm512_setr_epi64(1, 3, 5, 7, 9, 11, 13, 15), b); }
+            // AVX-512F has no float bitwise ops (those are AVX-512DQ), so the
+            // sign bit is moved through the integer domain.
+            ATMATH_AVX512 __m512 copysign(__m512 a, __m512 b)
+            {
+                __m512i sign = _mm512_set1_epi32(static_cast<int>(0x80000000u));
+                return _mm512_castsi512_ps(_mm512_ternarylogic_epi32(sign, _mm512_castps_si512(a), _mm512_castps_si512(b), 0xAC));
+            }
+            ATMATH_AVX512 __m512d copysign(__m512d a, __m512d b)
+            {
+                __m512i sign = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ull));
+                return _mm512_castsi512_pd(_mm512_ternarylogic_epi64(sign, _mm512_castpd_si512(a), _mm512_castpd_si512(b), 0xAC));
+            }
+            ATMATH_AVX512 __m512 round(__m512 v) { return _mm512_maskz_roundscale_ps(0xFFFF, v, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+            ATMATH_AVX512 __m512 floor(__m512 v) { return _mm512_maskz_roundscale_ps(0xFFFF, v, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+            ATMATH_AVX512 __m512 scale2(__m512 v, __m512 n) { return _mm512_maskz_scalef_ps(0xFFFF, v, n); }
+            ATMATH_AVX512 __m512 exponent(__m512 v)
+            {
+                __m512i biased = _mm512_maskz_srli_epi32(0xFFFF, _mm512_castps_si512(v), 23);
+                return _mm512_maskz_cvtepi32_ps(0xFFFF, _mm512_sub_epi32(biased, _mm512_set1_epi32(126)));
+            }
+            ATMATH_AVX512 __m512 mantissa(__m512 v)
+            {
+                __m512i bits = _mm512_and_si512(_mm512_castps_si512(v), _mm512_set1_epi32(0x007FFFFF));
+                return _mm512_castsi512_ps(_mm512_or_si512(bits, _mm512_set1_epi32(0x3F000000)));
+            }
+            ATMATH_AVX512 __m512d widen_low(__m512 v)
+            {
+                __m256d low = _mm512_maskz_extractf64x4_pd(0xF, _mm512_castps_pd(v), 0);
+                return _mm512_maskz_cvtps_pd(0xFF, _mm256_castpd_ps(low));
+            }
+            ATMATH_AVX512 __m512d widen_high(__m512 v)
+            {
+                __m256d high = _mm512_maskz_extractf64x4_pd(0xF, _mm512_castps_pd(v), 1);
+                return _mm512_maskz_cvtps_pd(0xFF, _mm256_castpd_ps(high));
+            }
+#undef ATMATH_AVX512
+
+            ATMATH_SIMD_KERNELS("avx512f")
+        }
+
+#undef ATMATH_SIMD_KERNELS
+
+// Forwards to the widest kernel the CPU supports. Element types without SIMD
+// kernels always take the scalar loop.
+#define ATMATH_SIMD_DISPATCH(KERNEL, ...)          \
+    if constexpr (is_simd_type<T>::value)          \
+    {                                              \
+        switch (level())                           \
+        {                                          \
+        case Level::AVX512:                        \
+            return avx512::KERNEL(__VA_ARGS__);    \
+        case Level::AVX2:                          \
+            return avx2::KERNEL(__VA_ARGS__);      \
+        case Level::SSE:                           \
+            return sse::KERNEL(__VA_ARGS__);       \
+        default:                                   \
+            break;                                 \
+        }                                          \
+    }                                              \
+    return scalar::KERNEL(__VA_ARGS__);
+
+#else
+
+#define ATMATH_SIMD_DISPATCH(KERNEL, ...) \
+    return scalar::KERNEL(__VA_ARGS__);
+
+#endif
+
+        template <class T>
+        inline T dot(const T *a, const T *b, size_t n)
+        {
+            ATMATH_SIMD_DISPATCH(dot, a, b, n)
+        }
+
+        template <class T>
+        inline T sum(const T *a, size_t n)
+        {
+            ATMATH_SIMD_DISPATCH(sum, a, n)
+        }
+
+        // Kahan (Neumaier = false) or Neumaier sum of a[i], or of a[i] * b[i]
+        // when b is non-null, each SIMD lane carrying its own correction.
+        // Products are rounded before they are summed. Float or double only.
+        template <bool Neumaier, class T>
+        inline T sum_compensated(const T *a, const T *b, size_t n)
+        {
+            static_assert(std::is_floating_point<T>::value, "Compensated summation takes float or double");
+            ATMATH_SIMD_DISPATCH(sum_compensated<Neumaier>, a, b, n)
+        }
+
+        // Sum of a[i], or of a[i] * b[i] when b is non-null, accumulated in
+        // double. Float data is widened in registers, so it keeps its
+        // bandwidth; float products are exact in double.
+        template <class T>
+        inline double sum_widened(const T *a, const T *b, size_t n)
+        {
+            if constexpr (std::is_same<T, float>::value)
+            {
+                ATMATH_SIMD_DISPATCH(sum_widened, a, b, n)
+            }
+            return scalar::sum_widened(a, b, n);
+        }
+
+        // Pairwise sum of a[i], or of a[i] * b[i] when b is non-null: the
+        // range is halved down to blocks of pairwise_block elements summed
+        // by the SIMD kernels, so the error grows with log2(n / block)
+        // rather than n.
+        constexpr size_t pairwise_block = 256;
+
+        template <class T>
+        T sum_pairwise(const T *a, const T *b, size_t n)
+        {
+            if (n <= pairwise_block)
+            {
+                return b ? dot(a, b, n) : sum(a, n);
+            }
+            size_t half = (n / 2 + pairwise_block - 1) / pairwise_block * pairwise_block;
+            return sum_pairwise(a, b, half) + sum_pairwise(a + half, b ? b + half : nullptr, n - half);
+        }
+
+        template <class T>
+        inline void add(T *a, const T *b, size_t n)
+        {
+            ATMATH_SIMD_DISPATCH(add, a, b, n)
+        }
+
+        template <class T>
+        inline void sub(T *a, const T *b, size_t n)
+        {
+            ATMATH_SIMD_DISPATCH(sub, a, b, n)
+        }
+
+        template <class T>
+        inline void mul(T *a, const T *b, size_t n)
+        {
+            ATMATH_SIMD_DISPATCH(mul, a, b, n)
+        }
+
+        template <class T>
+        inline void scale(T *a, T value, size_t n)
+        {
+            ATMATH_SIMD_DISPATCH(scale, a, value, n)
+        }
+
+        // Applies the row-major 3x3 matrix m to the points (x, y, z). The
+        // output lanes may be the input lanes themselves but must not
+        // otherwise overlap them.
+        template <class T>
+        inline void transform3(const T *m, const T *x, const T *y, const T *z, T *ox, T *oy, T *oz, size_t n)
+        {
+            ATMATH_SIMD_DISPATCH(transform3, m, x, y, z, ox, oy, oz, n)
+        }
+
+        // Batch nlerp (spherical = false) or slerp of unit quaternions given
+        // as (real, i, j, k) lanes, at t[0] for all elements (t_step = 0) or
+        // at t[i] (t_step = 1). Floating point only.
+        template <class T>
+        inline void interpolate(const T *const *q0, const T *const *q1, const T *t, size_t t_step, bool spherical, T *const *out, size_t n)
+        {
+            ATMATH_SIMD_DISPATCH(interpolate, q0, q1, t, t_step, spherical, out, n)
+        }
+
+        // Interleaved complex kernels over n (real, imag) pairs of float or
+        // double; see the scalar versions for the exact semantics.
+        template <class T>
+        inline void complex_mul(T *out, const T *a, const T *b, size_t n)
+        {
+            static_assert(std::is_floating_point<T>::value, "Complex kernels take float or double lanes");
+            ATMATH_SIMD_DISPATCH(complex_mul, out, a, b, n)
+        }
+
+        template <class T>
+        inline void complex_mul_conj(T *out, const T *a, const T *b, size_t n)
+        {
+            static_assert(std::is_floating_point<T>::value, "Complex kernels take float or double lanes");
+            ATMATH_SIMD_DISPATCH(complex_mul_conj, out, a, b, n)
+        }
+
+        template <class T>
+        inline void complex_mac(T *acc, const T *a, const T *b, size_t n)
+        {
+            static_assert(std::is_floating_point<T>::value, "Complex kernels take float or double lanes");
+            ATMATH_SIMD_DISPATCH(complex_mac, acc, a, b, n)
+        }
+
+        template <class T>
+        inline void complex_div(T *out, const T *a, const T *b, size_t n)
+        {
+            static_assert(std::is_floating_point<T>::value, "Complex kernels take float or double lanes");
+            ATMATH_SIMD_DISPATCH(complex_div, out, a, b, n)
+        }
+
+        template <class T>
+        inline void complex_abs(T *out, const T *a, size_t n)
+        {
+            static_assert(std::is_floating_point<T>::value, "Complex kernels take float or double lanes");
+            ATMATH_SIMD_DISPATCH(complex_abs, out, a, n)
+        }
+
+        template <class T>
+        inline void complex_arg(T *out, const T *a, size_t n)
+        {
+            static_assert(std::is_floating_point<T>::value, "Complex kernels take float or double lanes");
+            ATMATH_SIMD_DISPATCH(complex_arg, out, a, n)
+        }
+
+        // Split-lane complex exp/log/sqrt/pow, single precision only.
+        template <class T>
+        inline void complex_exp(const T *re, const T *im, T *out_re, T *out_im, size_t n)
+        {
+            static_assert(std::is_same<T, float>::value, "Fast complex functions are single precision");
+            ATMATH_SIMD_DISPATCH(complex_exp, re, im, out_re, out_im, n)
+        }
+
+        template <class T>
+        inline void complex_log(const T *re, const T *im, T *out_re, T *out_im, size_t n)
+        {
+            static_assert(std::is_same<T, float>::value, "Fast complex functions are single precision");
+            ATMATH_SIMD_DISPATCH(complex_log, re, im, out_re, out_im, n)
+        }
+
+        template <class T>
+        inline void complex_sqrt(const T *re, const T *im, T *out_re, T *out_im, size_t n)
+        {
+            static_assert(std::is_same<T, float>::value, "Fast complex functions are single precision");
+            ATMATH_SIMD_DISPATCH(complex_sqrt, re, im, out_re, out_im, n)
+        }
+
+        template <class T>
+        inline void complex_pow(const T *re, const T *im, T wr, T wi, T *out_re, T *out_im, size_t n)
+        {
+            static_assert(std::is_same<T, float>::value, "Fast complex functions are single precision");
+            ATMATH_SIMD_DISPATCH(complex_pow, re, im, wr, wi, out_re, out_im, n)
+        }
+
+#undef ATMATH_SIMD_DISPATCH
+
+    }
+}
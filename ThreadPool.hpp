@@ -0,0 +1,467 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Work-stealing pool of worker threads for index-parallel loops, used by the
+// parallel execution policies (Execution.hpp). A loop's index range is split
+// evenly over the participants; each one claims grain-sized pieces from the
+// front of its own range and, once that is empty, steals the back half of
+// another participant's range. The caller participates instead of sleeping.
+//
+// One loop runs at a time: concurrent callers queue on the submit lock. A
+// parallel_for issued from inside a loop body runs inline on the calling
+// thread, so nested parallelism never adds threads beyond the pool's size.
+namespace atMath
+{
+
+    struct ThreadPoolOptions
+    {
+        // Threads running loop bodies, the caller included; 0 uses one per
+        // CPU available to the process.
+        size_t threads = 0;
+        // Pin each worker to one CPU, spreading workers round-robin over the
+        // NUMA nodes so a parallel loop draws on every node's memory
+        // bandwidth. Linux only; elsewhere this is ignored.
+        bool pin = false;
+    };
+
+    class ThreadPool
+    {
+    protected:
+        // Unclaimed part of one participant's share, packed as
+        // (begin << 32) | end so owner and thieves update it with one CAS.
+        struct alignas(64) Range
+        {
+            std::atomic<uint64_t> bounds{0};
+        };
+
+        std::vector<std::thread> p_threads;
+        std::vector<Range> p_ranges;
+        // Steal order per participant: same-node participants first.
+        std::vector<std::vector<size_t>> p_victims;
+        std::mutex p_submit;
+        std::mutex p_mutex;
+        std::condition_variable p_wake;
+        std::condition_variable p_done;
+        bool p_stop = false;
+        uint64_t p_generation = 0;
+        size_t p_finished = 0;
+
+        // The running loop. Every worker wakes for every loop and checks in
+        // when it has drained it; the caller waits for all of them, so no
+        // worker can still be reading these when the next loop is set up.
+        const std::function<void(size_t)> *p_body = nullptr;
+        size_t p_grain = 1;
+        std::atomic<size_t> p_remaining{0};
+        std::exception_ptr p_error;
+
+        static uint64_t pack(uint64_t begin, uint64_t end) { return begin << 32 | end; }
+
+        static bool &inside_loop()
+        {
+            thread_local bool inside = false;
+            return inside;
+        }
+
+        void run(size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                try
+                {
+                    (*p_body)(i);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(p_mutex);
+                    if (!p_error)
+                    {
+                        p_error = std::current_exception();
+                    }
+                }
+            }
+            if (p_remaining.fetch_sub(end - begin) == end - begin)
+            {
+                std::lock_guard<std::mutex> lock(p_mutex);
+                p_done.notify_all();
+            }
+        }
+
+        // Claims up to p_grain indices from the front of participant id's range.
+        bool take(size_t id, size_t &begin, size_t &end)
+        {
+            std::atomic<uint64_t> &bounds = p_ranges[id].bounds;
+            uint64_t current = bounds.load();
+            while (true)
+            {
+                uint64_t b = current >> 32, e = current & 0xffffffffu;
+                if (b >= e)
+                {
+                    return false;
+                }
+                uint64_t next = std::min<uint64_t>(e, b + p_grain);
+                if (bounds.compare_exchange_weak(current, pack(next, e)))
+                {
+                    begin = b;
+                    end = next;
+                    return true;
+                }
+            }
+        }
+
+        // Moves the back half of a victim's range into participant id's own,
+        // which must be empty. An empty range is never the target of a
+        // successful CAS, so the plain store cannot lose a concurrent update.
+        bool steal(size_t id)
+        {
+            for (size_t victim : p_victims[id])
+            {
+                std::atomic<uint64_t> &bounds = p_ranges[victim].bounds;
+                uint64_t current = bounds.load();
+                while (true)
+                {
+                    uint64_t b = current >> 32, e = current & 0xffffffffu;
+                    if (b >= e)
+                    {
+                        break;
+                    }
+                    uint64_t split = e - (e - b + 1) / 2;
+                    if (bounds.compare_exchange_weak(current, pack(b, split)))
+                    {
+                        p_ranges[id].bounds.store(pack(split, e));
+                        return true;
+                    }
+                }
+            }
+            return false;
+        }
+
+        void drain(size_t id)
+        {
+            bool &inside = inside_loop();
+            bool outer = inside;
+            inside = true;
+            size_t begin, end;
+            do
+            {
+                while (take(id, begin, end))
+                {
+                    run(begin, end);
+                }
+            } while (steal(id));
+            inside = outer;
+        }
+
+        void worker(size_t id)
+        {
+            uint64_t seen = 0;
+            std::unique_lock<std::mutex> lock(p_mutex);
+            while (true)
+            {
+                p_wake.wait(lock, [&]
+                            { return p_stop || p_generation != seen; });
+                if (p_stop)
+                {
+                    return;
+                }
+                seen = p_generation;
+                lock.unlock();
+                drain(id);
+                lock.lock();
+                if (++p_finished == p_threads.size())
+                {
+                    p_done.notify_all();
+                }
+            }
+        }
+
+        // Runs one loop of fewer than 2^32 indices.
+        void parallel_segment(size_t offset, size_t count, size_t grain, const std::function<void(size_t)> &body)
+        {
+            std::function<void(size_t)> shifted;
+            const std::function<void(size_t)> *target = &body;
+            if (offset != 0)
+            {
+                shifted = [&](size_t i)
+                { body(offset + i); };
+                target = &shifted;
+            }
+
+            std::lock_guard<std::mutex> submit(p_submit);
+            {
+                std::lock_guard<std::mutex> lock(p_mutex);
+                size_t participants = size();
+                for (size_t id = 0; id < participants; id++)
+                {
+                    p_ranges[id].bounds.store(pack(count * id / participants, count * (id + 1) / participants));
+                }
+                p_body = target;
+                p_grain = grain != 0 ? grain : default_grain(count, participants);
+                p_remaining.store(count);
+                p_error = nullptr;
+                p_finished = 0;
+                p_generation++;
+            }
+            p_wake.notify_all();
+            drain(0);
+
+            std::unique_lock<std::mutex> lock(p_mutex);
+            p_done.wait(lock, [&]
+                        { return p_remaining.load() == 0 && p_finished == p_threads.size(); });
+            p_body = nullptr;
+            if (p_error)
+            {
+                std::rethrow_exception(std::exchange(p_error, nullptr));
+            }
+        }
+
+        static ThreadPoolOptions &global_options()
+        {
+            static ThreadPoolOptions options = []
+            {
+                ThreadPoolOptions defaults;
+                if (const char *threads = std::getenv("ATMATH_THREADS"))
+                {
+                    defaults.threads = std::strtoul(threads, nullptr, 10);
+                }
+                return defaults;
+            }();
+            return options;
+        }
+
+        static std::atomic<bool> &global_created()
+        {
+            static std::atomic<bool> created{false};
+            return created;
+        }
+
+        static const ThreadPoolOptions &claim_global_options()
+        {
+            global_created().store(true);
+            return global_options();
+        }
+
+    public:
+        explicit ThreadPool(const ThreadPoolOptions &options)
+        {
+            std::vector<std::vector<int>> nodes = numa_cpus();
+            size_t cpus = 0;
+            for (const std::vector<int> &node : nodes)
+            {
+                cpus += node.size();
+            }
+            size_t threads = options.threads;
+            if (threads == 0)
+            {
+                threads = std::max<size_t>(1, cpus);
+            }
+
+            // Participant id is placed on node id % nodes.size().
+            p_ranges = std::vector<Range>(threads);
+            p_victims.resize(threads);
+            for (size_t id = 0; id < threads; id++)
+            {
+                for (bool same_node : {true, false})
+                {
+                    for (size_t step = 1; step < threads; step++)
+                    {
+                        size_t victim = (id + step) % threads;
+                        if ((victim % nodes.size() == id % nodes.size()) == same_node)
+                        {
+                            p_victims[id].push_back(victim);
+                        }
+                    }
+                }
+            }
+
+            for (size_t id = 1; id < threads; id++)
+            {
+                p_threads.emplace_back([this, id]
+                                       { worker(id); });
+                if (options.pin && cpus != 0)
+                {
+                    const std::vector<int> &node = nodes[id % nodes.size()];
+                    pin(p_threads.back(), node[(id / nodes.size()) % node.size()]);
+                }
+            }
+        }
+
+        explicit ThreadPool(size_t threads = 0) : ThreadPool(ThreadPoolOptions{threads, false}) {}
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(p_mutex);
+                p_stop = true;
+            }
+            p_wake.notify_all();
+            for (std::thread &thread : p_threads)
+            {
+                thread.join();
+            }
+        }
+
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+
+        // Threads that execute loop bodies, including the caller.
+        size_t size() const { return p_threads.size() + 1; }
+
+        // Indices claimed per step when a loop passes grain 0: about eight
+        // steps per participant keeps the tail short without paying a CAS
+        // for every index.
+        static size_t default_grain(size_t count, size_t threads)
+        {
+            return std::max<size_t>(1, count / (8 * threads));
+        }
+
+        // Runs body(i) for every i in [0, count) and returns once all calls
+        // have finished. grain is the number of indices claimed at a time,
+        // 0 for default_grain. The first exception thrown by a body is
+        // rethrown here after the loop completes.
+        void parallel_for(size_t count, const std::function<void(size_t)> &body, size_t grain = 0)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+            if (count == 1 || p_threads.empty() || inside_loop())
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    body(i);
+                }
+                return;
+            }
+            constexpr size_t segment = 0xffffffffu;
+            for (size_t offset = 0; offset < count; offset += segment)
+            {
+                parallel_segment(offset, std::min(segment, count - offset), grain, body);
+            }
+        }
+
+        // Sets up the pool returned by global(). Must be called before its
+        // first use; the ATMATH_THREADS environment variable provides the
+        // default thread count.
+        static void configure(const ThreadPoolOptions &options)
+        {
+            if (global_created().load())
+            {
+                throw std::runtime_error("ThreadPool::configure must be called before the global pool is first used.");
+            }
+            global_options() = options;
+        }
+
+        // Process-wide pool used by the parallel execution policies.
+        static ThreadPool &global()
+        {
+            static ThreadPool pool(claim_global_options());
+            return pool;
+        }
+
+        // CPUs this process may run on, grouped by NUMA node as listed in
+        // /sys/devices/system/node. Without that directory all CPUs form a
+        // single node.
+        static std::vector<std::vector<int>> numa_cpus()
+        {
+            std::vector<std::vector<int>> nodes;
+#ifdef __linux__
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            bool restricted = sched_getaffinity(0, sizeof(allowed), &allowed) == 0;
+            auto usable = [&](int cpu)
+            { return !restricted || (cpu < CPU_SETSIZE && CPU_ISSET(cpu, &allowed)); };
+
+            for (int node = 0;; node++)
+            {
+                std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+                if (!file)
+                {
+                    break;
+                }
+                std::string list;
+                std::getline(file, list);
+                std::vector<int> cpus;
+                // Comma-separated CPUs and first-last ranges, e.g. "0-3,8-11".
+                for (size_t pos = 0; pos < list.size();)
+                {
+                    size_t comma = std::min(list.find(',', pos), list.size());
+                    std::string item = list.substr(pos, comma - pos);
+                    size_t dash = item.find('-');
+                    if (!item.empty())
+                    {
+                        int first = std::stoi(item.substr(0, dash));
+                        int last = dash == std::string::npos ? first : std::stoi(item.substr(dash + 1));
+                        for (int cpu = first; cpu <= last; cpu++)
+                        {
+                            if (usable(cpu))
+                            {
+                                cpus.push_back(cpu);
+                            }
+                        }
+                    }
+                    pos = comma + 1;
+                }
+                if (!cpus.empty())
+                {
+                    nodes.push_back(std::move(cpus));
+                }
+            }
+            if (nodes.empty() && restricted)
+            {
+                nodes.emplace_back();
+                for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+                {
+                    if (CPU_ISSET(cpu, &allowed))
+                    {
+                        nodes.back().push_back(cpu);
+                    }
+                }
+            }
+#endif
+            if (nodes.empty())
+            {
+                nodes.emplace_back();
+                for (unsigned cpu = 0; cpu < std::thread::hardware_concurrency(); cpu++)
+                {
+                    nodes.back().push_back(int(cpu));
+                }
+            }
+            return nodes;
+        }
+
+        // Restricts thread to one CPU; a no-op where affinity is unsupported.
+        static void pin(std::thread &thread, int cpu)
+        {
+#ifdef __linux__
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpu, &set);
+            pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#else
+            (void)thread;
+            (void)cpu;
+#endif
+        }
+    };
+
+}
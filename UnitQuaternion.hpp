@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
+#include "Quaternion.hpp"
+
+namespace atMath
+{
+
+    // Rotation quaternion that is kept at unit length, so its inverse is
+    // just the conjugate and neither inversion, division nor rotation of a
+    // vector has to divide by the modulus.
+    //
+    // Products of unit quaternions drift away from unit length by a few ulps
+    // per composition. Each value counts the compositions that went into it
+    // since it was last renormalized. Once the count reaches
+    // renormalize_interval, one Newton step q *= (3 - |q|^2) / 2 pulls it
+    // back without a square root or a division.
+    //
+    // Operations that would break the invariant (adding, scaling, ...) are
+    // not available; convert to Quaternion<T> for general arithmetic.
+    template <class T = float>
+    class UnitQuaternion : public Quaternion<T>
+    {
+        static_assert(std::is_floating_point<T>::value, "UnitQuaternion type must be floating point");
+
+        unsigned q_drift;
+
+        UnitQuaternion(T real, T i, T j, T k, unsigned drift) : Quaternion<T>(real, i, j, k), q_drift(drift) {}
+
+    public:
+        static constexpr unsigned renormalize_interval = 8;
+
+        UnitQuaternion() : Quaternion<T>(1, 0, 0, 0), q_drift(0) {}
+
+        // Normalizes q, which must not be zero.
+        explicit UnitQuaternion(const Quaternion<T> &q) : Quaternion<T>(q), q_drift(0)
+        {
+            T norm = static_cast<T>(q.modulus());
+            if (norm == 0)
+            {
+                throw std::runtime_error("Cannot normalize a zero quaternion.");
+            }
+            Quaternion<T>::operator/=(norm);
+        }
+
+        // Trusts the caller that the components already have unit length.
+        static UnitQuaternion<T> assume_unit(T real, T i, T j, T k)
+        {
+            return UnitQuaternion<T>(real, i, j, k, 0);
+        }
+
+        // Rotation by angle radians around (x, y, z), which need not be
+        // normalized.
+        static UnitQuaternion<T> from_axis_angle(T x, T y, T z, double angle)
+        {
+            double norm = sqrt(static_cast<double>(x) * x + static_cast<double>(y) * y + static_cast<double>(z) * z);
+            if (norm == 0)
+            {
+                throw std::runtime_error("Rotation axis must not be zero.");
+            }
+            double s = sin(angle / 2) / norm;
+            return UnitQuaternion<T>(static_cast<T>(cos(angle / 2)), static_cast<T>(s * x), static_cast<T>(s * y), static_cast<T>(s * z), 0);
+        }
+
+        unsigned drift() const { return q_drift; }
+
+        UnitQuaternion<T> &renormalize()
+        {
+            T factor = (3 - this->modulus_squared()) / 2;
+            Quaternion<T>::operator*=(factor);
+            q_drift = 0;
+            return *this;
+        }
+
+        UnitQuaternion<T> conjugate() const
+        {
+            return UnitQuaternion<T>(this->real, -this->i, -this->j, -this->k, q_drift);
+        }
+
+        UnitQuaternion<T> inverse() const { return conjugate(); }
+
+        UnitQuaternion<T> operator-() const
+        {
+            return UnitQuaternion<T>(-this->real, -this->i, -this->j, -this->k, q_drift);
+        }
+
+        UnitQuaternion<T> &operator*=(const UnitQuaternion<T> &q)
+        {
+            Quaternion<T>::operator*=(q);
+            q_drift += q.q_drift + 1;
+            if (q_drift >= renormalize_interval)
+            {
+                renormalize();
+            }
+            return *this;
+        }
+
+        UnitQuaternion<T> &operator/=(const UnitQuaternion<T> &q)
+        {
+            return *this *= q.conjugate();
+        }
+
+        template <class U>
+        UnitQuaternion<T> &operator+=(const U &value) = delete;
+        template <class U>
+        UnitQuaternion<T> &operator-=(const U &value) = delete;
+    };
+
+    template <class T>
+    UnitQuaternion<T> operator*(UnitQuaternion<T> q1, const UnitQuaternion<T> &q2)
+    {
+        q1 *= q2;
+        return q1;
+    }
+
+    template <class T>
+    UnitQuaternion<T> operator/(UnitQuaternion<T> q1, const UnitQuaternion<T> &q2)
+    {
+        q1 /= q2;
+        return q1;
+    }
+
+}
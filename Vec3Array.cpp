@@ -0,0 +1,213 @@
+#pragma once
+
+#include "Vec3Array.hpp"
+#include "Simd.hpp"
+
+namespace atMath
+{
+
+    template <class T>
+    Vec3Array<T>::Vec3Array() : p_x(), p_y(), p_z() {}
+
+    template <class T>
+    Vec3Array<T>::Vec3Array(size_t size) : p_x(size), p_y(size), p_z(size) {}
+
+    template <class T>
+    Vec3Array<T>::Vec3Array(size_t size, uninitialized_t) : p_x(size, uninitialized), p_y(size, uninitialized), p_z(size, uninitialized) {}
+
+    template <class T>
+    Vec3Array<T>::Vec3Array(Vector<T> x, Vector<T> y, Vector<T> z) : p_x(std::move(x)), p_y(std::move(y)), p_z(std::move(z))
+    {
+        if (p_y.size() != p_x.size() || p_z.size() != p_x.size())
+        {
+            throw std::runtime_error("Point lanes must be the same size.");
+        }
+    }
+
+    template <class T>
+    Vec3Array<T>::Vec3Array(const Vec3<T> *points, size_t size) : Vec3Array(size, uninitialized)
+    {
+        T *x = p_x.data();
+        T *y = p_y.data();
+        T *z = p_z.data();
+        for (size_t n = 0; n < size; n++)
+        {
+            x[n] = points[n].x;
+            y[n] = points[n].y;
+            z[n] = points[n].z;
+        }
+    }
+
+    template <class T>
+    Vec3Array<T>::Vec3Array(const std::vector<Vec3<T>> &points) : Vec3Array(points.data(), points.size()) {}
+
+    template <class T>
+    void Vec3Array<T>::set(size_t index, const Vec3<T> &value)
+    {
+        p_x[index] = value.x;
+        p_y[index] = value.y;
+        p_z[index] = value.z;
+    }
+
+    template <class T>
+    void Vec3Array<T>::push_back(const Vec3<T> &value)
+    {
+        p_x.push_back(value.x);
+        p_y.push_back(value.y);
+        p_z.push_back(value.z);
+    }
+
+    template <class T>
+    void Vec3Array<T>::reserve(size_t capacity)
+    {
+        p_x.reserve(capacity);
+        p_y.reserve(capacity);
+        p_z.reserve(capacity);
+    }
+
+    template <class T>
+    void Vec3Array<T>::clear()
+    {
+        p_x.clear();
+        p_y.clear();
+        p_z.clear();
+    }
+
+    template <class T>
+    std::vector<Vec3<T>> Vec3Array<T>::toVector() const
+    {
+        std::vector<Vec3<T>> result(size());
+        for (size_t n = 0; n < size(); n++)
+        {
+            result[n] = Vec3<T>(p_x.at_unchecked(n), p_y.at_unchecked(n), p_z.at_unchecked(n));
+        }
+        return result;
+    }
+
+    template <class T>
+    std::array<T, 9> rotation_matrix(const Quaternion<T> &q)
+    {
+        static_assert(std::is_floating_point<T>::value, "Rotation requires a floating point quaternion");
+        T s = 2 / q.modulus_squared();
+        T xx = q.i * q.i, yy = q.j * q.j, zz = q.k * q.k;
+        T xy = q.i * q.j, xz = q.i * q.k, yz = q.j * q.k;
+        T wx = q.real * q.i, wy = q.real * q.j, wz = q.real * q.k;
+        return {1 - s * (yy + zz), s * (xy - wz), s * (xz + wy),
+                s * (xy + wz), 1 - s * (xx + zz), s * (yz - wx),
+                s * (xz - wy), s * (yz + wx), 1 - s * (xx + yy)};
+    }
+
+    template <class T>
+    void rotate(const Quaternion<T> &q, const Vec3Array<T> &points, Vec3Array<T> &out)
+    {
+        rotate(execution::seq, q, points, out);
+    }
+
+    template <class Policy, class T>
+    auto rotate(const Policy &policy, const Quaternion<T> &q, const Vec3Array<T> &points, Vec3Array<T> &out) -> std::enable_if_t<execution::is_execution_policy<Policy>::value>
+    {
+        std::array<T, 9> m = rotation_matrix(q);
+        if (&out != &points && out.size() != points.size())
+        {
+            out = Vec3Array<T>(points.size(), uninitialized);
+        }
+        const T *px = points.x().data();
+        const T *py = points.y().data();
+        const T *pz = points.z().data();
+        T *ox = out.x().data();
+        T *oy = out.y().data();
+        T *oz = out.z().data();
+        execution::for_each_block(policy, points.size(), execution::elementwise_block, [&](size_t begin, size_t end)
+                                  { simd::transform3(m.data(), px + begin, py + begin, pz + begin, ox + begin, oy + begin, oz + begin, end - begin); });
+    }
+
+    template <class T>
+    Vec3Array<T> rotate(const Quaternion<T> &q, const Vec3Array<T> &points)
+    {
+        Vec3Array<T> out(points.size(), uninitialized);
+        rotate(q, points, out);
+        return out;
+    }
+
+    template <class Policy, class T>
+    auto rotate(const Policy &policy, const Quaternion<T> &q, const Vec3Array<T> &points) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vec3Array<T>>
+    {
+        Vec3Array<T> out(points.size(), uninitialized);
+        rotate(policy, q, points, out);
+        return out;
+    }
+
+    template <class T>
+    void rotate(const QuaternionArray<T> &q, const Vec3Array<T> &points, Vec3Array<T> &out)
+    {
+        rotate(execution::seq, q, points, out);
+    }
+
+    template <class Policy, class T>
+    auto rotate(const Policy &policy, const QuaternionArray<T> &q, const Vec3Array<T> &points, Vec3Array<T> &out) -> std::enable_if_t<execution::is_execution_policy<Policy>::value>
+    {
+        static_assert(std::is_floating_point<T>::value, "Rotation requires a floating point quaternion");
+        if (q.size() != points.size())
+        {
+            throw std::runtime_error("Need one quaternion per point.");
+        }
+        if (&out != &points && out.size() != points.size())
+        {
+            out = Vec3Array<T>(points.size(), uninitialized);
+        }
+        const T *qw = q.real().data();
+        const T *qx = q.i().data();
+        const T *qy = q.j().data();
+        const T *qz = q.k().data();
+        const T *px = points.x().data();
+        const T *py = points.y().data();
+        const T *pz = points.z().data();
+        T *ox = out.x().data();
+        T *oy = out.y().data();
+        T *oz = out.z().data();
+        execution::for_each_block(policy, points.size(), execution::elementwise_block, [&](size_t begin, size_t end)
+                                  {
+            for (size_t n = begin; n < end; n++)
+            {
+                T w = qw[n], ux = qx[n], uy = qy[n], uz = qz[n];
+                T vx = px[n], vy = py[n], vz = pz[n];
+                T s = 2 / (w * w + ux * ux + uy * uy + uz * uz);
+                T tx = s * (uy * vz - uz * vy);
+                T ty = s * (uz * vx - ux * vz);
+                T tz = s * (ux * vy - uy * vx);
+                ox[n] = vx + w * tx + (uy * tz - uz * ty);
+                oy[n] = vy + w * ty + (uz * tx - ux * tz);
+                oz[n] = vz + w * tz + (ux * ty - uy * tx);
+            } });
+    }
+
+    template <class T>
+    Vec3Array<T> rotate(const QuaternionArray<T> &q, const Vec3Array<T> &points)
+    {
+        Vec3Array<T> out(points.size(), uninitialized);
+        rotate(q, points, out);
+        return out;
+    }
+
+    template <class Policy, class T>
+    auto rotate(const Policy &policy, const QuaternionArray<T> &q, const Vec3Array<T> &points) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vec3Array<T>>
+    {
+        Vec3Array<T> out(points.size(), uninitialized);
+        rotate(policy, q, points, out);
+        return out;
+    }
+
+    template <class T>
+    void rotate(const Quaternion<T> &q, const Vec3<T> *points, Vec3<T> *out, size_t size)
+    {
+        std::array<T, 9> m = rotation_matrix(q);
+        for (size_t n = 0; n < size; n++)
+        {
+            T vx = points[n].x, vy = points[n].y, vz = points[n].z;
+            out[n].x = m[0] * vx + m[1] * vy + m[2] * vz;
+            out[n].y = m[3] * vx + m[4] * vy + m[5] * vz;
+            out[n].z = m[6] * vx + m[7] * vy + m[8] * vz;
+        }
+    }
+
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <array>
+#include <type_traits>
+#include <vector>
+#include "Vector.hpp"
+#include "Vectors_d.hpp"
+#include "Quaternion.hpp"
+#include "QuaternionArray.hpp"
+
+namespace atMath
+{
+
+    // Structure-of-arrays point cloud: x, y and z each in their own
+    // contiguous Vector<T> lane. This is the layout the batch rotations below
+    // vectorize over.
+    template <class T = float>
+    class Vec3Array
+    {
+        static_assert(std::is_arithmetic<T>::value, "Vec3Array type must be arithmetic");
+
+    protected:
+        Vector<T> p_x;
+        Vector<T> p_y;
+        Vector<T> p_z;
+
+    public:
+        using value_type = Vec3<T>;
+
+        Vec3Array();
+        Vec3Array(size_t size);
+        Vec3Array(size_t size, uninitialized_t);
+        Vec3Array(Vector<T> x, Vector<T> y, Vector<T> z);
+        Vec3Array(const Vec3<T> *points, size_t size);
+        Vec3Array(const std::vector<Vec3<T>> &points);
+
+        size_t size() const { return p_x.size(); }
+        Vector<T> &x() { return p_x; }
+        const Vector<T> &x() const { return p_x; }
+        Vector<T> &y() { return p_y; }
+        const Vector<T> &y() const { return p_y; }
+        Vector<T> &z() { return p_z; }
+        const Vector<T> &z() const { return p_z; }
+
+        Vec3<T> operator[](size_t index) const { return Vec3<T>(p_x[index], p_y[index], p_z[index]); }
+        void set(size_t index, const Vec3<T> &value);
+        void push_back(const Vec3<T> &value);
+        void reserve(size_t capacity);
+        void clear();
+
+        // Back to the interleaved layout.
+        std::vector<Vec3<T>> toVector() const;
+    };
+
+    // Row-major matrix of the rotation v -> q v q^-1. q does not have to be
+    // normalized; the matrix is scaled by 1/|q|^2.
+    template <class T>
+    std::array<T, 9> rotation_matrix(const Quaternion<T> &q);
+
+    // Rotates every point by q. The quaternion is turned into a rotation
+    // matrix once, so each point costs nine multiply-adds and no division.
+    // out may be points itself.
+    template <class T>
+    void rotate(const Quaternion<T> &q, const Vec3Array<T> &points, Vec3Array<T> &out);
+    template <class T>
+    Vec3Array<T> rotate(const Quaternion<T> &q, const Vec3Array<T> &points);
+
+    // Rotates points[n] by q[n], using v + w t + u x t with t = 2 (u x v) / |q|^2.
+    template <class T>
+    void rotate(const QuaternionArray<T> &q, const Vec3Array<T> &points, Vec3Array<T> &out);
+    template <class T>
+    Vec3Array<T> rotate(const QuaternionArray<T> &q, const Vec3Array<T> &points);
+
+    // Policy forms of the two batch rotations above; par and par_unseq split
+    // large arrays across ThreadPool::global().
+    template <class Policy, class T>
+    auto rotate(const Policy &policy, const Quaternion<T> &q, const Vec3Array<T> &points, Vec3Array<T> &out) -> std::enable_if_t<execution::is_execution_policy<Policy>::value>;
+    template <class Policy, class T>
+    auto rotate(const Policy &policy, const Quaternion<T> &q, const Vec3Array<T> &points) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vec3Array<T>>;
+    template <class Policy, class T>
+    auto rotate(const Policy &policy, const QuaternionArray<T> &q, const Vec3Array<T> &points, Vec3Array<T> &out) -> std::enable_if_t<execution::is_execution_policy<Policy>::value>;
+    template <class Policy, class T>
+    auto rotate(const Policy &policy, const QuaternionArray<T> &q, const Vec3Array<T> &points) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vec3Array<T>>;
+
+    // Interleaved input, for callers that keep Vec3 arrays. out may be points.
+    template <class T>
+    void rotate(const Quaternion<T> &q, const Vec3<T> *points, Vec3<T> *out, size_t size);
+
+}
+
+// Definitions; see the end of Vector.hpp for ATMATH_EXTERN_TEMPLATES.
+#include "Vec3Array.cpp"
+
+#define ATMATH_VEC3_ARRAY_INSTANCES(PREFIX, T)                               \
+    PREFIX class Vec3Array<T>;                                               \
+    PREFIX void rotate(const Quaternion<T> &, const Vec3Array<T> &,          \
+        Vec3Array<T> &);                                                     \
+    PREFIX Vec3Array<T> rotate(const Quaternion<T> &, const Vec3Array<T> &); \
+    PREFIX void rotate(const QuaternionArray<T> &, const Vec3Array<T> &,     \
+        Vec3Array<T> &);
+
+#if ATMATH_EXTERN_TEMPLATES
+namespace atMath
+{
+    ATMATH_VEC3_ARRAY_INSTANCES(extern template, float)
+    ATMATH_VEC3_ARRAY_INSTANCES(extern template, double)
+}
+#endif
@@ -1,8 +1,14 @@
+#pragma once
+
 #include "Vector.hpp"
 #include "Complex.hpp"
 #include "Quaternion.hpp"
+#include "Simd.hpp"
+#include "Diagnostics.hpp"
+#include "VectorView.hpp"
+#include <algorithm>
 #include <cmath>
-#include <map>
+#include <cstring>
 
 namespace atMath
 {
@@ -10,31 +16,6 @@ namespace atMath
     const double E = 2.71828182845904523536;
 
 
-    std::map<std::string, std::string> type_map = {
-    {"c", "char"},
-    {"i", "int"},
-    {"f", "float"},
-    {"d", "double"},
-    {"j", "uint32_t"},
-    {"y", "uint64_t"},
-    {"i", "int32_t"},
-    {"x", "int64_t"},
-    {"h", "uint8_t"},
-    {"a", "int8_t"},
-    {"t", "uint16_t"},
-    {"s", "int16_t"},
-    {"N6atMath7ComplexIiEE", "complex int"},
-    {"N6atMath7ComplexIfEE", "complex float"},
-    {"N6atMath7ComplexIdEE", "complex double"},
-    {"N6atMath7ComplexIjEE", "complex uint32_t"},
-    {"N6atMath7ComplexIyEE", "complex uint64_t"},
-    {"N6atMath7ComplexIiEE", "complex int32_t"},
-    {"N6atMath7ComplexIxEE", "complex int64_t"},
-    {"N6atMath7ComplexIhEE", "complex uint8_t"},
-    {"N6atMath7ComplexIaEE", "complex int8_t"},
-    {"N6atMath7ComplexItEE", "complex uint16_t"},
-    {"N6atMath7ComplexIsEE", "complex int16_t"}};
-
     template<typename T>
     inline void assert_is_arithmetic() {
         static_assert(std::is_arithmetic<T>::value || 
@@ -62,12 +43,31 @@ namespace atMath
             std::is_base_of<Quaternion<int16_t>, T>::value, "Vector type must be arithmetic or Complex or Quaternion");
     }
 
+    // Bulk copy into a buffer that does not overlap the source. Arithmetic,
+    // Complex and Quaternion elements are trivially copyable, so copies from
+    // a plain pointer go through memcpy.
+    template <class T, class It>
+    inline void copy_elements(T *out, It in, size_t n)
+    {
+        if constexpr (std::is_trivially_copyable<T>::value && std::is_convertible<It, const T *>::value)
+        {
+            if (n != 0)
+            {
+                std::memcpy(out, static_cast<const T *>(in), n * sizeof(T));
+            }
+        }
+        else
+        {
+            std::copy_n(in, n, out);
+        }
+    }
+
     template <class T>
     Vector<T>::Vector()
     {
 
         assert_is_arithmetic<T>();
-        v_data(nullptr);
+        v_data = nullptr;
         v_size = 0;
     }
 
@@ -76,12 +76,7 @@ namespace atMath
     {
 
         assert_is_arithmetic<T>();
-        try{
-            v_data = std::make_unique<T[]>(size);
-        }catch(const std::bad_alloc& e){
-            std::cerr << "Error: " << e.what() << std::endl;
-        }
-
+        v_data = make_buffer<T>(size, get_default_resource());
         v_size = size;
     }
 
@@ -90,13 +85,7 @@ namespace atMath
     {
 
         assert_is_arithmetic<T>();
-
-        try{
-        v_data = std::make_unique<T[]>(size);
-        }catch(const std::bad_alloc& e){
-            std::cerr << "Error: " << e.what() << std::endl;
-        }
-
+        v_data = make_buffer<T>(size, get_default_resource(), false);
         v_size = size;
         for (size_t i = 0; i < v_size; i++)
         {
@@ -105,42 +94,46 @@ namespace atMath
     }
 
     template <class T>
-    Vector<T>::Vector(const Vector<T> &v)
+    Vector<T>::Vector(size_t size, uninitialized_t, std::pmr::memory_resource *resource)
     {
-        v_size = v.size();
-
-        try{
-        v_data = std::make_unique<T[]>(v_size);
-        }catch(const std::bad_alloc& e){
-            std::cerr << "Error: " << e.what() << std::endl;
-        }
-
 
-        for (size_t i = 0; i < v_size; i++)
-        {
-            v_data[i] = v[i];
-        }
+        assert_is_arithmetic<T>();
+        v_data = make_buffer<T>(size, resource, false);
+        v_size = size;
     }
 
     template <class T>
-    Vector<T>::Vector(const std::vector<T> &v)
+    Vector<T>::Vector(size_t size, T value, std::pmr::memory_resource *resource)
     {
 
         assert_is_arithmetic<T>();
+        v_data = make_buffer<T>(size, resource, false);
+        v_size = size;
+        std::fill_n(v_data.get(), v_size, value);
+    }
+
+    template <class T>
+    Vector<T>::Vector(const Vector<T> &v)
+    {
         v_size = v.size();
+        v_data = make_buffer<T>(v_size, get_default_resource(), false);
+        copy_elements(v_data.get(), v.data(), v_size);
+    }
 
-        try{
-        v_data = std::make_unique<T[]>(v_size);
-        }catch(const std::bad_alloc& e){
-            std::cerr << "Error: " << e.what() << std::endl;
-        }
+    template <class T>
+    Vector<T>::Vector(Vector<T> &&v) noexcept : v_data(std::move(v.v_data)), v_size(v.v_size)
+    {
+        v.v_size = 0;
+    }
 
-  
-        for (size_t i = 0; i < v_size; i++)
-        {
-            v_data[i] = v[i];
-        }
+    template <class T>
+    Vector<T>::Vector(const std::vector<T> &v)
+    {
 
+        assert_is_arithmetic<T>();
+        v_size = v.size();
+        v_data = make_buffer<T>(v_size, get_default_resource(), false);
+        copy_elements(v_data.get(), v.begin(), v_size);
     }
 
     template <class T>
@@ -149,16 +142,10 @@ namespace atMath
     {
         static_assert(std::is_arithmetic<T>::value);
         v_size = v.size();
-
-        try{
-            v_data = std::make_unique<T[]>(v_size);
-        }catch(const std::bad_alloc& e){
-            std::cerr << "Error: " << e.what() << std::endl;
-        }
-
+        v_data = make_buffer<T>(v_size, get_default_resource(), false);
         for (size_t i = 0; i < v_size; i++)
         {
-            v_data[i] = static_cast<T>(v[i]);
+            v_data[i] = static_cast<T>(v.at_unchecked(i));
         }
     }
 
@@ -168,41 +155,66 @@ namespace atMath
 
         assert_is_arithmetic<T>();
         v_size = list.size();
+        v_data = make_buffer<T>(v_size, get_default_resource(), false);
+        copy_elements(v_data.get(), list.begin(), v_size);
+    }
 
-        try{
-        v_data = std::make_unique<T[]>(v_size);
-        }catch(const std::bad_alloc& e){
-            std::cerr << "Error: " << e.what() << std::endl;
-        }
+    template <class T>
+    Vector<T>::Vector(std::unique_ptr<T[]> data, size_t size)
+    {
 
-        size_t i = 0;
-        for (auto it = list.begin(); it != list.end(); it++)
-        {
-            v_data[i] = *it;
-            i++;
-        }
+        assert_is_arithmetic<T>();
+        v_size = size;
+        v_data = Buffer<T>(data.release(), BufferDeleter<T>());
     }
 
     template <class T>
-    Vector<T>::Vector(std::unique_ptr<T[]> data, size_t size)
+    Vector<T>::Vector(Buffer<T> buffer, size_t size) : v_data(std::move(buffer)), v_size(size)
     {
+        assert_is_arithmetic<T>();
+    }
 
+    template <class T>
+    template <class Deleter, class>
+    Vector<T>::Vector(T *data, size_t size, Deleter deleter)
+    {
         assert_is_arithmetic<T>();
         v_size = size;
-        v_data.swap(data);
+        // If the control block cannot be allocated, shared_ptr runs the
+        // deleter before rethrowing, so data is not leaked.
+        std::shared_ptr<void> owner(data, [deleter](void *p) mutable { deleter(static_cast<T *>(p)); });
+        v_data = Buffer<T>(data, BufferDeleter<T>{nullptr, size, true, std::move(owner)});
     }
 
     template <class T>
-    Vector<T>::Vector(const Complex<T> &c)
+    Vector<T>::Vector(T *data, size_t size, borrowed_t)
     {
-        v_size = 2;
+        assert_is_arithmetic<T>();
+        v_size = size;
+        v_data = Buffer<T>(data, BufferDeleter<T>{nullptr, size, true, nullptr});
+    }
 
-        try{
-        v_data = std::make_unique<T[]>(v_size);
-        }catch(const std::bad_alloc& e){
-            std::cerr << "Error: " << e.what() << std::endl;
+    template <class T>
+    template <class E>
+    Vector<T>::Vector(const VectorExpression<E> &e)
+    {
+
+        assert_is_arithmetic<T>();
+        const E &expr = e.self();
+        v_data = make_buffer<T>(expr.size(), get_default_resource(), false);
+        v_size = expr.size();
+
+        for (size_t i = 0; i < v_size; i++)
+        {
+            v_data[i] = static_cast<T>(expr.at_unchecked(i));
         }
+    }
 
+    template <class T>
+    Vector<T>::Vector(const Complex<T> &c)
+    {
+        v_size = 2;
+        v_data = make_buffer<T>(v_size, get_default_resource(), false);
         v_data[0] = c.real;
         v_data[1] = c.imag;
     }
@@ -217,6 +229,20 @@ namespace atMath
         }
     }
 
+    template <class T>
+    std::pmr::memory_resource *Vector<T>::resource() const
+    {
+        std::pmr::memory_resource *resource = v_data.get_deleter().resource;
+        return resource != nullptr ? resource : get_default_resource();
+    }
+
+    template <class T>
+    Buffer<T> Vector<T>::release()
+    {
+        v_size = 0;
+        return std::move(v_data);
+    }
+
     template <class T>
     size_t Vector<T>::size() const
     {
@@ -226,12 +252,7 @@ namespace atMath
     template <class T>
     Vector<T> Vector<T>::repeat(size_t size, T value)
     {
-        Vector<T> result(size);
-        for (size_t i = 0; i < size; i++)
-        {
-            result[i] = value;
-        }
-        return result;
+        return Vector<T>(size, value);
     }
 
     template <class T>
@@ -243,92 +264,157 @@ namespace atMath
     }
 
     template <class T>
-    T &Vector<T>::operator[](size_t index)
+    Vector<T> &Vector<T>::operator=(const Vector<T> &v)
+    {   
+        if(this != &v){
+            if (capacity() < v.size())
+            {
+                // Allocate before releasing, so a throw leaves *this intact.
+                Buffer<T> data = make_buffer<T>(v.size(), resource(), false);
+                v_data = std::move(data);
+            }
+            v_size = v.size();
+            copy_elements(v_data.get(), v.data(), v_size);
+        }
+        return *this;
+    }
+
+    template <class T>
+    Vector<T> &Vector<T>::operator=(Vector<T> &&v) noexcept
     {
-        if (index >= v_size)
+        if (this != &v)
         {
-            throw std::out_of_range("Index out of bounds.");
+            v_data = std::move(v.v_data);
+            v_size = v.v_size;
+            v.v_size = 0;
         }
-        return v_data[index];
+        return *this;
     }
 
     template <class T>
-    const T &Vector<T>::operator[](size_t index) const
+    template <class U>
+    Vector<T> &Vector<T>::operator=(const Vector<U> &v)
     {
-        if (index >= v_size)
+        diagnostics::note_conversion<U, T>();
+        if (capacity() < v.size())
         {
-            throw std::out_of_range("Index out of bounds.");
+            Buffer<T> data = make_buffer<T>(v.size(), resource(), false);
+            v_data = std::move(data);
         }
-        return v_data[index];
+        v_size = v.size();
+        for (size_t i = 0; i < v_size; i++)
+        {
+            v_data[i] = static_cast<T>(v.at_unchecked(i));
+        }
+        return *this;
     }
 
     template <class T>
-    Vector<T> &Vector<T>::operator=(const Vector<T> &v)
-    {   
-        if(this != &v){
-            v_data.reset();
-            v_size = v.size();
-            v_data = std::make_unique<T[]>(v_size);
+    template <class E>
+    Vector<T> &Vector<T>::operator=(const VectorExpression<E> &e)
+    {
+        const E &expr = e.self();
+        if (v_size == expr.size())
+        {
+            // Every node is elementwise, so evaluating front to back in place
+            // is safe when this vector is an operand. Views into this buffer
+            // from view(), slice() or the raw constructor start at or after
+            // data() with a positive stride, so element i never reads an
+            // element below i that was already overwritten.
             for (size_t i = 0; i < v_size; i++)
             {
-                v_data[i] = v[i];
+                v_data[i] = static_cast<T>(expr.at_unchecked(i));
             }
         }
+        else if (capacity() >= expr.size())
+        {
+            // As above: views into this buffer start at or after data() and
+            // step forwards, so in-place evaluation stays safe. A view that
+            // starts below data() can only come from a buffer borrowed out of
+            // a larger one; assign through eval() in that case.
+            v_size = expr.size();
+            for (size_t i = 0; i < v_size; i++)
+            {
+                v_data[i] = static_cast<T>(expr.at_unchecked(i));
+            }
+        }
+        else
+        {
+            *this = Vector<T>(e);
+        }
         return *this;
     }
 
     template <class T>
     template <class U>
-    Vector<T> &Vector<T>::operator=(const Vector<U> &v)
+    Vector<T> &Vector<T>::operator+=(const Vector<U> &v)
     {
-        if (typeid(T) != typeid(U))
+        if (v_size != v.size())
         {
-            std::cout << "Warning: Type mismatch. Converting " << (type_map.find(typeid(U).name()) != type_map.end() ? type_map[typeid(U).name()] : typeid(U).name()) << " to " << (type_map.find(typeid(T).name()) != type_map.end() ? type_map[typeid(T).name()] : typeid(T).name()) << std::endl;
+            throw std::runtime_error("Vectors must be the same size to add.");
+        }
+        diagnostics::note_conversion<U, T>();
+        if constexpr (std::is_same<T, U>::value)
+        {
+            simd::add(v_data.get(), v.begin(), v_size);
+            return *this;
         }
-        v_data.reset();
-        v_size = v.size();
-        v_data = std::make_unique<T[]>(v_size);
         for (size_t i = 0; i < v_size; i++)
         {
-            v_data[i] = static_cast<T>(v[i]);
+            v_data[i] += static_cast<T>(v.at_unchecked(i));
         }
         return *this;
     }
 
     template <class T>
     template <class U>
-    Vector<T> &Vector<T>::operator+=(const Vector<U> &v)
+    Vector<T> &Vector<T>::operator-=(const Vector<U> &v)
     {
         if (v_size != v.size())
         {
-            throw std::runtime_error("Vectors must be the same size to add.");
+            throw std::runtime_error("Vectors must be the same size to subtract.");
         }
-        if (typeid(T) != typeid(U))
+        diagnostics::note_conversion<U, T>();
+        if constexpr (std::is_same<T, U>::value)
         {
-            std::cout << "Warning: Type mismatch. Converting " << (type_map.find(typeid(U).name()) != type_map.end() ? type_map[typeid(U).name()] : typeid(U).name()) << " to " << (type_map.find(typeid(T).name()) != type_map.end() ? type_map[typeid(T).name()] : typeid(T).name()) << std::endl;
+            simd::sub(v_data.get(), v.begin(), v_size);
+            return *this;
         }
         for (size_t i = 0; i < v_size; i++)
         {
-            v_data[i] += static_cast<T>(v[i]);
+            v_data[i] -= static_cast<T>(v.at_unchecked(i));
         }
         return *this;
     }
 
     template <class T>
-    template <class U>
-    Vector<T> &Vector<T>::operator-=(const Vector<U> &v)
+    template <class E>
+    Vector<T> &Vector<T>::operator+=(const VectorExpression<E> &e)
     {
-        if (v_size != v.size())
+        const E &expr = e.self();
+        if (v_size != expr.size())
         {
-            throw std::runtime_error("Vectors must be the same size to subtract.");
+            throw std::runtime_error("Vectors must be the same size to add.");
         }
-        if (typeid(T) != typeid(U))
+        for (size_t i = 0; i < v_size; i++)
+        {
+            v_data[i] += static_cast<T>(expr.at_unchecked(i));
+        }
+        return *this;
+    }
+
+    template <class T>
+    template <class E>
+    Vector<T> &Vector<T>::operator-=(const VectorExpression<E> &e)
+    {
+        const E &expr = e.self();
+        if (v_size != expr.size())
         {
-            std::cout << "Warning: Type mismatch. Converting " << (type_map.find(typeid(U).name()) != type_map.end() ? type_map[typeid(U).name()] : typeid(U).name()) << " to " << (type_map.find(typeid(T).name()) != type_map.end() ? type_map[typeid(T).name()] : typeid(T).name()) << std::endl;
+            throw std::runtime_error("Vectors must be the same size to subtract.");
         }
         for (size_t i = 0; i < v_size; i++)
         {
-            v_data[i] -= static_cast<T>(v[i]);
+            v_data[i] -= static_cast<T>(expr.at_unchecked(i));
         }
         return *this;
     }
@@ -341,13 +427,21 @@ namespace atMath
         {
             throw std::runtime_error("Vectors must be the same size to multiply.");
         }
-        if (typeid(T) != typeid(decltype(v[0] * v_data[0])))
+        diagnostics::note_conversion<decltype(v[0] * v_data[0]), T>();
+        if constexpr (std::is_same<T, U>::value && (std::is_same<T, Complex<float>>::value || std::is_same<T, Complex<double>>::value))
+        {
+            using lane = decltype(T::real);
+            simd::complex_mul(reinterpret_cast<lane *>(v_data.get()), reinterpret_cast<const lane *>(v_data.get()), reinterpret_cast<const lane *>(v.begin()), v_size);
+            return *this;
+        }
+        if constexpr (std::is_same<T, U>::value)
         {
-            std::cout << "Warning: Type mismatch. Converting " << (type_map.find(typeid(decltype(v[0] * v_data[0])).name()) != type_map.end() ? type_map[typeid(decltype(v[0] * v_data[0])).name()] : typeid(decltype(v[0] * v_data[0])).name()) << " to " << (type_map.find(typeid(T).name()) != type_map.end() ? type_map[typeid(T).name()] : typeid(T).name()) << std::endl;
+            simd::mul(v_data.get(), v.begin(), v_size);
+            return *this;
         }
         for (size_t i = 0; i < v_size; i++)
         {
-            v_data[i] *= static_cast<T>(v[i]);
+            v_data[i] *= static_cast<T>(v.at_unchecked(i));
         }
         return *this;
     }
@@ -356,9 +450,11 @@ namespace atMath
     template <class U>
     Vector<T> &Vector<T>::operator*=(const U &value)
     {
-        if (typeid(T) != typeid(decltype(value * v_data[0])))
+        diagnostics::note_conversion<decltype(value * v_data[0]), T>();
+        if constexpr (std::is_same<T, U>::value)
         {
-            std::cout << "Warning: Type mismatch. Converting " << (type_map.find(typeid(decltype(value * v_data[0])).name()) != type_map.end() ? type_map[typeid(decltype(value * v_data[0])).name()] : typeid(decltype(value * v_data[0])).name()) << " to " << (type_map.find(typeid(T).name()) != type_map.end() ? type_map[typeid(T).name()] : typeid(T).name()) << std::endl;
+            simd::scale(v_data.get(), value, v_size);
+            return *this;
         }
         for (size_t i = 0; i < v_size; i++)
         {
@@ -371,10 +467,7 @@ namespace atMath
     template <class U>
     Vector<T> &Vector<T>::operator/=(const U &value)
     {
-        if (typeid(T) != typeid(decltype(v_data[0] / value)))
-        {
-            std::cout << "Warning: Type mismatch. Converting " << (type_map.find(typeid(decltype(v_data[0] / value)).name()) != type_map.end() ? type_map[typeid(decltype(v_data[0] / value)).name()] : typeid(decltype(v_data[0] / value)).name()) << " to " << (type_map.find(typeid(T).name()) != type_map.end() ? type_map[typeid(T).name()] : typeid(T).name()) << std::endl;
-        }
+        diagnostics::note_conversion<decltype(v_data[0] / value), T>();
         for (size_t i = 0; i < v_size; i++)
         {
             v_data[i] /= value;
@@ -395,7 +488,7 @@ namespace atMath
 
         for (size_t i = 0; i < v_size; i++)
         {
-            if (abs(v_data[i] - v[i]) > epsilon)
+            if (abs(v_data[i] - v.at_unchecked(i)) > epsilon)
             {
                 return false;
             }
@@ -411,18 +504,69 @@ namespace atMath
     }
 
 
+    // Pairwise dot product for differing element types, split into the
+    // same blocks as simd::sum_pairwise.
+    template <class T, class U>
+    auto dot_pairwise(const T *a, const U *b, size_t n) -> decltype(a[0] * b[0])
+    {
+        if (n > simd::pairwise_block)
+        {
+            size_t half = (n / 2 + simd::pairwise_block - 1) / simd::pairwise_block * simd::pairwise_block;
+            return dot_pairwise(a, b, half) + dot_pairwise(a + half, b + half, n - half);
+        }
+        decltype(a[0] * b[0]) result = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            result += a[i] * b[i];
+        }
+        return result;
+    }
+
+    // Sum of a[i], or of a[i] * b[i] when b is non-null, in the given mode.
+    template <class T>
+    T sum_terms(const T *a, const T *b, size_t n, Summation mode)
+    {
+        if (mode == Summation::pairwise)
+        {
+            return simd::sum_pairwise(a, b, n);
+        }
+        if constexpr (std::is_floating_point<T>::value)
+        {
+            switch (mode)
+            {
+            case Summation::kahan:
+                return simd::sum_compensated<false>(a, b, n);
+            case Summation::neumaier:
+                return simd::sum_compensated<true>(a, b, n);
+            case Summation::widened:
+                return static_cast<T>(simd::sum_widened(a, b, n));
+            default:
+                break;
+            }
+        }
+        return b ? simd::dot(a, b, n) : simd::sum(a, n);
+    }
+
     template <class T>
     template <class U>
-    auto Vector<T>::dot(const Vector<U> &v) const -> decltype(v_data[0] * v[0])
+    auto Vector<T>::dot(const Vector<U> &v, Summation mode) const -> decltype(v_data[0] * v[0])
     {
         if (v_size != v.size())
         {
             throw std::runtime_error("Vectors must be the same size to take the dot product.");
         }
+        if constexpr (std::is_same<T, U>::value)
+        {
+            return sum_terms(v_data.get(), v.begin(), v_size, mode);
+        }
+        if (mode == Summation::pairwise)
+        {
+            return dot_pairwise(v_data.get(), v.begin(), v_size);
+        }
         decltype(v_data[0] * v[0]) result = 0;
         for (size_t i = 0; i < v_size; i++)
         {
-            result += v_data[i] * v[i];
+            result += v_data[i] * v.at_unchecked(i);
         }
         return result;
     }
@@ -436,10 +580,10 @@ namespace atMath
         {
             throw std::runtime_error("Cross product requires two 3D vectors.");
         }
-        Vector<decltype(v_data[0] * v[0])> result(3);
-        result[0] = v_data[1] * v[2] - v_data[2] * v[1];
-        result[1] = v_data[2] * v[0] - v_data[0] * v[2];
-        result[2] = v_data[0] * v[1] - v_data[1] * v[0];
+        Vector<decltype(v_data[0] * v[0])> result(3, uninitialized);
+        result.at_unchecked(0) = v_data[1] * v.at_unchecked(2) - v_data[2] * v.at_unchecked(1);
+        result.at_unchecked(1) = v_data[2] * v.at_unchecked(0) - v_data[0] * v.at_unchecked(2);
+        result.at_unchecked(2) = v_data[0] * v.at_unchecked(1) - v_data[1] * v.at_unchecked(0);
         return result;
     }
 
@@ -473,39 +617,21 @@ namespace atMath
         return v1.angle(v2, deg);
     }
 
-    template <class T>
-    template <class U>
-    auto Vector<T>::product(const Vector<U>& v) const -> Vector<decltype(v_data[0] * v[0])>{
-        if (v_size != v.size()){
-            throw std::runtime_error("Vectors must be the same size to multiply.");
-        }
-        Vector<decltype(v_data[0] * v[0])> result(v_size);
-        for(size_t i = 0; i < v_size; i++){
-            result[i] = v_data[i] * v[i];
-        }
-        return result;
-    }
-
     template <class T>
     auto Vector<T>::inverse() const -> Vector<decltype(1 / v_data[0])>
     {
-        Vector<decltype(1 / v_data[0])> result(v_size);
+        Vector<decltype(1 / v_data[0])> result(v_size, uninitialized);
         for (size_t i = 0; i < v_size; i++)
         {
-            result[i] = 1 / v_data[i];
+            result.at_unchecked(i) = 1 / v_data[i];
         }
         return result;
     }
 
     template <class T>
-    T Vector<T>::sum() const
+    T Vector<T>::sum(Summation mode) const
     {
-        T result = 0;
-        for (size_t i = 0; i < v_size; i++)
-        {
-            result += v_data[i];
-        }
-        return result;
+        return sum_terms(v_data.get(), static_cast<const T *>(nullptr), v_size, mode);
     }
 
     template <class T>
@@ -514,14 +640,56 @@ namespace atMath
         return sqrt(dot(*this));
     }
 
+    template <class T>
+    template <class Policy>
+    T Vector<T>::sum(const Policy &policy, Summation mode) const
+    {
+        return execution::reduce_blocks<T>(policy, v_size, [this, mode](size_t begin, size_t end)
+                                           { return sum_terms(v_data.get() + begin, static_cast<const T *>(nullptr), end - begin, mode); });
+    }
+
+    template <class T>
+    template <class Policy, class U>
+    auto Vector<T>::dot(const Policy &policy, const Vector<U> &v, Summation mode) const -> decltype(v_data[0] * v[0])
+    {
+        if (v_size != v.size())
+        {
+            throw std::runtime_error("Vectors must be the same size to take the dot product.");
+        }
+        using R = decltype(v_data[0] * v[0]);
+        return execution::reduce_blocks<R>(policy, v_size, [this, &v, mode](size_t begin, size_t end) -> R
+                                           {
+            if constexpr (std::is_same<T, U>::value)
+            {
+                return sum_terms(v_data.get() + begin, v.begin() + begin, end - begin, mode);
+            }
+            if (mode == Summation::pairwise)
+            {
+                return dot_pairwise(v_data.get() + begin, v.begin() + begin, end - begin);
+            }
+            R result = 0;
+            for (size_t i = begin; i < end; i++)
+            {
+                result += v_data[i] * v.at_unchecked(i);
+            }
+            return result; });
+    }
+
+    template <class T>
+    template <class Policy>
+    double Vector<T>::magnitude(const Policy &policy) const
+    {
+        return sqrt(dot(policy, *this));
+    }
+
     template <class T>
     auto Vector<T>::normalize() const -> Vector<decltype(v_data[0] / magnitude())>
     {
-        Vector<decltype(v_data[0] / magnitude())> result(v_size);
+        Vector<decltype(v_data[0] / magnitude())> result(v_size, uninitialized);
         double mag = magnitude();
         for (size_t i = 0; i < v_size; i++)
         {
-            result[i] = v_data[i] / mag;
+            result.at_unchecked(i) = v_data[i] / mag;
         }
         return result;
     }
@@ -529,209 +697,184 @@ namespace atMath
     template <class T>
     void Vector<T>::clear()
     {
-
-        v_data.reset();
-        v_data(nullptr);
         v_size = 0;
     }
 
     template <class T>
-    template <class U>
-    std::enable_if_t<std::is_arithmetic<U>::value, Vector<T>> Vector<T>::append(const U &value)
+    size_t Vector<T>::capacity() const
     {
-        if (typeid(T) != typeid(U))
-        {
-            std::cout << "Warning: Type mismatch. Converting " << (type_map.find(typeid(U).name()) != type_map.end() ? type_map[typeid(U).name()] : typeid(U).name()) << " to " << (type_map.find(typeid(T).name()) != type_map.end() ? type_map[typeid(T).name()] : typeid(T).name()) << std::endl;
-        }
+        // Buffers adopted from a std::unique_ptr<T[]> have no recorded count.
+        return v_data ? std::max(v_size, v_data.get_deleter().count) : 0;
+    }
 
-        Vector<T> result(v_size + 1);
-        for (size_t i = 0; i < v_size; i++)
+    template <class T>
+    void Vector<T>::reserve(size_t capacity)
+    {
+        if (capacity > this->capacity())
         {
-            result[i] = v_data[i];
+            reallocate(capacity);
         }
-  
-        result[v_size] = value;
-
-        return result;
     }
 
     template <class T>
-    template <class U>
-    std::enable_if_t<std::is_arithmetic<U>::value, Vector<T>> Vector<T>::insert(size_t index, const U &value)
+    void Vector<T>::shrink_to_fit()
     {
-        if (typeid(T) != typeid(U))
+        if (capacity() > v_size)
         {
-            std::cout << "Warning: Type mismatch. Converting " << (type_map.find(typeid(U).name()) != type_map.end() ? type_map[typeid(U).name()] : typeid(U).name()) << " to " << (type_map.find(typeid(T).name()) != type_map.end() ? type_map[typeid(T).name()] : typeid(T).name()) << std::endl;
-        }
-        if (index > v_size)
-        {
-            throw std::runtime_error("Index out of bounds.");
+            reallocate(v_size);
         }
+    }
 
-        Vector<T> result(v_size + 1);
-        for (size_t i = 0; i < index; i++)
+    template <class T>
+    void Vector<T>::reallocate(size_t capacity)
+    {
+        Buffer<T> data = make_buffer<T>(capacity, resource(), false);
+        if constexpr (std::is_trivially_copyable<T>::value)
         {
-            result[i] = v_data[i];
+            copy_elements(data.get(), v_data.get(), v_size);
         }
-        result[index] = value;
-        for (size_t i = index; i < v_size; i++)
+        else
         {
-            result[i + 1] = v_data[i];
+            std::move(v_data.get(), v_data.get() + v_size, data.get());
         }
-
-        return result;
+        v_data = std::move(data);
     }
 
     template <class T>
-    template <class U>
-    Vector<T> Vector<T>::append(const Vector<U> &v)
+    void Vector<T>::grow(size_t required)
     {
-        if (typeid(T) != typeid(U))
+        size_t current = capacity();
+        if (required > current)
         {
-            std::cout << "Warning: Type mismatch. Converting " << (type_map.find(typeid(U).name()) != type_map.end() ? type_map[typeid(U).name()] : typeid(U).name()) << " to " << (type_map.find(typeid(T).name()) != type_map.end() ? type_map[typeid(T).name()] : typeid(T).name()) << std::endl;
+            reallocate(std::max(required, current + current / 2 + 8));
         }
+    }
 
-        Vector<T> result(v_size + v.size());
-        for (size_t i = 0; i < v_size; i++)
-        {
-            result[i] = v_data[i];
-        }
-        for (size_t i = 0; i < v.size(); i++)
+    template <class T>
+    void Vector<T>::push_back(const T &value)
+    {
+        if (v_size == capacity())
         {
-            result[v_size + i] = v[i];
+            // value may live in this buffer, keep a copy across the reallocation.
+            T copy = value;
+            grow(v_size + 1);
+            v_data[v_size++] = std::move(copy);
+            return;
         }
+        v_data[v_size++] = value;
+    }
 
-        return result;
+    template <class T>
+    template <class... Args>
+    T &Vector<T>::emplace_back(Args &&...args)
+    {
+        T value(std::forward<Args>(args)...);
+        grow(v_size + 1);
+        v_data[v_size] = std::move(value);
+        return v_data[v_size++];
     }
 
     template <class T>
-    template <class U>
-    Vector<T> Vector<T>::insert(size_t index, const Vector<U> &v)
+    template <class It>
+    Vector<T> &Vector<T>::insert_range(size_t index, It first, size_t count)
     {
-        if (typeid(T) != typeid(U))
-        {
-            std::cout << "Warning: Type mismatch. Converting " << (type_map.find(typeid(U).name()) != type_map.end() ? type_map[typeid(U).name()] : typeid(U).name()) << " to " << (type_map.find(typeid(T).name()) != type_map.end() ? type_map[typeid(T).name()] : typeid(T).name()) << std::endl;
-        }
         if (index > v_size)
         {
             throw std::runtime_error("Index out of bounds.");
         }
-
-        Vector result(v_size + v.size());
-        for (size_t i = 0; i < index; i++)
+        grow(v_size + count);
+        if constexpr (std::is_trivially_copyable<T>::value)
+        {
+            if (index != v_size)
+            {
+                std::memmove(v_data.get() + index + count, v_data.get() + index, (v_size - index) * sizeof(T));
+            }
+        }
+        else
         {
-            result[i] = v_data[i];
+            std::move_backward(v_data.get() + index, v_data.get() + v_size, v_data.get() + v_size + count);
         }
-        for (size_t i = 0; i < v.size(); i++)
+        if constexpr (std::is_convertible<It, const T *>::value)
         {
-            result[index + i] = v[i];
+            copy_elements(v_data.get() + index, first, count);
         }
-        for (size_t i = index; i < v_size; i++)
+        else
         {
-            result[i + v.size()] = v_data[i];
+            for (size_t i = 0; i < count; i++, ++first)
+            {
+                v_data[index + i] = static_cast<T>(*first);
+            }
         }
-
-       return result;
+        v_size += count;
+        return *this;
     }
 
     template <class T>
     template <class U>
-    Vector<T> Vector<T>::append(const std::vector<U> &v)
+    std::enable_if_t<std::is_arithmetic<U>::value, Vector<T> &> Vector<T>::append(const U &value)
     {
-        if (typeid(T) != typeid(U))
-        {
-            std::cout << "Warning: Type mismatch. Converting " << (type_map.find(typeid(U).name()) != type_map.end() ? type_map[typeid(U).name()] : typeid(U).name()) << " to " << (type_map.find(typeid(T).name()) != type_map.end() ? type_map[typeid(T).name()] : typeid(T).name()) << std::endl;
-        }
-
-        Vector<T> result(v_size + v.size());
-        for (size_t i = 0; i < v_size; i++)
-        {
-            result[i] = v_data[i];
-        }
-        for (size_t i = 0; i < v.size(); i++)
-        {
-            result[v_size + i] = v[i];
-        }
-
-        return result;
+        diagnostics::note_conversion<U, T>();
+        push_back(static_cast<T>(value));
+        return *this;
     }
 
     template <class T>
     template <class U>
-    Vector<T> Vector<T>::insert(size_t index, const std::vector<U> &v)
+    std::enable_if_t<std::is_arithmetic<U>::value, Vector<T> &> Vector<T>::insert(size_t index, const U &value)
     {
-        if (index > v_size)
-        {
-            throw std::runtime_error("Index out of bounds.");
-        }
-
-        Vector<T> result(v_size + v.size());
-        for (size_t i = 0; i < index; i++)
-        {
-            result[i] = v_data[i];
-        }
-        for (size_t i = 0; i < v.size(); i++)
-        {
-            result[index + i] = v[i];
-        }
-        for (size_t i = index; i < v_size; i++)
-        {
-            result[i + v.size()] = v_data[i];
-        }
-
-        return result;
+        diagnostics::note_conversion<U, T>();
+        T converted = static_cast<T>(value);
+        return insert_range(index, &converted, 1);
     }
 
     template <class T>
     template <class U>
-    Vector<T> Vector<T>::append(const std::initializer_list<U> &list)
+    Vector<T> &Vector<T>::append(const Vector<U> &v)
     {
-        if (typeid(T) != typeid(U))
-        {
-            std::cout << "Warning: Type mismatch. Converting " << (type_map.find(typeid(U).name()) != type_map.end() ? type_map[typeid(U).name()] : typeid(U).name()) << " to " << (type_map.find(typeid(T).name()) != type_map.end() ? type_map[typeid(T).name()] : typeid(T).name()) << std::endl;
-        }
+        return insert(v_size, v);
+    }
 
-        Vector<T> result(v_size + list.size());
-        for (size_t i = 0; i < v_size; i++)
-        {
-            result[i] = v_data[i];
-        }
-        size_t j = 0;
-        for (auto it = list.begin(); it != list.end(); it++)
+    template <class T>
+    template <class U>
+    Vector<T> &Vector<T>::insert(size_t index, const Vector<U> &v)
+    {
+        diagnostics::note_conversion<U, T>();
+        if (static_cast<const void *>(&v) == static_cast<const void *>(this))
         {
-            result[v_size + j] = *it;
-            j++;
+            Vector<U> copy(v);
+            return insert_range(index, copy.begin(), copy.size());
         }
+        return insert_range(index, v.begin(), v.size());
+    }
 
-        return result;
+    template <class T>
+    template <class U>
+    Vector<T> &Vector<T>::append(const std::vector<U> &v)
+    {
+        return insert(v_size, v);
     }
 
     template <class T>
     template <class U>
-    Vector<T> Vector<T>::insert(size_t index, const std::initializer_list<U> &list)
+    Vector<T> &Vector<T>::insert(size_t index, const std::vector<U> &v)
     {
-        if (index > v_size)
-        {
-            throw std::runtime_error("Index out of bounds.");
-        }
+        diagnostics::note_conversion<U, T>();
+        return insert_range(index, v.begin(), v.size());
+    }
 
-        Vector<T> result(v_size + list.size());
-        for (size_t i = 0; i < index; i++)
-        {
-            result[i] = v_data[i];
-        }
-        size_t j = 0;
-        for (auto it = list.begin(); it != list.end(); it++)
-        {
-            result[index + j] = *it;
-            j++;
-        }
-        for (size_t i = index; i < v_size; i++)
-        {
-            result[i + list.size()] = v_data[i];
-        }
+    template <class T>
+    template <class U>
+    Vector<T> &Vector<T>::append(const std::initializer_list<U> &list)
+    {
+        return insert(v_size, list);
+    }
 
-        return result;
+    template <class T>
+    template <class U>
+    Vector<T> &Vector<T>::insert(size_t index, const std::initializer_list<U> &list)
+    {
+        diagnostics::note_conversion<U, T>();
+        return insert_range(index, list.begin(), list.size());
     }
 
 
@@ -742,11 +885,8 @@ namespace atMath
         {
             throw std::runtime_error("Invalid start or end index.");
         }
-        Vector<T> result(end - start);
-        for (size_t i = start; i < end; i++)
-        {
-            result[i - start] = v_data[i];
-        }
+        Vector<T> result(end - start, uninitialized);
+        copy_elements(result.data(), v_data.get() + start, end - start);
         return result;
     }
 
@@ -756,35 +896,102 @@ namespace atMath
         return subvector(0, size);
     }
 
+    template <class T>
+    VectorView<T> Vector<T>::view()
+    {
+        return VectorView<T>(v_data.get(), v_size);
+    }
+
+    template <class T>
+    VectorView<const T> Vector<T>::view() const
+    {
+        return VectorView<const T>(v_data.get(), v_size);
+    }
+
+    template <class T>
+    VectorView<T> Vector<T>::view(size_t start, size_t end)
+    {
+        return view().subview(start, end);
+    }
+
+    template <class T>
+    VectorView<const T> Vector<T>::view(size_t start, size_t end) const
+    {
+        return view().subview(start, end);
+    }
+
+    template <class T>
+    VectorView<T> Vector<T>::slice(size_t start, size_t count, ptrdiff_t step)
+    {
+        return view().slice(start, count, step);
+    }
+
+    template <class T>
+    VectorView<const T> Vector<T>::slice(size_t start, size_t count, ptrdiff_t step) const
+    {
+        return view().slice(start, count, step);
+    }
+
     
-    template <class T, class U>
-    auto operator+(const Vector<T> &v1, const Vector<U> &v2) -> Vector<decltype(v1[0] + v2[0])>
+    template <class L, class R>
+    VectorBinary<expr_plus, L, R> operator+(const VectorExpression<L> &v1, const VectorExpression<R> &v2)
     {
-        if (v1.size() != v2.size())
-        {
-            throw std::runtime_error("Vectors must be the same size to add.");
-        }
-        Vector<decltype(v1[0] + v2[0])> result(v1.size());
-        for (size_t i = 0; i < v1.size(); i++)
-        {
-            result[i] = v1[i] + v2[i];
-        }
-        return result;
+        return VectorBinary<expr_plus, L, R>(v1.self(), v2.self());
     }
 
-    template <class T, class U>
-    auto operator-(const Vector<T> &v1, const Vector<U> &v2) -> Vector<decltype(v1[0] - v2[0])>
+    template <class L, class R>
+    VectorBinary<expr_minus, L, R> operator-(const VectorExpression<L> &v1, const VectorExpression<R> &v2)
+    {
+        return VectorBinary<expr_minus, L, R>(v1.self(), v2.self());
+    }
+
+    template <class T>
+    Vector<T> operator+(Vector<T> &&v1, const Vector<T> &v2)
+    {
+        v1 += v2;
+        return std::move(v1);
+    }
+
+    template <class T>
+    Vector<T> operator+(const Vector<T> &v1, Vector<T> &&v2)
+    {
+        v2 += v1;
+        return std::move(v2);
+    }
+
+    template <class T>
+    Vector<T> operator+(Vector<T> &&v1, Vector<T> &&v2)
+    {
+        v1 += v2;
+        return std::move(v1);
+    }
+
+    template <class T>
+    Vector<T> operator-(Vector<T> &&v1, const Vector<T> &v2)
+    {
+        v1 -= v2;
+        return std::move(v1);
+    }
+
+    template <class T>
+    Vector<T> operator-(const Vector<T> &v1, Vector<T> &&v2)
     {
         if (v1.size() != v2.size())
         {
             throw std::runtime_error("Vectors must be the same size to subtract.");
         }
-        Vector<decltype(v1[0] - v2[0])> result(v1.size());
-        for (size_t i = 0; i < v1.size(); i++)
+        for (size_t i = 0; i < v2.size(); i++)
         {
-            result[i] = v1[i] - v2[i];
+            v2.at_unchecked(i) = v1.at_unchecked(i) - v2.at_unchecked(i);
         }
-        return result;
+        return std::move(v2);
+    }
+
+    template <class T>
+    Vector<T> operator-(Vector<T> &&v1, Vector<T> &&v2)
+    {
+        v1 -= v2;
+        return std::move(v1);
     }
 
     template <class T, class U>
@@ -793,107 +1000,166 @@ namespace atMath
         return v1.dot(v2);
     }
 
-    template <class T, class U>
-    auto operator*(const Vector<T> &v, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Vector<decltype(v[0] * value)>>
+    // Shared body of the policy overloads of add/subtract/multiply/divide:
+    // kernel(out, a, b, n) writes a op b for one block of the result.
+    template <class Policy, class T, class Kernel>
+    Vector<T> elementwise(const Policy &policy, const Vector<T> &v1, const Vector<T> &v2, const char *error, Kernel kernel)
     {
-        static_assert(std::is_arithmetic<U>::value, "Value must be arithmetic");
-        Vector<decltype(v[0] * value)> result(v.size());
-        for (size_t i = 0; i < v.size(); i++)
+        if (v1.size() != v2.size())
         {
-            result[i] = v[i] * value;
+            throw std::runtime_error(error);
         }
+        Vector<T> result(v1.size(), uninitialized);
+        execution::for_each_block(policy, v1.size(), execution::elementwise_block, [&](size_t begin, size_t end)
+                                  { kernel(result.data() + begin, v1.data() + begin, v2.data() + begin, end - begin); });
         return result;
     }
 
-    template <class T, class U>
-    auto operator*(const U &value, const Vector<T> &v) -> std::enable_if_t<std::is_arithmetic<U>::value, Vector<decltype(value * v[0])>>
+    template <class Policy, class T>
+    auto add(const Policy &policy, const Vector<T> &v1, const Vector<T> &v2) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<T>>
     {
-        return v * value;
+        return elementwise(policy, v1, v2, "Vectors must be the same size to add.", [](T *out, const T *a, const T *b, size_t n)
+                           {
+            std::copy(a, a + n, out);
+            simd::add(out, b, n); });
     }
 
-    template <class T, class U>
-    auto operator*(const Vector<T> &v, const Complex<U> &c) -> Vector<decltype(v[0] * c)>
+    template <class Policy, class T>
+    auto subtract(const Policy &policy, const Vector<T> &v1, const Vector<T> &v2) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<T>>
     {
-        Vector<decltype(v[0] * c)> result(v.size());
-        for (size_t i = 0; i < v.size(); i++)
-        {
-            result[i] = v[i] * c;
-        }
-        return result;
+        return elementwise(policy, v1, v2, "Vectors must be the same size to subtract.", [](T *out, const T *a, const T *b, size_t n)
+                           {
+            std::copy(a, a + n, out);
+            simd::sub(out, b, n); });
     }
-  
-    template <class T, class U>
-    auto operator*(const Complex<U> &c, const Vector<T> &v) -> Vector<decltype(c * v[0])>
+
+    template <class Policy, class T>
+    auto multiply(const Policy &policy, const Vector<T> &v1, const Vector<T> &v2) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<T>>
     {
-        return v * c;
+        return elementwise(policy, v1, v2, "Vectors must be the same size to multiply.", [](T *out, const T *a, const T *b, size_t n)
+                           {
+            if constexpr (std::is_same<T, Complex<float>>::value || std::is_same<T, Complex<double>>::value)
+            {
+                using lane = decltype(T::real);
+                simd::complex_mul(reinterpret_cast<lane *>(out), reinterpret_cast<const lane *>(a), reinterpret_cast<const lane *>(b), n);
+            }
+            else
+            {
+                std::copy(a, a + n, out);
+                simd::mul(out, b, n);
+            } });
     }
 
-    template <class T, class U>
-    auto operator*(const Vector<T> &v, const Quaternion<U> &q) -> Vector<decltype(v[0] * q)>
+    template <class Policy, class T>
+    auto divide(const Policy &policy, const Vector<T> &v1, const Vector<T> &v2) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<T>>
     {
-        Vector<decltype(v[0] * q)> result(v.size());
-        for (size_t i = 0; i < v.size(); i++)
-        {
-            result[i] = v[i] * q;
-        }
-        return result;
+        return elementwise(policy, v1, v2, "Vectors must be the same size to divide.", [](T *out, const T *a, const T *b, size_t n)
+                           {
+            if constexpr (std::is_same<T, Complex<float>>::value || std::is_same<T, Complex<double>>::value)
+            {
+                using lane = decltype(T::real);
+                simd::complex_div(reinterpret_cast<lane *>(out), reinterpret_cast<const lane *>(a), reinterpret_cast<const lane *>(b), n);
+            }
+            else
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    out[i] = a[i] / b[i];
+                }
+            } });
     }
 
-    template <class T, class U>
-    auto operator*(const Quaternion<U> &q, const Vector<T> &v) -> Vector<decltype(q * v[0])>
+    template <class E, class U>
+    auto operator*(const VectorExpression<E> &v, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, VectorScalarRight<expr_multiplies, E, U>>
     {
-        return v * q;
+        return VectorScalarRight<expr_multiplies, E, U>(v.self(), value);
     }
 
-    template <class T, class U>
-    auto operator/(const Vector<T> &v, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Vector<decltype(v[0] / value)>>
+    template <class E, class U>
+    auto operator*(const U &value, const VectorExpression<E> &v) -> std::enable_if_t<std::is_arithmetic<U>::value, VectorScalarLeft<expr_multiplies, U, E>>
     {
-        Vector<decltype(v[0] / value)> result(v.size());
-        for (size_t i = 0; i < v.size(); i++)
-        {
-            result[i] = v[i] / value;
-        }
-        return result;
+        return VectorScalarLeft<expr_multiplies, U, E>(value, v.self());
     }
 
     template <class T, class U>
-    auto operator/(const U &value, const Vector<T> &v) -> std::enable_if_t<std::is_arithmetic<U>::value, Vector<decltype(value / v[0])>>
+    auto operator*(Vector<T> &&v, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value && std::is_same<decltype(v[0] * value), T>::value, Vector<T>>
     {
-        return v.inverse() * value;
+        v *= value;
+        return std::move(v);
     }
 
     template <class T, class U>
-    auto operator/(const Vector<T> &v, const Complex<U> &c) -> Vector<decltype(v[0] / c)>
+    auto operator*(const U &value, Vector<T> &&v) -> std::enable_if_t<std::is_arithmetic<U>::value && std::is_same<decltype(v[0] * value), T>::value, Vector<T>>
     {
-        Vector<decltype(v[0] / c)> result(v.size());
-        for (size_t i = 0; i < v.size(); i++)
-        {
-            result[i] = v[i] / c;
-        }
-        return result;
+        v *= value;
+        return std::move(v);
     }
 
-    template <class T, class U>
-    auto operator/(const Complex<U> &c, const Vector<T> &v) -> Vector<decltype(c / v[0])>
+    template <class E, class U>
+    VectorScalarRight<expr_multiplies, E, Complex<U>> operator*(const VectorExpression<E> &v, const Complex<U> &c)
     {
-        return v.inverse() * c;
+        return VectorScalarRight<expr_multiplies, E, Complex<U>>(v.self(), c);
     }
 
-    template <class T, class U>
-    auto operator/(const Vector<T> &v, const Quaternion<U> &q) -> Vector<decltype(v[0] / q)>
+    template <class E, class U>
+    VectorScalarLeft<expr_multiplies, Complex<U>, E> operator*(const Complex<U> &c, const VectorExpression<E> &v)
     {
-        Vector<decltype(v[0] / q)> result(v.size());
-        for (size_t i = 0; i < v.size(); i++)
-        {
-            result[i] = v[i] / q;
-        }
-        return result;
+        return VectorScalarLeft<expr_multiplies, Complex<U>, E>(c, v.self());
+    }
+
+    template <class E, class U>
+    VectorScalarRight<expr_multiplies, E, Quaternion<U>> operator*(const VectorExpression<E> &v, const Quaternion<U> &q)
+    {
+        return VectorScalarRight<expr_multiplies, E, Quaternion<U>>(v.self(), q);
+    }
+
+    template <class E, class U>
+    VectorScalarLeft<expr_multiplies, Quaternion<U>, E> operator*(const Quaternion<U> &q, const VectorExpression<E> &v)
+    {
+        return VectorScalarLeft<expr_multiplies, Quaternion<U>, E>(q, v.self());
+    }
+
+    template <class E, class U>
+    auto operator/(const VectorExpression<E> &v, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, VectorScalarRight<expr_divides, E, U>>
+    {
+        return VectorScalarRight<expr_divides, E, U>(v.self(), value);
     }
 
     template <class T, class U>
-    auto operator/(const Quaternion<U> &q, const Vector<T> &v) -> Vector<decltype(q / v[0])>
+    auto operator/(Vector<T> &&v, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value && std::is_same<decltype(v[0] / value), T>::value, Vector<T>>
+    {
+        v /= value;
+        return std::move(v);
+    }
+
+    template <class E, class U>
+    auto operator/(const U &value, const VectorExpression<E> &v) -> std::enable_if_t<std::is_arithmetic<U>::value, VectorScalarLeft<expr_divides, U, E>>
+    {
+        return VectorScalarLeft<expr_divides, U, E>(value, v.self());
+    }
+
+    template <class E, class U>
+    VectorScalarRight<expr_divides, E, Complex<U>> operator/(const VectorExpression<E> &v, const Complex<U> &c)
+    {
+        return VectorScalarRight<expr_divides, E, Complex<U>>(v.self(), c);
+    }
+
+    template <class E, class U>
+    VectorScalarLeft<expr_divides, Complex<U>, E> operator/(const Complex<U> &c, const VectorExpression<E> &v)
+    {
+        return VectorScalarLeft<expr_divides, Complex<U>, E>(c, v.self());
+    }
+
+    template <class E, class U>
+    VectorScalarRight<expr_divides, E, Quaternion<U>> operator/(const VectorExpression<E> &v, const Quaternion<U> &q)
+    {
+        return VectorScalarRight<expr_divides, E, Quaternion<U>>(v.self(), q);
+    }
+
+    template <class E, class U>
+    VectorScalarLeft<expr_divides, Quaternion<U>, E> operator/(const Quaternion<U> &q, const VectorExpression<E> &v)
     {
-        return v.inverse() * q;
+        return VectorScalarLeft<expr_divides, Quaternion<U>, E>(q, v.self());
     }
 
 
@@ -902,10 +1168,10 @@ namespace atMath
 template <class T>
 auto exp(const atMath::Vector<T> &v) -> atMath::Vector<decltype(exp(v[0]))>
 {
-    atMath::Vector<decltype(exp(v[0]))> result(v.size());
+    atMath::Vector<decltype(exp(v[0]))> result(v.size(), atMath::uninitialized);
     for (size_t i = 0; i < v.size(); i++)
     {
-        result[i] = exp(v[i]);
+        result.at_unchecked(i) = exp(v.at_unchecked(i));
     }
     return result;
 }
@@ -913,10 +1179,10 @@ auto exp(const atMath::Vector<T> &v) -> atMath::Vector<decltype(exp(v[0]))>
 template <class T>
 auto log(const atMath::Vector<T> &v) -> atMath::Vector<decltype(log(v[0]))>
 {
-    atMath::Vector<decltype(log(v[0]))> result(v.size());
+    atMath::Vector<decltype(log(v[0]))> result(v.size(), atMath::uninitialized);
     for (size_t i = 0; i < v.size(); i++)
     {
-        result[i] = log(v[i]);
+        result.at_unchecked(i) = log(v.at_unchecked(i));
     }
     return result;
 }
\ No newline at end of file
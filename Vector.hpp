@@ -7,24 +7,64 @@
 #include <iterator>
 #include <memory>
 #include <initializer_list>
+#include <stdexcept>
 #include <vector>
 #include "Complex.hpp"
 #include "Quaternion.hpp"
+#include "VectorExpression.hpp"
+#include "Allocator.hpp"
+#include "Execution.hpp"
+
+// Vector::operator[] throws std::out_of_range on a bad index only while
+// ATMATH_BOUNDS_CHECK is non-zero. It follows NDEBUG unless set explicitly,
+// so release builds index without a branch. Library kernels always go
+// through data()/at_unchecked() and are unaffected by this switch.
+// operator[] is force-inlined in the class rather than compiled into the
+// library, so a client's setting need not match the library's.
+#ifndef ATMATH_BOUNDS_CHECK
+#ifdef NDEBUG
+#define ATMATH_BOUNDS_CHECK 0
+#else
+#define ATMATH_BOUNDS_CHECK 1
+#endif
+#endif
 
 namespace atMath
 {   
 
+    // How sum() and dot() accumulate. naive adds straight into the SIMD
+    // lanes and is the fastest. pairwise sums 256-element blocks and adds
+    // the block sums in a balanced tree. kahan and neumaier carry a running
+    // correction per lane; neumaier also stays accurate when a term
+    // outweighs the running total. widened accumulates in double, which for
+    // float data gives double accuracy without storing a Vecd. kahan,
+    // neumaier and widened apply to float and double elements (widened is
+    // plain summation for double); other element types fall back to naive.
+    enum class Summation
+    {
+        naive,
+        pairwise,
+        kahan,
+        neumaier,
+        widened
+    };
 
     template <class T = float>
-    class Vector
+    class Vector : public VectorExpression<Vector<T>>
     {
 
     protected:
-        std::unique_ptr<T[]> v_data;
+        Buffer<T> v_data;
         size_t v_size;
 
+        void reallocate(size_t capacity);
+        void grow(size_t required);
+        template <class It>
+        Vector<T> &insert_range(size_t index, It first, size_t count);
+
     public:
 
+        using value_type = T;
         using iterator = T *;
         using const_iterator = const T *;
 
@@ -37,12 +77,24 @@ namespace atMath
         Vector();
         Vector(size_t size);
         Vector(size_t size, T value);
+        Vector(size_t size, uninitialized_t, std::pmr::memory_resource *resource = get_default_resource());
+        Vector(size_t size, T value, std::pmr::memory_resource *resource);
         Vector(const Vector<T> &v);
+        Vector(Vector<T> &&v) noexcept;
         template <class U>
         Vector(const Vector<U> &v);
         Vector(const std::vector<T> &v);
         Vector(std::initializer_list<T> list);
         Vector(std::unique_ptr<T[]> v_data, size_t size);
+        Vector(Buffer<T> buffer, size_t size);
+        // Takes ownership of size elements at data, which deleter(data)
+        // releases once the Vector lets go of them, e.g. a DMA buffer or one
+        // from another allocator.
+        template <class Deleter, class = std::enable_if_t<std::is_invocable<Deleter &, T *>::value>>
+        Vector(T *data, size_t size, Deleter deleter);
+        Vector(T *data, size_t size, borrowed_t);
+        template <class E>
+        Vector(const VectorExpression<E> &e);
         // Vector(const Vec2<T> &v);
         // Vector(const Vec3<T> &v);
         // Vector(const Vec4<T> &v);
@@ -50,21 +102,56 @@ namespace atMath
         ~Vector();
 
         size_t size() const;
+        std::pmr::memory_resource *resource() const;
 
         static Vector<T> repeat(size_t size, T value);
         template <class U>
         static Vector<U> repeat(size_t size, U value);
 
-        T &operator[](size_t index);
-        const T &operator[](size_t index) const;
+        ATMATH_FORCE_INLINE T &operator[](size_t index)
+        {
+#if ATMATH_BOUNDS_CHECK
+            if (index >= v_size)
+            {
+                throw std::out_of_range("Index out of bounds.");
+            }
+#endif
+            return v_data[index];
+        }
+        ATMATH_FORCE_INLINE const T &operator[](size_t index) const
+        {
+#if ATMATH_BOUNDS_CHECK
+            if (index >= v_size)
+            {
+                throw std::out_of_range("Index out of bounds.");
+            }
+#endif
+            return v_data[index];
+        }
+
+        T *data() { return v_data.get(); }
+        const T *data() const { return v_data.get(); }
+        // Hands the buffer and its deleter to the caller and leaves the Vector
+        // empty; read size() first. The deleter releases the memory the way
+        // it was obtained.
+        Buffer<T> release();
+        T &at_unchecked(size_t index) { return v_data[index]; }
+        const T &at_unchecked(size_t index) const { return v_data[index]; }
 
         Vector<T> &operator=(const Vector<T> &v);
+        Vector<T> &operator=(Vector<T> &&v) noexcept;
         template <class U>
         Vector<T> &operator=(const Vector<U> &v);
+        template <class E>
+        Vector<T> &operator=(const VectorExpression<E> &e);
         template <class U>
         Vector<T> &operator+=(const Vector<U> &v);
+        template <class E>
+        Vector<T> &operator+=(const VectorExpression<E> &e);
         template <class U>
         Vector<T> &operator-=(const Vector<U> &v);
+        template <class E>
+        Vector<T> &operator-=(const VectorExpression<E> &e);
         template <class U>
         Vector<T> &operator*=(const Vector<U> &v);
 
@@ -81,8 +168,9 @@ namespace atMath
 
 
 
+        // Only naive and pairwise apply when the element types differ.
         template <class U>
-        auto dot(const Vector<U> &v) const -> decltype(v_data[0] * v[0]);
+        auto dot(const Vector<U> &v, Summation mode = Summation::naive) const -> decltype(v_data[0] * v[0]);
         template <class U>
         auto cross(const Vector<U> &v) const -> Vector<decltype(v_data[0] * v[0])>;
         template <class U>
@@ -93,31 +181,48 @@ namespace atMath
         double angle(const Vector<U> &v, bool deg = false) const;
         template <class U, class V>
         static double angle(const Vector<U> &v1, const Vector<V> &v2, bool deg = false);
-        template <class U>
-        auto product(const Vector<U> &v) const -> Vector<decltype(v_data[0] * v[0])>;
 
-        T sum() const;
+        T sum(Summation mode = Summation::naive) const;
         double magnitude() const;
+
+        // Policy overloads, see Execution.hpp. Results do not depend on the
+        // policy or the thread count. Each block is accumulated in the given
+        // mode; the block results are then added pairwise in T.
+        template <class Policy>
+        T sum(const Policy &policy, Summation mode = Summation::naive) const;
+        template <class Policy, class U>
+        auto dot(const Policy &policy, const Vector<U> &v, Summation mode = Summation::naive) const -> decltype(v_data[0] * v[0]);
+        template <class Policy>
+        double magnitude(const Policy &policy) const;
         auto inverse() const -> Vector<decltype(1 / v_data[0])>;
         auto normalize() const -> Vector<decltype(v_data[0] / magnitude())>;
         void clear();
 
+        size_t capacity() const;
+        void reserve(size_t capacity);
+        void shrink_to_fit();
+        void push_back(const T &value);
+        template <class... Args>
+        T &emplace_back(Args &&...args);
+
+        // append and insert modify the vector in place, growing the buffer
+        // geometrically, and return it for chaining.
         template <class U>
-        std::enable_if_t<std::is_arithmetic<U>::value, Vector<T>> append(const U &value);
+        std::enable_if_t<std::is_arithmetic<U>::value, Vector<T> &> append(const U &value);
         template <class U>
-        std::enable_if_t<std::is_arithmetic<U>::value, Vector<T>> insert(size_t index, const U &value);
+        std::enable_if_t<std::is_arithmetic<U>::value, Vector<T> &> insert(size_t index, const U &value);
         template <class U>
-        Vector<T> append(const Vector<U> &v);
+        Vector<T> &append(const Vector<U> &v);
         template <class U>
-        Vector<T> insert(size_t index, const Vector<U> &v);
+        Vector<T> &insert(size_t index, const Vector<U> &v);
         template <class U>
-        Vector<T> append(const std::vector<U> &v);
+        Vector<T> &append(const std::vector<U> &v);
         template <class U>
-        Vector<T> insert(size_t index, const std::vector<U> &v);
+        Vector<T> &insert(size_t index, const std::vector<U> &v);
         template <class U>
-        Vector<T> append(const std::initializer_list<U> &list);
+        Vector<T> &append(const std::initializer_list<U> &list);
         template <class U>
-        Vector<T> insert(size_t index, const std::initializer_list<U> &list);
+        Vector<T> &insert(size_t index, const std::initializer_list<U> &list);
 
         
         // template <class U>
@@ -136,6 +241,15 @@ namespace atMath
         Vector<T> subvector(size_t start, size_t end) const;
         Vector<T> subvector(size_t size) const;
 
+        // Non-owning views; see VectorView.hpp. They are invalidated by
+        // anything that reallocates the vector.
+        VectorView<T> view();
+        VectorView<const T> view() const;
+        VectorView<T> view(size_t start, size_t end);
+        VectorView<const T> view(size_t start, size_t end) const;
+        VectorView<T> slice(size_t start, size_t count, ptrdiff_t step);
+        VectorView<const T> slice(size_t start, size_t count, ptrdiff_t step) const;
+
         friend std::ostream &operator<<(std::ostream &os, const Vector<T> &v)
         {   
             os << std::fixed << std::setprecision(3);
@@ -155,51 +269,87 @@ namespace atMath
     };
 
 
-    template <class T, class U>
-    auto operator+(const Vector<T> &v1, const Vector<U> &v2) -> Vector<decltype(v1[0] + v2[0])>;
+    // Arithmetic between vectors and with scalars builds a VectorExpression,
+    // see VectorExpression.hpp. Nothing is computed until the result is
+    // assigned to a Vector.
+    template <class L, class R>
+    VectorBinary<expr_plus, L, R> operator+(const VectorExpression<L> &v1, const VectorExpression<R> &v2);
+
+    template <class L, class R>
+    VectorBinary<expr_minus, L, R> operator-(const VectorExpression<L> &v1, const VectorExpression<R> &v2);
+
+    // Overloads for expiring operands of the same type: the result is written
+    // into the buffer of the rvalue operand instead of a fresh allocation.
+    template <class T>
+    Vector<T> operator+(Vector<T> &&v1, const Vector<T> &v2);
+    template <class T>
+    Vector<T> operator+(const Vector<T> &v1, Vector<T> &&v2);
+    template <class T>
+    Vector<T> operator+(Vector<T> &&v1, Vector<T> &&v2);
+
+    template <class T>
+    Vector<T> operator-(Vector<T> &&v1, const Vector<T> &v2);
+    template <class T>
+    Vector<T> operator-(const Vector<T> &v1, Vector<T> &&v2);
+    template <class T>
+    Vector<T> operator-(Vector<T> &&v1, Vector<T> &&v2);
 
     template <class T, class U>
-    auto operator-(const Vector<T> &v1, const Vector<U> &v2) -> Vector<decltype(v1[0] - v2[0])>;
+    auto operator*(Vector<T> &&v, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value && std::is_same<decltype(v[0] * value), T>::value, Vector<T>>;
+    template <class T, class U>
+    auto operator*(const U &value, Vector<T> &&v) -> std::enable_if_t<std::is_arithmetic<U>::value && std::is_same<decltype(v[0] * value), T>::value, Vector<T>>;
+    template <class T, class U>
+    auto operator/(Vector<T> &&v, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value && std::is_same<decltype(v[0] / value), T>::value, Vector<T>>;
 
     template <class T, class U>
     auto operator*(const Vector<T> &v1, const Vector<U> &v2) -> decltype(v1[0] * v2[0]);
 
-    template <class T, class U>
-    auto operator*(const Vector<T> &v, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Vector<decltype(v[0] * value)>>;
+    // Elementwise v1 op v2 evaluated under an execution policy; par and
+    // par_unseq split large vectors across ThreadPool::global().
+    template <class Policy, class T>
+    auto add(const Policy &policy, const Vector<T> &v1, const Vector<T> &v2) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<T>>;
+    template <class Policy, class T>
+    auto subtract(const Policy &policy, const Vector<T> &v1, const Vector<T> &v2) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<T>>;
+    template <class Policy, class T>
+    auto multiply(const Policy &policy, const Vector<T> &v1, const Vector<T> &v2) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<T>>;
+    template <class Policy, class T>
+    auto divide(const Policy &policy, const Vector<T> &v1, const Vector<T> &v2) -> std::enable_if_t<execution::is_execution_policy<Policy>::value, Vector<T>>;
 
-    template <class T, class U>
-    auto operator*(const U &value, const Vector<T> &v) -> std::enable_if_t<std::is_arithmetic<U>::value, Vector<decltype(v[0] * value)>>;
+    template <class E, class U>
+    auto operator*(const VectorExpression<E> &v, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, VectorScalarRight<expr_multiplies, E, U>>;
 
-    template <class T, class U>
-    auto operator*(const Vector<T> &v, const Complex<U> &c) -> Vector<decltype(v[0] * c)>;
+    template <class E, class U>
+    auto operator*(const U &value, const VectorExpression<E> &v) -> std::enable_if_t<std::is_arithmetic<U>::value, VectorScalarLeft<expr_multiplies, U, E>>;
 
-    template <class T, class U>
-    auto operator*(const Complex<U> &c, const Vector<T> &v) -> Vector<decltype(c * v[0])>;
+    template <class E, class U>
+    VectorScalarRight<expr_multiplies, E, Complex<U>> operator*(const VectorExpression<E> &v, const Complex<U> &c);
 
-    template <class T, class U>
-    auto operator*(const Vector<T> &v, const Quaternion<U> &q) -> Vector<decltype(v[0] * q)>;
+    template <class E, class U>
+    VectorScalarLeft<expr_multiplies, Complex<U>, E> operator*(const Complex<U> &c, const VectorExpression<E> &v);
 
-    template <class T, class U>
-    auto operator*(const Quaternion<U> &q, const Vector<T> &v) -> Vector<decltype(q * v[0])>;
+    template <class E, class U>
+    VectorScalarRight<expr_multiplies, E, Quaternion<U>> operator*(const VectorExpression<E> &v, const Quaternion<U> &q);
 
-    template <class T, class U>
-    auto operator/(const Vector<T> &v, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, Vector<decltype(v[0] / value)>>;
+    template <class E, class U>
+    VectorScalarLeft<expr_multiplies, Quaternion<U>, E> operator*(const Quaternion<U> &q, const VectorExpression<E> &v);
 
-    template <class T, class U>
-    auto operator/(const U &value, const Vector<T> &v) -> std::enable_if_t<std::is_arithmetic<U>::value, Vector<decltype(value / v[0])>>;
+    template <class E, class U>
+    auto operator/(const VectorExpression<E> &v, const U &value) -> std::enable_if_t<std::is_arithmetic<U>::value, VectorScalarRight<expr_divides, E, U>>;
 
-    template <class T, class U>
-    auto operator/(const Vector<T> &v, const Complex<U> &c) -> Vector<decltype(v[0] / c)>;
+    template <class E, class U>
+    auto operator/(const U &value, const VectorExpression<E> &v) -> std::enable_if_t<std::is_arithmetic<U>::value, VectorScalarLeft<expr_divides, U, E>>;
 
-    template <class T, class U>
-    auto operator/(const Complex<U> &c, const Vector<T> &v) -> Vector<decltype(c / v[0])>;
+    template <class E, class U>
+    VectorScalarRight<expr_divides, E, Complex<U>> operator/(const VectorExpression<E> &v, const Complex<U> &c);
 
-    template <class T, class U>
-    auto operator/(const Vector<T> &v, const Quaternion<U> &q) -> Vector<decltype(v[0] / q)>;
+    template <class E, class U>
+    VectorScalarLeft<expr_divides, Complex<U>, E> operator/(const Complex<U> &c, const VectorExpression<E> &v);
 
-    template <class T, class U>
-    auto operator/(const Quaternion<U> &q, const Vector<T> &v) -> Vector<decltype(q / v[0])>;
+    template <class E, class U>
+    VectorScalarRight<expr_divides, E, Quaternion<U>> operator/(const VectorExpression<E> &v, const Quaternion<U> &q);
 
+    template <class E, class U>
+    VectorScalarLeft<expr_divides, Quaternion<U>, E> operator/(const Quaternion<U> &q, const VectorExpression<E> &v);
 
 }
 
@@ -208,3 +358,68 @@ auto exp(const atMath::Vector<T> &v) -> atMath::Vector<decltype(exp(v[0]))>;
 
 template <class T>
 auto log(const atMath::Vector<T> &v) -> atMath::Vector<decltype(log(v[0]))>;
+
+// The template definitions live in Vector.cpp and are pulled in here, so
+// including the headers is enough. Code linked against the atMath library
+// defines ATMATH_EXTERN_TEMPLATES (the CMake target sets it for its users)
+// and takes the instantiations listed below from the library instead of
+// compiling them in every translation unit. Each ATMATH_*_INSTANCES macro
+// expands to `template` definitions in the library's *Instances.cpp and to
+// `extern template` declarations here.
+#include "Vector.cpp"
+
+#define ATMATH_VECTOR_INSTANCES(PREFIX, T)                                   \
+    PREFIX class Vector<T>;                                                  \
+    PREFIX Vector<T> &Vector<T>::operator+=(const Vector<T> &);              \
+    PREFIX Vector<T> &Vector<T>::operator-=(const Vector<T> &);              \
+    PREFIX Vector<T> &Vector<T>::operator*=(const Vector<T> &);              \
+    PREFIX Vector<T> &Vector<T>::operator*=(const T &);                      \
+    PREFIX Vector<T> &Vector<T>::operator/=(const T &);                      \
+    PREFIX bool Vector<T>::operator==(const Vector<T> &) const;              \
+    PREFIX bool Vector<T>::operator!=(const Vector<T> &) const;              \
+    PREFIX T Vector<T>::dot(const Vector<T> &, Summation) const;             \
+    PREFIX Vector<T> &Vector<T>::append(const Vector<T> &);                  \
+    PREFIX Vector<T> &Vector<T>::insert(size_t, const Vector<T> &);          \
+    PREFIX Vector<T> operator+(Vector<T> &&, const Vector<T> &);             \
+    PREFIX Vector<T> operator-(Vector<T> &&, const Vector<T> &);
+
+// Complex and quaternion elements have no magnitude() or normalize(), so
+// only the members that apply to them are instantiated.
+#define ATMATH_VECTOR_STORAGE_INSTANCES(PREFIX, T)                           \
+    PREFIX Vector<T>::Vector();                                              \
+    PREFIX Vector<T>::Vector(size_t);                                        \
+    PREFIX Vector<T>::Vector(size_t, T);                                     \
+    PREFIX Vector<T>::Vector(size_t, uninitialized_t,                        \
+        std::pmr::memory_resource *);                                        \
+    PREFIX Vector<T>::Vector(Vector<T> &&) noexcept;                         \
+    PREFIX Vector<T>::Vector(const std::vector<T> &);                        \
+    PREFIX Vector<T>::Vector(std::initializer_list<T>);                      \
+    PREFIX Vector<T>::~Vector();                                             \
+    PREFIX size_t Vector<T>::size() const;                                   \
+    PREFIX Vector<T> &Vector<T>::operator=(Vector<T> &&) noexcept;           \
+    PREFIX Vector<T> &Vector<T>::operator+=(const Vector<T> &);              \
+    PREFIX Vector<T> &Vector<T>::operator-=(const Vector<T> &);              \
+    PREFIX Vector<T> &Vector<T>::operator*=(const Vector<T> &);              \
+    PREFIX T Vector<T>::sum(Summation) const;                                \
+    PREFIX size_t Vector<T>::capacity() const;                               \
+    PREFIX void Vector<T>::reserve(size_t);                                  \
+    PREFIX void Vector<T>::shrink_to_fit();                                  \
+    PREFIX void Vector<T>::push_back(const T &);                             \
+    PREFIX void Vector<T>::clear();                                          \
+    PREFIX Vector<T> &Vector<T>::append(const Vector<T> &);                  \
+    PREFIX Vector<T> Vector<T>::subvector(size_t, size_t) const;
+
+#if ATMATH_EXTERN_TEMPLATES
+namespace atMath
+{
+    ATMATH_VECTOR_INSTANCES(extern template, float)
+    ATMATH_VECTOR_INSTANCES(extern template, double)
+    ATMATH_VECTOR_INSTANCES(extern template, int)
+    ATMATH_VECTOR_STORAGE_INSTANCES(extern template, Complex<int>)
+    ATMATH_VECTOR_STORAGE_INSTANCES(extern template, Complex<float>)
+    ATMATH_VECTOR_STORAGE_INSTANCES(extern template, Complex<double>)
+    ATMATH_VECTOR_STORAGE_INSTANCES(extern template, Quaternion<int>)
+    ATMATH_VECTOR_STORAGE_INSTANCES(extern template, Quaternion<float>)
+    ATMATH_VECTOR_STORAGE_INSTANCES(extern template, Quaternion<double>)
+}
+#endif
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace atMath
+{
+
+    template <class T>
+    class Vector;
+
+    template <class T>
+    class VectorView;
+
+    template <class T>
+    class Vec2;
+
+    template <class T>
+    class Vec3;
+
+    template <class T>
+    class Vec4;
+
+    template <class Op, class L, class R>
+    class VectorBinary;
+
+    template <class Op, class E, class S>
+    class VectorScalarRight;
+
+    template <class Op, class S, class E>
+    class VectorScalarLeft;
+
+    struct expr_plus
+    {
+        static constexpr const char *error = "Vectors must be the same size to add.";
+        template <class A, class B>
+        auto operator()(const A &a, const B &b) const { return a + b; }
+    };
+
+    struct expr_minus
+    {
+        static constexpr const char *error = "Vectors must be the same size to subtract.";
+        template <class A, class B>
+        auto operator()(const A &a, const B &b) const { return a - b; }
+    };
+
+    struct expr_multiplies
+    {
+        static constexpr const char *error = "Vectors must be the same size to multiply.";
+        template <class A, class B>
+        auto operator()(const A &a, const B &b) const { return a * b; }
+    };
+
+    struct expr_divides
+    {
+        static constexpr const char *error = "Vectors must be the same size to divide.";
+        template <class A, class B>
+        auto operator()(const A &a, const B &b) const { return a / b; }
+    };
+
+    // Base of every lazily evaluated vector expression. Vector<T> itself is a
+    // leaf, the nodes below combine leaves and other nodes without allocating.
+    // The elements are only computed when the expression is assigned to a
+    // Vector, in a single loop.
+    //
+    // Nodes keep references to their Vector leaves, so an expression must be
+    // evaluated (assigned or eval()'d) before its operands go out of scope.
+    // Views and fixed-size vectors are cheap to copy and often temporaries
+    // (v.view(0, 2) * 2.0f), so nodes hold those by value.
+    template <class E>
+    class VectorExpression
+    {
+    public:
+        const E &self() const { return static_cast<const E &>(*this); }
+
+        auto eval() const
+        {
+            return Vector<typename E::value_type>(self());
+        }
+
+        template <class R>
+        VectorBinary<expr_multiplies, E, R> product(const VectorExpression<R> &v) const
+        {
+            return VectorBinary<expr_multiplies, E, R>(self(), v.self());
+        }
+    };
+
+    // Vector leaves are held by reference; views, fixed-size vectors and
+    // intermediate nodes by value.
+    template <class E>
+    struct expression_storage
+    {
+        using type = const E &;
+    };
+
+    template <class T>
+    struct expression_storage<VectorView<T>>
+    {
+        using type = VectorView<T>;
+    };
+
+    template <class T>
+    struct expression_storage<Vec2<T>>
+    {
+        using type = Vec2<T>;
+    };
+
+    template <class T>
+    struct expression_storage<Vec3<T>>
+    {
+        using type = Vec3<T>;
+    };
+
+    template <class T>
+    struct expression_storage<Vec4<T>>
+    {
+        using type = Vec4<T>;
+    };
+
+    template <class Op, class L, class R>
+    struct expression_storage<VectorBinary<Op, L, R>>
+    {
+        using type = VectorBinary<Op, L, R>;
+    };
+
+    template <class Op, class E, class S>
+    struct expression_storage<VectorScalarRight<Op, E, S>>
+    {
+        using type = VectorScalarRight<Op, E, S>;
+    };
+
+    template <class Op, class S, class E>
+    struct expression_storage<VectorScalarLeft<Op, S, E>>
+    {
+        using type = VectorScalarLeft<Op, S, E>;
+    };
+
+    template <class Op, class L, class R>
+    class VectorBinary : public VectorExpression<VectorBinary<Op, L, R>>
+    {
+        typename expression_storage<L>::type lhs;
+        typename expression_storage<R>::type rhs;
+
+    public:
+        using value_type = decltype(Op()(std::declval<typename L::value_type>(), std::declval<typename R::value_type>()));
+
+        VectorBinary(const L &l, const R &r) : lhs(l), rhs(r)
+        {
+            if (l.size() != r.size())
+            {
+                throw std::runtime_error(Op::error);
+            }
+        }
+
+        size_t size() const { return lhs.size(); }
+        value_type at_unchecked(size_t index) const { return Op()(lhs.at_unchecked(index), rhs.at_unchecked(index)); }
+        value_type operator[](size_t index) const { return at_unchecked(index); }
+    };
+
+    template <class Op, class E, class S>
+    class VectorScalarRight : public VectorExpression<VectorScalarRight<Op, E, S>>
+    {
+        typename expression_storage<E>::type expr;
+        S scalar;
+
+    public:
+        using value_type = decltype(Op()(std::declval<typename E::value_type>(), std::declval<S>()));
+
+        VectorScalarRight(const E &e, const S &s) : expr(e), scalar(s) {}
+
+        size_t size() const { return expr.size(); }
+        value_type at_unchecked(size_t index) const { return Op()(expr.at_unchecked(index), scalar); }
+        value_type operator[](size_t index) const { return at_unchecked(index); }
+    };
+
+    template <class Op, class S, class E>
+    class VectorScalarLeft : public VectorExpression<VectorScalarLeft<Op, S, E>>
+    {
+        S scalar;
+        typename expression_storage<E>::type expr;
+
+    public:
+        using value_type = decltype(Op()(std::declval<S>(), std::declval<typename E::value_type>()));
+
+        VectorScalarLeft(const S &s, const E &e) : scalar(s), expr(e) {}
+
+        size_t size() const { return expr.size(); }
+        value_type at_unchecked(size_t index) const { return Op()(scalar, expr.at_unchecked(index)); }
+        value_type operator[](size_t index) const { return at_unchecked(index); }
+    };
+
+}
@@ -0,0 +1,21 @@
+#include "Vector.hpp"
+#include "VectorView.hpp"
+
+// Explicit instantiations compiled into the atMath library; the matching
+// extern template declarations are at the end of each header.
+namespace atMath
+{
+    ATMATH_VECTOR_INSTANCES(template, float)
+    ATMATH_VECTOR_INSTANCES(template, double)
+    ATMATH_VECTOR_INSTANCES(template, int)
+    ATMATH_VECTOR_STORAGE_INSTANCES(template, Complex<int>)
+    ATMATH_VECTOR_STORAGE_INSTANCES(template, Complex<float>)
+    ATMATH_VECTOR_STORAGE_INSTANCES(template, Complex<double>)
+    ATMATH_VECTOR_STORAGE_INSTANCES(template, Quaternion<int>)
+    ATMATH_VECTOR_STORAGE_INSTANCES(template, Quaternion<float>)
+    ATMATH_VECTOR_STORAGE_INSTANCES(template, Quaternion<double>)
+
+    ATMATH_VECTOR_VIEW_INSTANCES(template, float)
+    ATMATH_VECTOR_VIEW_INSTANCES(template, double)
+    ATMATH_VECTOR_VIEW_INSTANCES(template, int)
+}
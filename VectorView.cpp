@@ -0,0 +1,207 @@
+#pragma once
+
+#include "VectorView.hpp"
+#include "Simd.hpp"
+#include <cmath>
+
+namespace atMath
+{
+
+    template <class T>
+    VectorView<T> VectorView<T>::subview(size_t start, size_t end) const
+    {
+        if (start > end || end > v_size)
+        {
+            throw std::runtime_error("Invalid start or end index.");
+        }
+        return VectorView<T>(v_data + static_cast<ptrdiff_t>(start) * v_stride, end - start, v_stride);
+    }
+
+    template <class T>
+    VectorView<T> VectorView<T>::slice(size_t start, size_t count, ptrdiff_t step) const
+    {
+        if (step <= 0)
+        {
+            throw std::runtime_error("Slice step must be positive.");
+        }
+        if (count != 0 && (start >= v_size || (count - 1) * static_cast<size_t>(step) >= v_size - start))
+        {
+            throw std::runtime_error("Slice exceeds the view.");
+        }
+        return VectorView<T>(v_data + static_cast<ptrdiff_t>(start) * v_stride, count, v_stride * step);
+    }
+
+    template <class T>
+    template <class E>
+    const VectorView<T> &VectorView<T>::assign(const VectorExpression<E> &e) const
+    {
+        static_assert(!std::is_const<T>::value, "Cannot write through a view of const elements");
+        const E &expr = e.self();
+        if (v_size != expr.size())
+        {
+            throw std::runtime_error("Vectors must be the same size to assign.");
+        }
+        for (size_t i = 0; i < v_size; i++)
+        {
+            at_unchecked(i) = static_cast<value_type>(expr.at_unchecked(i));
+        }
+        return *this;
+    }
+
+    template <class T>
+    template <class E>
+    const VectorView<T> &VectorView<T>::operator+=(const VectorExpression<E> &e) const
+    {
+        static_assert(!std::is_const<T>::value, "Cannot write through a view of const elements");
+        const E &expr = e.self();
+        if (v_size != expr.size())
+        {
+            throw std::runtime_error("Vectors must be the same size to add.");
+        }
+        for (size_t i = 0; i < v_size; i++)
+        {
+            at_unchecked(i) += static_cast<value_type>(expr.at_unchecked(i));
+        }
+        return *this;
+    }
+
+    template <class T>
+    template <class E>
+    const VectorView<T> &VectorView<T>::operator-=(const VectorExpression<E> &e) const
+    {
+        static_assert(!std::is_const<T>::value, "Cannot write through a view of const elements");
+        const E &expr = e.self();
+        if (v_size != expr.size())
+        {
+            throw std::runtime_error("Vectors must be the same size to subtract.");
+        }
+        for (size_t i = 0; i < v_size; i++)
+        {
+            at_unchecked(i) -= static_cast<value_type>(expr.at_unchecked(i));
+        }
+        return *this;
+    }
+
+    template <class T>
+    template <class U>
+    const VectorView<T> &VectorView<T>::operator*=(const U &value) const
+    {
+        static_assert(!std::is_const<T>::value, "Cannot write through a view of const elements");
+        if constexpr (std::is_same<value_type, U>::value)
+        {
+            if (is_contiguous())
+            {
+                simd::scale(v_data, value, v_size);
+                return *this;
+            }
+        }
+        for (size_t i = 0; i < v_size; i++)
+        {
+            at_unchecked(i) *= value;
+        }
+        return *this;
+    }
+
+    template <class T>
+    template <class U>
+    const VectorView<T> &VectorView<T>::operator/=(const U &value) const
+    {
+        static_assert(!std::is_const<T>::value, "Cannot write through a view of const elements");
+        for (size_t i = 0; i < v_size; i++)
+        {
+            at_unchecked(i) /= value;
+        }
+        return *this;
+    }
+
+    template <class T>
+    auto VectorView<T>::sum() const -> value_type
+    {
+        if (is_contiguous())
+        {
+            return simd::sum(static_cast<const value_type *>(v_data), v_size);
+        }
+        value_type result = 0;
+        for (size_t i = 0; i < v_size; i++)
+        {
+            result += at_unchecked(i);
+        }
+        return result;
+    }
+
+    template <class T>
+    template <class E>
+    auto VectorView<T>::dot(const VectorExpression<E> &e) const -> decltype(std::declval<value_type>() * std::declval<typename E::value_type>())
+    {
+        const E &expr = e.self();
+        if (v_size != expr.size())
+        {
+            throw std::runtime_error("Vectors must be the same size to take the dot product.");
+        }
+        if constexpr (std::is_same<typename E::value_type, value_type>::value)
+        {
+            // Contiguous operands of the same type go to the SIMD kernel.
+            if constexpr (std::is_same<E, Vector<value_type>>::value)
+            {
+                if (is_contiguous())
+                {
+                    return simd::dot(static_cast<const value_type *>(v_data), expr.data(), v_size);
+                }
+            }
+            else if constexpr (std::is_same<E, VectorView<value_type>>::value || std::is_same<E, VectorView<const value_type>>::value)
+            {
+                if (is_contiguous() && expr.is_contiguous())
+                {
+                    return simd::dot(static_cast<const value_type *>(v_data), static_cast<const value_type *>(expr.data()), v_size);
+                }
+            }
+        }
+        decltype(std::declval<value_type>() * std::declval<typename E::value_type>()) result = 0;
+        for (size_t i = 0; i < v_size; i++)
+        {
+            result += at_unchecked(i) * expr.at_unchecked(i);
+        }
+        return result;
+    }
+
+    template <class T>
+    double VectorView<T>::magnitude() const
+    {
+        return sqrt(dot(*this));
+    }
+
+    template <class T>
+    template <class V>
+    auto VectorView<T>::normalize() const -> Vector<decltype(std::declval<V>() / std::declval<double>())>
+    {
+        return Vector<decltype(std::declval<value_type>() / magnitude())>(*this / magnitude());
+    }
+
+    template <class U, class T>
+    VectorView<U> reinterpret_view(const VectorView<T> &v)
+    {
+        using From = scalar_layout<std::remove_const_t<T>>;
+        using To = scalar_layout<std::remove_const_t<U>>;
+        static_assert(std::is_same<typename From::type, typename To::type>::value, "reinterpret_view needs element types built from the same scalar");
+        static_assert(std::is_const<U>::value || !std::is_const<T>::value, "reinterpret_view cannot drop const");
+        U *data = reinterpret_cast<U *>(v.data());
+        if (From::components == To::components)
+        {
+            return VectorView<U>(data, v.size(), v.stride());
+        }
+        size_t scalars = v.size() * From::components;
+        if (!v.is_contiguous() || scalars % To::components != 0)
+        {
+            throw std::runtime_error("View cannot be reinterpreted as the requested element type.");
+        }
+        return VectorView<U>(data, scalars / To::components);
+    }
+
+    template <class U, class C, class>
+    auto reinterpret_view(C &container) -> VectorView<std::conditional_t<std::is_const<std::remove_pointer_t<decltype(container.data())>>::value, const U, U>>
+    {
+        using Element = std::remove_pointer_t<decltype(container.data())>;
+        using Target = std::conditional_t<std::is_const<Element>::value, const U, U>;
+        return reinterpret_view<Target>(VectorView<Element>(container.data(), container.size()));
+    }
+}
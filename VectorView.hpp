@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include "Vector.hpp"
+
+namespace atMath
+{
+
+    // Non-owning window onto elements stored elsewhere: a Vector, a
+    // std::vector, a raw buffer, or a slice of any of those. The view may be
+    // strided, e.g. every other sample or one channel of an interleaved
+    // recording. VectorView<const T> is read-only.
+    //
+    // A view is a VectorExpression, so it can be combined with Vectors and
+    // other views in arithmetic and converted to a Vector, which copies.
+    // Copying or assigning a view rebinds it; use assign() and the compound
+    // operators to write through it.
+    template <class T>
+    class VectorView : public VectorExpression<VectorView<T>>
+    {
+        T *v_data;
+        size_t v_size;
+        ptrdiff_t v_stride;
+
+    public:
+        using value_type = std::remove_const_t<T>;
+
+        class iterator
+        {
+            T *ptr;
+            ptrdiff_t stride;
+
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::remove_const_t<T>;
+            using difference_type = ptrdiff_t;
+            using pointer = T *;
+            using reference = T &;
+
+            iterator(T *ptr, ptrdiff_t stride) : ptr(ptr), stride(stride) {}
+            T &operator*() const { return *ptr; }
+            T *operator->() const { return ptr; }
+            iterator &operator++()
+            {
+                ptr += stride;
+                return *this;
+            }
+            iterator operator++(int)
+            {
+                iterator old = *this;
+                ptr += stride;
+                return old;
+            }
+            bool operator==(const iterator &other) const { return ptr == other.ptr; }
+            bool operator!=(const iterator &other) const { return ptr != other.ptr; }
+        };
+
+        VectorView() : v_data(nullptr), v_size(0), v_stride(1) {}
+        // stride is in elements and must be positive; Vector's in-place
+        // assignment relies on every view stepping forwards.
+        VectorView(T *data, size_t size, ptrdiff_t stride = 1) : v_data(data), v_size(size), v_stride(stride)
+        {
+            if (stride <= 0)
+            {
+                throw std::runtime_error("View stride must be positive.");
+            }
+        }
+        template <class U, class = std::enable_if_t<std::is_convertible<U *, T *>::value>>
+        VectorView(const VectorView<U> &v) : v_data(v.data()), v_size(v.size()), v_stride(v.stride()) {}
+
+        // Any contiguous container exposing data() and size(): Vector,
+        // std::vector, std::array, Vec2/Vec3/Vec4, ...
+        template <class C, class = std::enable_if_t<!std::is_base_of<VectorView<T>, std::remove_cv_t<C>>::value && std::is_convertible<decltype(std::declval<C &>().data()), T *>::value>>
+        VectorView(C &container) : v_data(container.data()), v_size(container.size()), v_stride(1) {}
+
+        size_t size() const { return v_size; }
+        ptrdiff_t stride() const { return v_stride; }
+        bool is_contiguous() const { return v_stride == 1; }
+        T *data() const { return v_data; }
+
+        T &operator[](size_t index) const
+        {
+#if ATMATH_BOUNDS_CHECK
+            if (index >= v_size)
+            {
+                throw std::out_of_range("Index out of bounds.");
+            }
+#endif
+            return v_data[static_cast<ptrdiff_t>(index) * v_stride];
+        }
+        T &at_unchecked(size_t index) const { return v_data[static_cast<ptrdiff_t>(index) * v_stride]; }
+
+        iterator begin() const { return iterator(v_data, v_stride); }
+        iterator end() const { return iterator(v_data + static_cast<ptrdiff_t>(v_size) * v_stride, v_stride); }
+
+        VectorView<T> subview(size_t start, size_t end) const;
+        VectorView<T> slice(size_t start, size_t count, ptrdiff_t step) const;
+
+        template <class E>
+        const VectorView<T> &assign(const VectorExpression<E> &e) const;
+        template <class E>
+        const VectorView<T> &operator+=(const VectorExpression<E> &e) const;
+        template <class E>
+        const VectorView<T> &operator-=(const VectorExpression<E> &e) const;
+        template <class U>
+        const VectorView<T> &operator*=(const U &value) const;
+        template <class U>
+        const VectorView<T> &operator/=(const U &value) const;
+
+        value_type sum() const;
+        template <class E>
+        auto dot(const VectorExpression<E> &e) const -> decltype(std::declval<value_type>() * std::declval<typename E::value_type>());
+        double magnitude() const;
+        // A template so views of element types without a division by double,
+        // such as std::complex<float>, can still be formed.
+        template <class V = value_type>
+        auto normalize() const -> Vector<decltype(std::declval<V>() / std::declval<double>())>;
+
+        friend std::ostream &operator<<(std::ostream &os, const VectorView<T> &v)
+        {
+            os << std::fixed << std::setprecision(3);
+            os << "[";
+            for (size_t i = 0; i < v.size(); i++)
+            {
+                os << v.at_unchecked(i);
+                if (i + 1 != v.size())
+                {
+                    os << ", ";
+                }
+            }
+            os << "]";
+            return os;
+        }
+    };
+
+    // Element types that are laid out as an array of one scalar type:
+    // arithmetic T is T[1], Complex<S> and std::complex<S> are S[2] and
+    // Quaternion<S> is S[4].
+    template <class T, class = void>
+    struct scalar_layout
+    {
+    };
+    template <class T>
+    struct scalar_layout<T, std::enable_if_t<std::is_arithmetic<T>::value>>
+    {
+        using type = T;
+        static constexpr size_t components = 1;
+    };
+    template <class S>
+    struct scalar_layout<Complex<S>>
+    {
+        using type = S;
+        static constexpr size_t components = 2;
+    };
+    template <class S>
+    struct scalar_layout<std::complex<S>>
+    {
+        using type = S;
+        static constexpr size_t components = 2;
+    };
+    template <class S>
+    struct scalar_layout<Quaternion<S>>
+    {
+        using type = S;
+        static constexpr size_t components = 4;
+    };
+
+    template <class T>
+    struct is_vector_view : std::false_type
+    {
+    };
+    template <class T>
+    struct is_vector_view<VectorView<T>> : std::true_type
+    {
+    };
+
+    // Views the same memory with another element type built from the same
+    // scalar, without copying: Vector<Complex<float>> as float* or
+    // std::complex<float>*, a std::vector<std::complex<double>> as
+    // Complex<double>, interleaved floats as Quaternion<float>, ...
+    // Equal-sized elements keep the stride. Otherwise the view must be
+    // contiguous and cover a whole number of target elements, or
+    // std::runtime_error is thrown. U may not drop the constness of T.
+    template <class U, class T>
+    VectorView<U> reinterpret_view(const VectorView<T> &v);
+    // Same, for any contiguous container with data() and size().
+    template <class U, class C, class = std::enable_if_t<!is_vector_view<std::remove_cv_t<C>>::value>>
+    auto reinterpret_view(C &container) -> VectorView<std::conditional_t<std::is_const<std::remove_pointer_t<decltype(container.data())>>::value, const U, U>>;
+
+}
+
+// Definitions; see the end of Vector.hpp for ATMATH_EXTERN_TEMPLATES.
+#include "VectorView.cpp"
+
+#define ATMATH_VECTOR_VIEW_INSTANCES(PREFIX, T)                              \
+    PREFIX class VectorView<T>;                                              \
+    PREFIX class VectorView<const T>;
+
+#if ATMATH_EXTERN_TEMPLATES
+namespace atMath
+{
+    ATMATH_VECTOR_VIEW_INSTANCES(extern template, float)
+    ATMATH_VECTOR_VIEW_INSTANCES(extern template, double)
+    ATMATH_VECTOR_VIEW_INSTANCES(extern template, int)
+}
+#endif
@@ -1,7 +1,11 @@
 #pragma once
+#include <cmath>
+#include <stdexcept>
+#include <type_traits>
 #include "Vector.hpp"
 #include "Complex.hpp"
 #include "Quaternion.hpp"
+#include "UnitQuaternion.hpp"
 
 
 namespace atMath{
@@ -9,47 +13,124 @@ namespace atMath{
     template <class T>
     class Vector;
 
+    // Vec2, Vec3 and Vec4 are fixed-size vectors stored inline: no heap buffer,
+    // no size field, just the components, so they are trivially copyable for
+    // arithmetic T and can be packed densely in large arrays. The components
+    // are also reachable through operator[], which checks the index while
+    // ATMATH_BOUNDS_CHECK is set (see Vector.hpp).
+    //
+    // They are VectorExpressions, so they convert to Vector<T> and can be
+    // mixed with Vector operands in expressions. Arithmetic between two fixed
+    // vectors of the same dimension stays fixed-size.
     template <class T>
-    class Vec2 : public Vector<T>
+    class Vec2 : public VectorExpression<Vec2<T>>
     {
     public:
-        T &x = Vector<T>::operator[](0);
-        T &y = Vector<T>::operator[](1);
-        Vec2() : Vector<T>(2) {}
-        Vec2(T x_, T y_) : Vector<T>(2)
+        using value_type = T;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        T x;
+        T y;
+
+        Vec2() : x(), y() {}
+        Vec2(T x_, T y_) : x(x_), y(y_) {}
+        template <class U>
+        Vec2(const Vec2<U> &v) : x(static_cast<T>(v.x)), y(static_cast<T>(v.y)) {}
+        template <class E>
+        Vec2(const VectorExpression<E> &e)
         {
-            Vector<T>::operator[](0) = x_;
-            Vector<T>::operator[](1) = y_;
+            const E &expr = e.self();
+            if (expr.size() != 2)
+            {
+                throw std::runtime_error("Vector must have 2 elements to convert to Vec2.");
+            }
+            x = static_cast<T>(expr.at_unchecked(0));
+            y = static_cast<T>(expr.at_unchecked(1));
         }
-        Vec2(const Vector<T> &v) : Vector<T>(v) {}
-        template <class U>
-        Vec2(const Vector<U> &v) : Vector<T>(v) {}
-        Vec2(std::initializer_list<T> list) : Vector<T>(list) {}
-        Vec2(const Complex<T> &c) : Vector<T>(c) {}
-        void setX(T x) { Vector<T>::operator[](0) = x; }
-        void setY(T y) { Vector<T>::operator[](1) = y; }
+        Vec2(std::initializer_list<T> list)
+        {
+            if (list.size() != 2)
+            {
+                throw std::runtime_error("Vec2 requires 2 elements.");
+            }
+            x = list.begin()[0];
+            y = list.begin()[1];
+        }
+        Vec2(const Complex<T> &c) : x(c.real), y(c.imag) {}
+
+        static constexpr size_t size() { return 2; }
+
+        T &operator[](size_t index)
+        {
+#if ATMATH_BOUNDS_CHECK
+            if (index >= 2)
+            {
+                throw std::out_of_range("Index out of bounds.");
+            }
+#endif
+            return at_unchecked(index);
+        }
+        const T &operator[](size_t index) const { return const_cast<Vec2<T> *>(this)->operator[](index); }
+        // Picks the member by name rather than indexing from &x, which would
+        // step across separate objects; any index past the end gives y.
+        T &at_unchecked(size_t index)
+        {
+            switch (index)
+            {
+            case 0:
+                return x;
+            default:
+                return y;
+            }
+        }
+        const T &at_unchecked(size_t index) const { return const_cast<Vec2<T> *>(this)->at_unchecked(index); }
+        T *data() { return &x; }
+        const T *data() const { return &x; }
+        iterator begin() { return data(); }
+        iterator end() { return data() + 2; }
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + 2; }
+
+        void setX(T x) { this->x = x; }
+        void setY(T y) { this->y = y; }
 
         Vec2<T> &operator=(const Complex<T> &c)
         {
-            Vector<T>::operator[](0) = c.real;
-            Vector<T>::operator[](1) = c.imag;
+            x = c.real;
+            y = c.imag;
             return *this;
         }
 
         template <class U>
         Vec2<T> &operator=(const Complex<U> &c)
         {
-            Vector<T>::operator[](0) = static_cast<T>(c.real);
-            Vector<T>::operator[](1) = static_cast<T>(c.imag);
-            return *this;  
+            x = static_cast<T>(c.real);
+            y = static_cast<T>(c.imag);
+            return *this;
+        }
+
+        template <class U>
+        auto dot(const Vec2<U> &v) const -> decltype(x * v.x) { return x * v.x + y * v.y; }
+        T sum() const { return x + y; }
+        double magnitude() const { return std::sqrt(dot(*this)); }
+        auto normalize() const -> Vec2<decltype(x / magnitude())>
+        {
+            double mag = magnitude();
+            return Vec2<decltype(x / magnitude())>(x / mag, y / mag);
         }
 
         Vec2<T> rotate(double angle, bool deg = false) const;
 
-    
+        friend std::ostream &operator<<(std::ostream &os, const Vec2<T> &v)
+        {
+            os << std::fixed << std::setprecision(3);
+            os << "[" << v.x << ", " << v.y << "]";
+            return os;
+        }
     };
 
-    template <class T, class U> 
+    template <class T, class U>
     auto operator*(const Complex<T> &c, const Vec2<U> &v) -> Vec2<decltype(c.real * v[0])>
     {
         Vec2<decltype(c.real * v[0])> result;
@@ -65,48 +146,138 @@ namespace atMath{
     }
 
     template <class T>
-    class Vec3 : public Vector<T>
+    class Vec3 : public VectorExpression<Vec3<T>>
     {
     public:
-        T &x = Vector<T>::operator[](0);
-        T &y = Vector<T>::operator[](1);
-        T &z = Vector<T>::operator[](2);
-        Vec3() : Vector<T>(3)
+        using value_type = T;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        T x;
+        T y;
+        T z;
+
+        Vec3() : x(), y(), z() {}
+        Vec3(T x_, T y_, T z_) : x(x_), y(y_), z(z_) {}
+        template <class U>
+        Vec3(const Vec3<U> &v) : x(static_cast<T>(v.x)), y(static_cast<T>(v.y)), z(static_cast<T>(v.z)) {}
+        template <class E>
+        Vec3(const VectorExpression<E> &e)
         {
+            const E &expr = e.self();
+            if (expr.size() != 3)
+            {
+                throw std::runtime_error("Vector must have 3 elements to convert to Vec3.");
+            }
+            x = static_cast<T>(expr.at_unchecked(0));
+            y = static_cast<T>(expr.at_unchecked(1));
+            z = static_cast<T>(expr.at_unchecked(2));
         }
-        Vec3(T x_, T y_, T z_) : Vector<T>(3)
+        Vec3(std::initializer_list<T> list)
         {
-            Vector<T>::operator[](0) = x_;
-            Vector<T>::operator[](1) = y_;
-            Vector<T>::operator[](2) = z_;
+            if (list.size() != 3)
+            {
+                throw std::runtime_error("Vec3 requires 3 elements.");
+            }
+            x = list.begin()[0];
+            y = list.begin()[1];
+            z = list.begin()[2];
         }
-        Vec3(const Vector<T> &v) : Vector<T>(v) {}
+
+        static constexpr size_t size() { return 3; }
+
+        T &operator[](size_t index)
+        {
+#if ATMATH_BOUNDS_CHECK
+            if (index >= 3)
+            {
+                throw std::out_of_range("Index out of bounds.");
+            }
+#endif
+            return at_unchecked(index);
+        }
+        const T &operator[](size_t index) const { return const_cast<Vec3<T> *>(this)->operator[](index); }
+        T &at_unchecked(size_t index)
+        {
+            switch (index)
+            {
+            case 0:
+                return x;
+            case 1:
+                return y;
+            default:
+                return z;
+            }
+        }
+        const T &at_unchecked(size_t index) const { return const_cast<Vec3<T> *>(this)->at_unchecked(index); }
+        T *data() { return &x; }
+        const T *data() const { return &x; }
+        iterator begin() { return data(); }
+        iterator end() { return data() + 3; }
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + 3; }
+
+        void setX(T x) { this->x = x; }
+        void setY(T y) { this->y = y; }
+        void setZ(T z) { this->z = z; }
+
+        template <class U>
+        auto dot(const Vec3<U> &v) const -> decltype(x * v.x) { return x * v.x + y * v.y + z * v.z; }
         template <class U>
-        Vec3(const Vector<U> &v) : Vector<T>(v) {}
-        Vec3(std::initializer_list<T> list) : Vector<T>(list) {}
-        void setX(T x) { Vector<T>::operator[](0) = x; }
-        void setY(T y) { Vector<T>::operator[](1) = y; }
-        void setZ(T z) { Vector<T>::operator[](2) = z; }
+        auto cross(const Vec3<U> &v) const -> Vec3<decltype(x * v.x)>
+        {
+            return Vec3<decltype(x * v.x)>(y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x);
+        }
+        template <class U>
+        auto operator^(const Vec3<U> &v) const -> Vec3<decltype(x * v.x)> { return cross(v); }
+        T sum() const { return x + y + z; }
+        double magnitude() const { return std::sqrt(dot(*this)); }
+        auto normalize() const -> Vec3<decltype(x / magnitude())>
+        {
+            double mag = magnitude();
+            return Vec3<decltype(x / magnitude())>(x / mag, y / mag, z / mag);
+        }
 
         Quaternion<T> toQuaternion() const{
             return Quaternion<T>(0,x,y,z);
         }
 
-        static Quaternion<T> rotate(const Vec3<T> &axis, const double &angle){
-            Vec3<double> axis_norm = axis.normalize();
-            double s = sin(angle / 2);
-            double c = cos(angle / 2);
-            return Quaternion<T>(c, s * axis_norm.x, s * axis_norm.y, s * axis_norm.z);
-
+        static UnitQuaternion<T> rotate(const Vec3<T> &axis, const double &angle){
+            return UnitQuaternion<T>::from_axis_angle(axis.x, axis.y, axis.z, angle);
         }
 
+        friend std::ostream &operator<<(std::ostream &os, const Vec3<T> &v)
+        {
+            os << std::fixed << std::setprecision(3);
+            os << "[" << v.x << ", " << v.y << ", " << v.z << "]";
+            return os;
+        }
     };
 
-    template <class T, class U> 
+    // q v q^-1 without forming either product: with u the vector part of q,
+    // v' = v + w t + u x t where t = 2 (u x v) / |q|^2.
+    template <class T, class U>
     auto operator*(const Quaternion<T> &q, const Vec3<U> &v) -> Vec3<decltype(q.real * v[0])>{
-        Quaternion<U> q_u(0,v.x,v.y,v.z);
-        Quaternion<decltype(q.real * v[0])> q_v = q * q_u * q.inverse();
-        return Vec3<decltype(q.real * v[0])>(q_v.i,q_v.j,q_v.k);
+        using R = decltype(1.f * q.real * v[0]);
+        R s = 2 / static_cast<R>(q.modulus_squared());
+        R tx = s * (q.j * v.z - q.k * v.y);
+        R ty = s * (q.k * v.x - q.i * v.z);
+        R tz = s * (q.i * v.y - q.j * v.x);
+        return Vec3<decltype(q.real * v[0])>(v.x + q.real * tx + (q.j * tz - q.k * ty),
+                                              v.y + q.real * ty + (q.k * tx - q.i * tz),
+                                              v.z + q.real * tz + (q.i * ty - q.j * tx));
+    }
+    // Unit length is known, so the 1/|q|^2 factor drops out:
+    // v' = v + 2w (u x v) + 2 u x (u x v).
+    template <class T, class U>
+    auto operator*(const UnitQuaternion<T> &q, const Vec3<U> &v) -> Vec3<decltype(q.real * v[0])>{
+        using R = decltype(q.real * v[0]);
+        R tx = 2 * (q.j * v.z - q.k * v.y);
+        R ty = 2 * (q.k * v.x - q.i * v.z);
+        R tz = 2 * (q.i * v.y - q.j * v.x);
+        return Vec3<R>(v.x + q.real * tx + (q.j * tz - q.k * ty),
+                       v.y + q.real * ty + (q.k * tx - q.i * tz),
+                       v.z + q.real * tz + (q.i * ty - q.j * tx));
     }
     template <class T, class U>
     auto operator*(const Vec3<U> &v, const Quaternion<T> &q) -> Vec3<decltype(v[0] * q.real)>{
@@ -114,30 +285,197 @@ namespace atMath{
     }
 
     template <class T>
-    class Vec4 : public Vector<T>
+    class Vec4 : public VectorExpression<Vec4<T>>
     {
     public:
-        T &x = Vector<T>::operator[](0);
-        T &y = Vector<T>::operator[](1);
-        T &z = Vector<T>::operator[](2);
-        T &w = Vector<T>::operator[](3);
-        Vec4() : Vector<T>(4) {}
-        Vec4(T x_, T y_, T z_, T w_) : Vector<T>(4)
-        {
-            Vector<T>::operator[](0) = x_;
-            Vector<T>::operator[](1) = y_;
-            Vector<T>::operator[](2) = z_;
-            Vector<T>::operator[](3) = w_;
-        }
-        Vec4(const Vector<T> &v) : Vector<T>(v) {}
+        using value_type = T;
+        using iterator = T *;
+        using const_iterator = const T *;
+
+        T x;
+        T y;
+        T z;
+        T w;
+
+        Vec4() : x(), y(), z(), w() {}
+        Vec4(T x_, T y_, T z_, T w_) : x(x_), y(y_), z(z_), w(w_) {}
+        template <class U>
+        Vec4(const Vec4<U> &v) : x(static_cast<T>(v.x)), y(static_cast<T>(v.y)), z(static_cast<T>(v.z)), w(static_cast<T>(v.w)) {}
+        template <class E>
+        Vec4(const VectorExpression<E> &e)
+        {
+            const E &expr = e.self();
+            if (expr.size() != 4)
+            {
+                throw std::runtime_error("Vector must have 4 elements to convert to Vec4.");
+            }
+            x = static_cast<T>(expr.at_unchecked(0));
+            y = static_cast<T>(expr.at_unchecked(1));
+            z = static_cast<T>(expr.at_unchecked(2));
+            w = static_cast<T>(expr.at_unchecked(3));
+        }
+        Vec4(std::initializer_list<T> list)
+        {
+            if (list.size() != 4)
+            {
+                throw std::runtime_error("Vec4 requires 4 elements.");
+            }
+            x = list.begin()[0];
+            y = list.begin()[1];
+            z = list.begin()[2];
+            w = list.begin()[3];
+        }
+
+        static constexpr size_t size() { return 4; }
+
+        T &operator[](size_t index)
+        {
+#if ATMATH_BOUNDS_CHECK
+            if (index >= 4)
+            {
+                throw std::out_of_range("Index out of bounds.");
+            }
+#endif
+            return at_unchecked(index);
+        }
+        const T &operator[](size_t index) const { return const_cast<Vec4<T> *>(this)->operator[](index); }
+        T &at_unchecked(size_t index)
+        {
+            switch (index)
+            {
+            case 0:
+                return x;
+            case 1:
+                return y;
+            case 2:
+                return z;
+            default:
+                return w;
+            }
+        }
+        const T &at_unchecked(size_t index) const { return const_cast<Vec4<T> *>(this)->at_unchecked(index); }
+        T *data() { return &x; }
+        const T *data() const { return &x; }
+        iterator begin() { return data(); }
+        iterator end() { return data() + 4; }
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + 4; }
+
+        void setX(T x) { this->x = x; }
+        void setY(T y) { this->y = y; }
+        void setZ(T z) { this->z = z; }
+        void setW(T w) { this->w = w; }
+
         template <class U>
-        Vec4(const Vector<U> &v) : Vector<T>(v) {}
-        Vec4(std::initializer_list<T> list) : Vector<T>(list) {}
-        void setX(T x) { Vector<T>::operator[](0) = x; }
-        void setY(T y) { Vector<T>::operator[](1) = y; }
-        void setZ(T z) { Vector<T>::operator[](2) = z; }
-        void setW(T w) { Vector<T>::operator[](3) = w; }
+        auto dot(const Vec4<U> &v) const -> decltype(x * v.x) { return x * v.x + y * v.y + z * v.z + w * v.w; }
+        T sum() const { return x + y + z + w; }
+        double magnitude() const { return std::sqrt(dot(*this)); }
+        auto normalize() const -> Vec4<decltype(x / magnitude())>
+        {
+            double mag = magnitude();
+            return Vec4<decltype(x / magnitude())>(x / mag, y / mag, z / mag, w / mag);
+        }
 
+        friend std::ostream &operator<<(std::ostream &os, const Vec4<T> &v)
+        {
+            os << std::fixed << std::setprecision(3);
+            os << "[" << v.x << ", " << v.y << ", " << v.z << ", " << v.w << "]";
+            return os;
+        }
     };
 
-}
\ No newline at end of file
+    template <class V>
+    struct is_fixed_vector : std::false_type {};
+    template <class T>
+    struct is_fixed_vector<Vec2<T>> : std::true_type {};
+    template <class T>
+    struct is_fixed_vector<Vec3<T>> : std::true_type {};
+    template <class T>
+    struct is_fixed_vector<Vec4<T>> : std::true_type {};
+
+    // Same-dimension arithmetic on fixed vectors returns a fixed vector rather
+    // than a VectorExpression; these overloads are exact matches and win over
+    // the generic ones in Vector.hpp.
+    template <template <class> class V, class T, class U>
+    auto operator+(const V<T> &v1, const V<U> &v2) -> std::enable_if_t<is_fixed_vector<V<T>>::value, V<decltype(v1[0] + v2[0])>>
+    {
+        V<decltype(v1[0] + v2[0])> result;
+        for (size_t i = 0; i < V<T>::size(); i++)
+        {
+            result[i] = v1[i] + v2[i];
+        }
+        return result;
+    }
+
+    template <template <class> class V, class T, class U>
+    auto operator-(const V<T> &v1, const V<U> &v2) -> std::enable_if_t<is_fixed_vector<V<T>>::value, V<decltype(v1[0] - v2[0])>>
+    {
+        V<decltype(v1[0] - v2[0])> result;
+        for (size_t i = 0; i < V<T>::size(); i++)
+        {
+            result[i] = v1[i] - v2[i];
+        }
+        return result;
+    }
+
+    template <template <class> class V, class T, class U>
+    auto operator*(const V<T> &v1, const V<U> &v2) -> std::enable_if_t<is_fixed_vector<V<T>>::value, decltype(v1[0] * v2[0])>
+    {
+        return v1.dot(v2);
+    }
+
+    template <template <class> class V, class T, class U>
+    auto operator*(const V<T> &v, const U &value) -> std::enable_if_t<is_fixed_vector<V<T>>::value && std::is_arithmetic<U>::value, V<decltype(v[0] * value)>>
+    {
+        V<decltype(v[0] * value)> result;
+        for (size_t i = 0; i < V<T>::size(); i++)
+        {
+            result[i] = v[i] * value;
+        }
+        return result;
+    }
+
+    template <template <class> class V, class T, class U>
+    auto operator*(const U &value, const V<T> &v) -> std::enable_if_t<is_fixed_vector<V<T>>::value && std::is_arithmetic<U>::value, V<decltype(value * v[0])>>
+    {
+        return v * value;
+    }
+
+    template <template <class> class V, class T, class U>
+    auto operator/(const V<T> &v, const U &value) -> std::enable_if_t<is_fixed_vector<V<T>>::value && std::is_arithmetic<U>::value, V<decltype(v[0] / value)>>
+    {
+        V<decltype(v[0] / value)> result;
+        for (size_t i = 0; i < V<T>::size(); i++)
+        {
+            result[i] = v[i] / value;
+        }
+        return result;
+    }
+
+    template <template <class> class V, class T, class U>
+    auto operator==(const V<T> &v1, const V<U> &v2) -> std::enable_if_t<is_fixed_vector<V<T>>::value, bool>
+    {
+        float epsilon = 0.0001;
+        for (size_t i = 0; i < V<T>::size(); i++)
+        {
+            if (std::abs(v1[i] - v2[i]) > epsilon)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <template <class> class V, class T, class U>
+    auto operator!=(const V<T> &v1, const V<U> &v2) -> std::enable_if_t<is_fixed_vector<V<T>>::value, bool>
+    {
+        return !(v1 == v2);
+    }
+
+    static_assert(sizeof(Vec2<float>) == 2 * sizeof(float), "Vec2 must not carry storage beyond its components");
+    static_assert(sizeof(Vec3<float>) == 3 * sizeof(float), "Vec3 must not carry storage beyond its components");
+    static_assert(sizeof(Vec4<float>) == 4 * sizeof(float), "Vec4 must not carry storage beyond its components");
+    static_assert(std::is_trivially_copyable<Vec3<float>>::value, "Vec3 of an arithmetic type must be trivially copyable");
+    static_assert(std::is_standard_layout<Vec3<float>>::value, "Vec3 must be standard-layout so that data() is the address of x");
+
+}
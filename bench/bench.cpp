@@ -0,0 +1,655 @@
+// Microbenchmarks for the atMath hot paths. Each benchmark is a function
+// taking a State, registered for a set of element types and sizes in the
+// style of Google Benchmark, but without the dependency:
+//
+//     atmath_bench [--filter=substring] [--min-time=seconds] [--out=path]
+//
+// Results go to stdout as a table and to --out (default bench_output.txt)
+// as tab-separated values with a header line, one row per benchmark run.
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+
+namespace bench
+{
+
+    // Iteration control for one run: the body loops while keep_running()
+    // returns true and reports how much work each iteration did. The clock
+    // starts on the first keep_running() call and stops on the last, so the
+    // setup before the loop and the teardown after it are not timed.
+    class State
+    {
+        using clock = std::chrono::steady_clock;
+
+        size_t s_size;
+        size_t s_iterations;
+        size_t s_done = 0;
+        size_t s_items = 0;
+        size_t s_bytes = 0;
+        clock::time_point s_start;
+        double s_seconds = 0;
+        bool s_timing = false;
+
+    public:
+        State(size_t size, size_t iterations) : s_size(size), s_iterations(iterations) {}
+
+        bool keep_running()
+        {
+            if (s_done == 0)
+            {
+                resume_timing();
+            }
+            if (s_done++ < s_iterations)
+            {
+                return true;
+            }
+            pause_timing();
+            return false;
+        }
+        size_t size() const { return s_size; }
+        size_t iterations() const { return s_iterations; }
+
+        // Excludes per-iteration setup from the timing.
+        void pause_timing()
+        {
+            if (s_timing)
+            {
+                s_seconds += std::chrono::duration<double>(clock::now() - s_start).count();
+                s_timing = false;
+            }
+        }
+        void resume_timing()
+        {
+            if (!s_timing)
+            {
+                s_start = clock::now();
+                s_timing = true;
+            }
+        }
+        double seconds() const { return s_seconds; }
+
+        // Per-iteration work, for the items/s and bytes/s columns.
+        void set_items_per_iteration(size_t items) { s_items = items; }
+        void set_bytes_per_iteration(size_t bytes) { s_bytes = bytes; }
+        size_t items() const { return s_items; }
+        size_t bytes() const { return s_bytes; }
+    };
+
+    // Keeps the compiler from discarding a result or caching memory.
+    template <class T>
+    inline void do_not_optimize(const T &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    inline void clobber_memory()
+    {
+        asm volatile("" : : : "memory");
+    }
+
+    struct Benchmark
+    {
+        std::string name;
+        std::string type;
+        std::function<void(State &)> body;
+        std::vector<size_t> sizes;
+    };
+
+    inline std::vector<Benchmark> &registry()
+    {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    inline int register_benchmark(const char *name, const char *type, std::function<void(State &)> body, std::vector<size_t> sizes)
+    {
+        registry().push_back({name, type, std::move(body), std::move(sizes)});
+        return 0;
+    }
+
+    template <class T>
+    std::vector<T> random_values(size_t n, double low = -1, double high = 1)
+    {
+        static std::mt19937 generator(42);
+        std::uniform_real_distribution<double> distribution(low, high);
+        std::vector<T> values(n);
+        for (T &value : values)
+        {
+            value = static_cast<T>(distribution(generator) * (std::is_integral<T>::value ? 100 : 1));
+        }
+        return values;
+    }
+
+    struct Result
+    {
+        double seconds;
+        size_t iterations;
+        size_t items;
+        size_t bytes;
+    };
+
+    // Grows the iteration count from the last run's timing, at most tenfold
+    // per step, until one run lasts at least min_time seconds.
+    inline Result measure(const Benchmark &benchmark, size_t size, double min_time)
+    {
+        size_t iterations = 1;
+        while (true)
+        {
+            State state(size, iterations);
+            benchmark.body(state);
+            state.pause_timing();
+            double seconds = state.seconds();
+            if (seconds >= min_time || iterations >= (size_t(1) << 40))
+            {
+                return {seconds, iterations, state.items(), state.bytes()};
+            }
+            double estimate = seconds > 0 ? min_time * 1.4 / seconds * iterations : 10.0 * iterations;
+            iterations = std::max(iterations + 1, std::min(10 * iterations, size_t(estimate)));
+        }
+    }
+
+}
+
+#define ATMATH_BENCH_CONCAT_(a, b) a##b
+#define ATMATH_BENCH_CONCAT(a, b) ATMATH_BENCH_CONCAT_(a, b)
+
+// ATMATH_BENCHMARK(function, type, sizes...) runs function<type> once per size.
+#define ATMATH_BENCHMARK(FUNCTION, TYPE, ...)                                  \
+    static int ATMATH_BENCH_CONCAT(registered_, __LINE__) =                    \
+        bench::register_benchmark(#FUNCTION, #TYPE, FUNCTION<TYPE>, {__VA_ARGS__})
+
+using namespace atMath;
+using bench::State;
+
+// Vector ---------------------------------------------------------------------
+
+template <class T>
+void BM_VectorConstruct(State &state)
+{
+    while (state.keep_running())
+    {
+        Vector<T> v(state.size());
+        bench::do_not_optimize(v.data());
+    }
+    state.set_bytes_per_iteration(state.size() * sizeof(T));
+}
+
+template <class T>
+void BM_VectorCopy(State &state)
+{
+    std::vector<T> values = bench::random_values<T>(state.size());
+    Vector<T> source(values);
+    while (state.keep_running())
+    {
+        Vector<T> copy(source);
+        bench::do_not_optimize(copy.data());
+    }
+    state.set_bytes_per_iteration(state.size() * sizeof(T));
+}
+
+template <class T>
+void BM_VectorPushBack(State &state)
+{
+    while (state.keep_running())
+    {
+        Vector<T> v;
+        for (size_t i = 0; i < state.size(); i++)
+        {
+            v.push_back(static_cast<T>(i));
+        }
+        bench::do_not_optimize(v.data());
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+template <class T>
+void BM_VectorAppend(State &state)
+{
+    Vector<T> chunk(bench::random_values<T>(64));
+    while (state.keep_running())
+    {
+        Vector<T> v;
+        for (size_t i = 0; i < state.size(); i += chunk.size())
+        {
+            v.append(chunk);
+        }
+        bench::do_not_optimize(v.data());
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+template <class T>
+void BM_VectorDot(State &state)
+{
+    Vector<T> a(bench::random_values<T>(state.size()));
+    Vector<T> b(bench::random_values<T>(state.size()));
+    while (state.keep_running())
+    {
+        bench::do_not_optimize(a.dot(b));
+    }
+    state.set_items_per_iteration(state.size());
+    state.set_bytes_per_iteration(2 * state.size() * sizeof(T));
+}
+
+template <class T>
+void BM_VectorSum(State &state)
+{
+    Vector<T> a(bench::random_values<T>(state.size()));
+    while (state.keep_running())
+    {
+        bench::do_not_optimize(a.sum());
+    }
+    state.set_items_per_iteration(state.size());
+    state.set_bytes_per_iteration(state.size() * sizeof(T));
+}
+
+template <class T>
+void BM_VectorSumNeumaier(State &state)
+{
+    Vector<T> a(bench::random_values<T>(state.size()));
+    while (state.keep_running())
+    {
+        bench::do_not_optimize(a.sum(Summation::neumaier));
+    }
+    state.set_items_per_iteration(state.size());
+    state.set_bytes_per_iteration(state.size() * sizeof(T));
+}
+
+template <class T>
+void BM_VectorNormalize(State &state)
+{
+    Vector<T> a(bench::random_values<T>(state.size(), 1, 2));
+    while (state.keep_running())
+    {
+        auto n = a.normalize();
+        bench::do_not_optimize(n.data());
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+template <class T>
+void BM_VectorAddExpression(State &state)
+{
+    Vector<T> a(bench::random_values<T>(state.size()));
+    Vector<T> b(bench::random_values<T>(state.size()));
+    Vector<T> out(state.size());
+    while (state.keep_running())
+    {
+        out = a + b * T(2);
+        bench::do_not_optimize(out.data());
+    }
+    state.set_items_per_iteration(state.size());
+    state.set_bytes_per_iteration(3 * state.size() * sizeof(T));
+}
+
+ATMATH_BENCHMARK(BM_VectorConstruct, float, 16, 1024, 65536, 1048576);
+ATMATH_BENCHMARK(BM_VectorConstruct, double, 16, 1024, 65536, 1048576);
+ATMATH_BENCHMARK(BM_VectorCopy, float, 16, 1024, 65536, 1048576);
+ATMATH_BENCHMARK(BM_VectorCopy, double, 16, 1024, 65536, 1048576);
+ATMATH_BENCHMARK(BM_VectorCopy, int, 16, 1024, 65536, 1048576);
+ATMATH_BENCHMARK(BM_VectorPushBack, float, 16, 1024, 65536);
+ATMATH_BENCHMARK(BM_VectorPushBack, double, 16, 1024, 65536);
+ATMATH_BENCHMARK(BM_VectorAppend, float, 1024, 65536);
+ATMATH_BENCHMARK(BM_VectorAppend, double, 1024, 65536);
+ATMATH_BENCHMARK(BM_VectorDot, float, 16, 1024, 65536, 1048576);
+ATMATH_BENCHMARK(BM_VectorDot, double, 16, 1024, 65536, 1048576);
+ATMATH_BENCHMARK(BM_VectorDot, int, 16, 1024, 65536, 1048576);
+ATMATH_BENCHMARK(BM_VectorSum, float, 16, 1024, 65536, 1048576);
+ATMATH_BENCHMARK(BM_VectorSum, double, 16, 1024, 65536, 1048576);
+ATMATH_BENCHMARK(BM_VectorSum, int, 16, 1024, 65536, 1048576);
+ATMATH_BENCHMARK(BM_VectorSumNeumaier, float, 1024, 1048576);
+ATMATH_BENCHMARK(BM_VectorSumNeumaier, double, 1024, 1048576);
+ATMATH_BENCHMARK(BM_VectorNormalize, float, 16, 1024, 65536);
+ATMATH_BENCHMARK(BM_VectorNormalize, double, 16, 1024, 65536);
+ATMATH_BENCHMARK(BM_VectorAddExpression, float, 1024, 65536, 1048576);
+ATMATH_BENCHMARK(BM_VectorAddExpression, double, 1024, 65536, 1048576);
+
+// Complex --------------------------------------------------------------------
+
+template <class T>
+std::vector<Complex<T>> random_complex(size_t n)
+{
+    std::vector<T> re = bench::random_values<T>(n, 0.1, 2), im = bench::random_values<T>(n, -2, 2);
+    std::vector<Complex<T>> values;
+    values.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        values.emplace_back(re[i], im[i]);
+    }
+    return values;
+}
+
+template <class T>
+void BM_ComplexMul(State &state)
+{
+    std::vector<Complex<T>> a = random_complex<T>(state.size()), b = random_complex<T>(state.size());
+    std::vector<Complex<T>> out(state.size());
+    while (state.keep_running())
+    {
+        for (size_t i = 0; i < state.size(); i++)
+        {
+            out[i] = a[i] * b[i];
+        }
+        bench::clobber_memory();
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+template <class T>
+void BM_ComplexDiv(State &state)
+{
+    std::vector<Complex<T>> a = random_complex<T>(state.size()), b = random_complex<T>(state.size());
+    std::vector<Complex<T>> out(state.size());
+    while (state.keep_running())
+    {
+        for (size_t i = 0; i < state.size(); i++)
+        {
+            out[i] = a[i] / b[i];
+        }
+        bench::clobber_memory();
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+template <class T>
+void BM_ComplexPow(State &state)
+{
+    std::vector<Complex<T>> a = random_complex<T>(state.size());
+    std::vector<Complex<double>> out(state.size());
+    while (state.keep_running())
+    {
+        for (size_t i = 0; i < state.size(); i++)
+        {
+            out[i] = a[i].pow(2.5);
+        }
+        bench::clobber_memory();
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+template <class T>
+void BM_ComplexExp(State &state)
+{
+    std::vector<Complex<T>> a = random_complex<T>(state.size());
+    std::vector<Complex<double>> out(state.size());
+    while (state.keep_running())
+    {
+        for (size_t i = 0; i < state.size(); i++)
+        {
+            out[i] = exp(a[i]);
+        }
+        bench::clobber_memory();
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+template <class T>
+void BM_ComplexLog(State &state)
+{
+    std::vector<Complex<T>> a = random_complex<T>(state.size());
+    std::vector<Complex<double>> out(state.size());
+    while (state.keep_running())
+    {
+        for (size_t i = 0; i < state.size(); i++)
+        {
+            out[i] = log(a[i]);
+        }
+        bench::clobber_memory();
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+// The batch kernels of ComplexBatch.hpp over the same data.
+template <class T>
+void BM_ComplexBatchMul(State &state)
+{
+    std::vector<Complex<T>> values_a = random_complex<T>(state.size()), values_b = random_complex<T>(state.size());
+    Vector<Complex<T>> a(values_a), b(values_b), out(state.size());
+    while (state.keep_running())
+    {
+        multiply(a, b, out);
+        bench::clobber_memory();
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+template <class T>
+void BM_ComplexBatchDiv(State &state)
+{
+    std::vector<Complex<T>> values_a = random_complex<T>(state.size()), values_b = random_complex<T>(state.size());
+    Vector<Complex<T>> a(values_a), b(values_b), out(state.size());
+    while (state.keep_running())
+    {
+        divide(a, b, out);
+        bench::clobber_memory();
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+template <class T>
+void BM_ComplexFastExp(State &state)
+{
+    Vector<Complex<T>> a(random_complex<T>(state.size()));
+    while (state.keep_running())
+    {
+        auto out = fast::exp(a);
+        bench::do_not_optimize(out.data());
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+template <class T>
+void BM_ComplexFastLog(State &state)
+{
+    Vector<Complex<T>> a(random_complex<T>(state.size()));
+    while (state.keep_running())
+    {
+        auto out = fast::log(a);
+        bench::do_not_optimize(out.data());
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+ATMATH_BENCHMARK(BM_ComplexMul, float, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_ComplexMul, double, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_ComplexDiv, float, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_ComplexDiv, double, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_ComplexPow, float, 64, 4096);
+ATMATH_BENCHMARK(BM_ComplexPow, double, 64, 4096);
+ATMATH_BENCHMARK(BM_ComplexExp, float, 64, 4096);
+ATMATH_BENCHMARK(BM_ComplexExp, double, 64, 4096);
+ATMATH_BENCHMARK(BM_ComplexLog, float, 64, 4096);
+ATMATH_BENCHMARK(BM_ComplexLog, double, 64, 4096);
+ATMATH_BENCHMARK(BM_ComplexBatchMul, float, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_ComplexBatchMul, double, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_ComplexBatchDiv, float, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_ComplexBatchDiv, double, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_ComplexFastExp, float, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_ComplexFastLog, float, 64, 4096, 262144);
+
+// Quaternion -----------------------------------------------------------------
+
+template <class T>
+std::vector<Quaternion<T>> random_quaternions(size_t n)
+{
+    std::vector<T> values = bench::random_values<T>(4 * n, -1, 1);
+    std::vector<Quaternion<T>> quaternions;
+    quaternions.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        quaternions.emplace_back(values[4 * i], values[4 * i + 1], values[4 * i + 2], values[4 * i + 3]);
+    }
+    return quaternions;
+}
+
+template <class T>
+void BM_QuaternionMul(State &state)
+{
+    std::vector<Quaternion<T>> a = random_quaternions<T>(state.size()), b = random_quaternions<T>(state.size());
+    std::vector<Quaternion<T>> out(state.size());
+    while (state.keep_running())
+    {
+        for (size_t i = 0; i < state.size(); i++)
+        {
+            out[i] = a[i] * b[i];
+        }
+        bench::clobber_memory();
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+template <class T>
+void BM_QuaternionInverse(State &state)
+{
+    std::vector<Quaternion<T>> a = random_quaternions<T>(state.size());
+    std::vector<decltype(a[0].inverse())> out(state.size());
+    while (state.keep_running())
+    {
+        for (size_t i = 0; i < state.size(); i++)
+        {
+            out[i] = a[i].inverse();
+        }
+        bench::clobber_memory();
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+template <class T>
+void BM_QuaternionPow(State &state)
+{
+    std::vector<Quaternion<T>> a = random_quaternions<T>(state.size());
+    std::vector<Quaternion<double>> out(state.size());
+    while (state.keep_running())
+    {
+        for (size_t i = 0; i < state.size(); i++)
+        {
+            out[i] = a[i].pow(0.5);
+        }
+        bench::clobber_memory();
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+ATMATH_BENCHMARK(BM_QuaternionMul, float, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_QuaternionMul, double, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_QuaternionInverse, float, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_QuaternionInverse, double, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_QuaternionPow, float, 64, 4096);
+ATMATH_BENCHMARK(BM_QuaternionPow, double, 64, 4096);
+
+// Vec3 rotation --------------------------------------------------------------
+
+template <class T>
+std::vector<Vec3<T>> random_points(size_t n)
+{
+    std::vector<T> values = bench::random_values<T>(3 * n, -10, 10);
+    std::vector<Vec3<T>> points;
+    points.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        points.emplace_back(values[3 * i], values[3 * i + 1], values[3 * i + 2]);
+    }
+    return points;
+}
+
+// One UnitQuaternion * Vec3 per point.
+template <class T>
+void BM_Vec3Rotate(State &state)
+{
+    UnitQuaternion<T> q = UnitQuaternion<T>::from_axis_angle(1, 2, 3, 0.7);
+    std::vector<Vec3<T>> points = random_points<T>(state.size()), out(state.size());
+    while (state.keep_running())
+    {
+        for (size_t i = 0; i < state.size(); i++)
+        {
+            out[i] = q * points[i];
+        }
+        bench::clobber_memory();
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+// The matrix-based batch rotation of Vec3Array.hpp.
+template <class T>
+void BM_Vec3ArrayRotate(State &state)
+{
+    Quaternion<T> q = UnitQuaternion<T>::from_axis_angle(1, 2, 3, 0.7);
+    Vec3Array<T> points(random_points<T>(state.size())), out(state.size());
+    while (state.keep_running())
+    {
+        rotate(q, points, out);
+        bench::clobber_memory();
+    }
+    state.set_items_per_iteration(state.size());
+}
+
+ATMATH_BENCHMARK(BM_Vec3Rotate, float, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_Vec3Rotate, double, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_Vec3ArrayRotate, float, 64, 4096, 262144);
+ATMATH_BENCHMARK(BM_Vec3ArrayRotate, double, 64, 4096, 262144);
+
+int main(int argc, char **argv)
+{
+    std::string filter;
+    std::string out_path = "bench_output.txt";
+    double min_time = 0.1;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--filter=", 0) == 0)
+        {
+            filter = arg.substr(9);
+        }
+        else if (arg.rfind("--min-time=", 0) == 0)
+        {
+            min_time = std::atof(arg.c_str() + 11);
+        }
+        else if (arg.rfind("--out=", 0) == 0)
+        {
+            out_path = arg.substr(6);
+        }
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--filter=substring] [--min-time=seconds] [--out=path]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    std::ofstream out(out_path);
+    if (!out)
+    {
+        std::fprintf(stderr, "cannot write %s\n", out_path.c_str());
+        return 1;
+    }
+    out << "name\ttype\tsize\titerations\tns_per_iteration\titems_per_second\tbytes_per_second\n";
+    std::printf("%-40s %12s %14s %16s\n", "benchmark", "iterations", "ns/iter", "items/s");
+
+    for (const bench::Benchmark &benchmark : bench::registry())
+    {
+        for (size_t size : benchmark.sizes)
+        {
+            std::string label = benchmark.name + "<" + benchmark.type + ">/" + std::to_string(size);
+            if (!filter.empty() && label.find(filter) == std::string::npos)
+            {
+                continue;
+            }
+            bench::Result result = bench::measure(benchmark, size, min_time);
+            double ns = result.seconds * 1e9 / result.iterations;
+            double items = result.items * result.iterations / result.seconds;
+            double bytes = result.bytes * result.iterations / result.seconds;
+            std::printf("%-40s %12zu %14.1f %16.4g\n", label.c_str(), result.iterations, ns, items);
+            out << benchmark.name << '\t' << benchmark.type << '\t' << size << '\t' << result.iterations << '\t'
+                << ns << '\t' << items << '\t' << bytes << '\n';
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cmath>
+#include <cstdio>
+
+// Minimal assertion helpers for the test executables: each CHECK that fails
+// prints its location and counts, and main() returns check::exit_code() so
+// ctest sees the failure. Execution continues after a failed CHECK so one run
+// reports every broken case.
+namespace check
+{
+
+    inline int &failures()
+    {
+        static int count = 0;
+        return count;
+    }
+
+    inline bool report(bool ok, const char *file, int line, const char *expression)
+    {
+        if (!ok)
+        {
+            std::printf("%s:%d: CHECK failed: %s\n", file, line, expression);
+            failures()++;
+        }
+        return ok;
+    }
+
+    // |actual - expected| <= tolerance, printing both values on failure.
+    inline bool near(double actual, double expected, double tolerance, const char *file, int line, const char *expression)
+    {
+        bool ok = report(std::fabs(actual - expected) <= tolerance, file, line, expression);
+        if (!ok)
+        {
+            std::printf("    actual %.17g, expected %.17g, tolerance %.3g\n", actual, expected, tolerance);
+        }
+        return ok;
+    }
+
+    inline int exit_code()
+    {
+        if (failures() != 0)
+        {
+            std::printf("%d check(s) failed\n", failures());
+            return 1;
+        }
+        return 0;
+    }
+
+}
+
+#define CHECK(condition) check::report(static_cast<bool>(condition), __FILE__, __LINE__, #condition)
+
+#define CHECK_NEAR(actual, expected, tolerance) \
+    check::near(static_cast<double>(actual), static_cast<double>(expected), static_cast<double>(tolerance), __FILE__, __LINE__, #actual " ~ " #expected)
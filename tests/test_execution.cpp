@@ -0,0 +1,234 @@
+// Execution policies: par and par_unseq reductions must be bit-identical to
+// seq for every Summation mode and to the policy-free call within one
+// reduction block; elementwise and batch kernels must match their sequential
+// forms; and ThreadPool::parallel_for must visit every index exactly once.
+// The global pool is forced to four threads so the parallel paths run even
+// on a single-CPU machine.
+#include <atomic>
+#include <random>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "ComplexBatch.hpp"
+#include "Execution.hpp"
+#include "ThreadPool.hpp"
+#include "Vector.hpp"
+#include "check.hpp"
+
+using namespace atMath;
+
+namespace
+{
+
+    const Summation modes[] = {Summation::naive, Summation::pairwise, Summation::kahan, Summation::neumaier, Summation::widened};
+
+    constexpr size_t block = execution::reduction_block;
+    const size_t reduction_lengths[] = {0, 1, block - 1, block, block + 1, 10 * block + 7, (size_t(1) << 20) + 3};
+
+    constexpr size_t chunk = execution::elementwise_block;
+    const size_t elementwise_lengths[] = {0, 1, 2 * chunk - 1, 2 * chunk, 2 * chunk + 1, 5 * chunk + 3};
+
+    std::mt19937 generator(5);
+
+    template <class T>
+    Vector<T> random_vector(size_t n)
+    {
+        // Small integers keep the int dot products of ~1M terms from overflowing.
+        double range = std::is_integral<T>::value ? 30 : 100;
+        std::uniform_real_distribution<double> distribution(-range, range);
+        Vector<T> x(n, uninitialized);
+        for (size_t i = 0; i < n; i++)
+        {
+            x[i] = static_cast<T>(distribution(generator));
+        }
+        return x;
+    }
+
+    template <class T>
+    Vector<Complex<T>> random_complex(size_t n)
+    {
+        std::uniform_real_distribution<double> distribution(0.25, 2);
+        Vector<Complex<T>> x(n, uninitialized);
+        for (size_t i = 0; i < n; i++)
+        {
+            x[i] = Complex<T>(static_cast<T>(distribution(generator)), static_cast<T>(-distribution(generator)));
+        }
+        return x;
+    }
+
+    template <class T>
+    bool same(const Vector<T> &a, const Vector<T> &b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            if (!(a[i] == b[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class T>
+    bool same(const Vector<Complex<T>> &a, const Vector<Complex<T>> &b)
+    {
+        if (a.size() != b.size())
+        {
+            return false;
+        }
+        for (size_t i = 0; i < a.size(); i++)
+        {
+            if (!(a[i].real == b[i].real && a[i].imag == b[i].imag))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class T>
+    void test_reductions()
+    {
+        for (size_t n : reduction_lengths)
+        {
+            Vector<T> a = random_vector<T>(n), b = random_vector<T>(n);
+            for (Summation mode : modes)
+            {
+                T sum = a.sum(execution::seq, mode);
+                CHECK(a.sum(execution::par, mode) == sum);
+                CHECK(a.sum(execution::par_unseq, mode) == sum);
+                T dot = a.dot(execution::seq, b, mode);
+                CHECK(a.dot(execution::par, b, mode) == dot);
+                CHECK(a.dot(execution::par_unseq, b, mode) == dot);
+                if (n <= block)
+                {
+                    CHECK(sum == a.sum(mode));
+                    CHECK(dot == a.dot(b, mode));
+                }
+            }
+            double magnitude = a.magnitude(execution::seq);
+            CHECK(a.magnitude(execution::par) == magnitude);
+            CHECK(a.magnitude(execution::par_unseq) == magnitude);
+            if (n <= block)
+            {
+                CHECK(magnitude == a.magnitude());
+            }
+        }
+    }
+
+    template <class T>
+    void test_elementwise()
+    {
+        for (size_t n : elementwise_lengths)
+        {
+            Vector<T> a = random_vector<T>(n), b = random_vector<T>(n);
+            for (size_t i = 0; i < n; i++)
+            {
+                // Keep the divisor away from zero, for int in particular.
+                b[i] = b[i] < 1 && b[i] > -1 ? T(3) : b[i];
+            }
+            Vector<T> sum = add(execution::par, a, b), difference = subtract(execution::par, a, b);
+            Vector<T> product = multiply(execution::par, a, b), quotient = divide(execution::par, a, b);
+            bool exact = sum.size() == n && difference.size() == n && product.size() == n && quotient.size() == n;
+            for (size_t i = 0; i < n && exact; i++)
+            {
+                exact = sum[i] == a[i] + b[i] && difference[i] == a[i] - b[i] && product[i] == a[i] * b[i] && quotient[i] == a[i] / b[i];
+            }
+            CHECK(exact);
+            CHECK(same(add(execution::par_unseq, a, b), add(execution::seq, a, b)));
+            CHECK(same(multiply(execution::par_unseq, a, b), multiply(execution::seq, a, b)));
+        }
+    }
+
+    template <class T>
+    void test_batch()
+    {
+        for (size_t n : elementwise_lengths)
+        {
+            Vector<Complex<T>> a = random_complex<T>(n), b = random_complex<T>(n);
+            Vector<Complex<T>> expected, actual;
+            multiply(a, b, expected);
+            multiply(execution::par, a, b, actual);
+            CHECK(same(actual, expected));
+            multiply_conjugate(a, b, expected);
+            multiply_conjugate(execution::par, a, b, actual);
+            CHECK(same(actual, expected));
+            divide(a, b, expected);
+            divide(execution::par, a, b, actual);
+            CHECK(same(actual, expected));
+            expected = actual = a;
+            multiply_accumulate(expected, a, b);
+            multiply_accumulate(execution::par, actual, a, b);
+            CHECK(same(actual, expected));
+            CHECK(same(magnitude(execution::par, a), magnitude(a)));
+            CHECK(same(phase(execution::par, a), phase(a)));
+            if constexpr (std::is_same<T, float>::value)
+            {
+                ComplexArray<float> z(a);
+                CHECK(same(fast::exp(execution::par, z).toVector(), fast::exp(z).toVector()));
+                CHECK(same(fast::log(execution::par, z).toVector(), fast::log(z).toVector()));
+                CHECK(same(fast::sqrt(execution::par, z).toVector(), fast::sqrt(z).toVector()));
+                CHECK(same(fast::pow(execution::par, z, 1.5f).toVector(), fast::pow(z, 1.5f).toVector()));
+            }
+        }
+    }
+
+    void test_thread_pool()
+    {
+        ThreadPool pool(ThreadPoolOptions{4, false});
+        CHECK(pool.size() == 4);
+        for (size_t count : {size_t(0), size_t(1), size_t(2), size_t(3), size_t(17), size_t(1000), size_t(100003)})
+        {
+            for (size_t grain : {size_t(0), size_t(1), size_t(7)})
+            {
+                std::vector<std::atomic<int>> visits(count);
+                pool.parallel_for(count, [&](size_t i)
+                                  { visits[i]++; }, grain);
+                bool once = true;
+                for (const std::atomic<int> &v : visits)
+                {
+                    once = once && v.load() == 1;
+                }
+                CHECK(once);
+            }
+        }
+
+        bool thrown = false;
+        try
+        {
+            pool.parallel_for(1000, [](size_t i)
+                              {
+                                  if (i == 500)
+                                  {
+                                      throw std::runtime_error("body failed");
+                                  } });
+        }
+        catch (const std::runtime_error &)
+        {
+            thrown = true;
+        }
+        CHECK(thrown);
+    }
+
+}
+
+int main()
+{
+    ThreadPool::configure(ThreadPoolOptions{4, false});
+    CHECK(ThreadPool::global().size() == 4);
+    test_reductions<float>();
+    test_reductions<double>();
+    test_reductions<int>();
+    test_elementwise<float>();
+    test_elementwise<double>();
+    test_elementwise<int>();
+    test_batch<float>();
+    test_batch<double>();
+    test_thread_pool();
+    return check::exit_code();
+}
@@ -0,0 +1,204 @@
+// FFT, IFFT, FFTPlan and rfft/irfft against a direct O(n^2) DFT evaluated in
+// long double, over lengths covering the trivial case, primes (generic
+// butterfly only), twice a prime, mixed factorizations and powers of 2 and 4.
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "FFT.hpp"
+#include "check.hpp"
+
+using namespace atMath;
+
+namespace
+{
+
+    const size_t lengths[] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 12, 13, 14, 15, 16, 17, 22, 26, 31, 32, 34, 45, 62, 64,
+                              97, 100, 128, 194, 243, 256, 509, 1018, 1024, 4096};
+
+    template <class T>
+    Vector<Complex<T>> random_signal(size_t n, std::mt19937 &generator)
+    {
+        std::uniform_real_distribution<double> distribution(-1, 1);
+        Vector<Complex<T>> x(n, uninitialized);
+        for (size_t i = 0; i < n; i++)
+        {
+            x[i] = Complex<T>(static_cast<T>(distribution(generator)), static_cast<T>(distribution(generator)));
+        }
+        return x;
+    }
+
+    // X[k] = sum x[j] e^{sign 2 pi i jk / n}, divided by n for the inverse.
+    template <class T>
+    std::vector<Complex<long double>> direct_dft(const Vector<Complex<T>> &x, bool inverse)
+    {
+        size_t n = x.size();
+        const long double pi = 3.141592653589793238462643383279502884L;
+        long double sign = inverse ? 1 : -1;
+        std::vector<long double> cosines(n), sines(n);
+        for (size_t m = 0; m < n; m++)
+        {
+            cosines[m] = std::cos(2 * pi * static_cast<long double>(m) / n);
+            sines[m] = sign * std::sin(2 * pi * static_cast<long double>(m) / n);
+        }
+        std::vector<Complex<long double>> result(n);
+        for (size_t k = 0; k < n; k++)
+        {
+            long double re = 0, im = 0;
+            for (size_t j = 0; j < n; j++)
+            {
+                long double c = cosines[(j * k) % n], s = sines[(j * k) % n];
+                re += x[j].real * c - x[j].imag * s;
+                im += x[j].real * s + x[j].imag * c;
+            }
+            result[k] = inverse ? Complex<long double>(re / n, im / n) : Complex<long double>(re, im);
+        }
+        return result;
+    }
+
+    // Allowed error per bin: a few ulps per stage of the transform, relative
+    // to sum |x|, which bounds every |X[k]|.
+    template <class T>
+    long double tolerance(const Vector<Complex<T>> &x)
+    {
+        long double scale = 0;
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            scale += std::fabs(static_cast<long double>(x[i].real)) + std::fabs(static_cast<long double>(x[i].imag));
+        }
+        return 4 * std::numeric_limits<T>::epsilon() * (std::log2(static_cast<double>(x.size())) + 1) * (scale + 1);
+    }
+
+    template <class T>
+    long double max_error(const Vector<Complex<T>> &actual, const std::vector<Complex<long double>> &expected)
+    {
+        if (actual.size() != expected.size())
+        {
+            return std::numeric_limits<long double>::infinity();
+        }
+        long double error = 0;
+        for (size_t k = 0; k < actual.size(); k++)
+        {
+            error = std::max(error, std::fabs(actual[k].real - expected[k].real));
+            error = std::max(error, std::fabs(actual[k].imag - expected[k].imag));
+        }
+        return error;
+    }
+
+    template <class T>
+    std::vector<Complex<long double>> widen(const Vector<Complex<T>> &x)
+    {
+        std::vector<Complex<long double>> result(x.size());
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            result[i] = Complex<long double>(x[i].real, x[i].imag);
+        }
+        return result;
+    }
+
+    template <class T>
+    Vector<Complex<T>> to_vector(const ComplexArray<T> &x)
+    {
+        return x.toVector();
+    }
+
+    template <class T>
+    void test_transforms(size_t n, std::mt19937 &generator)
+    {
+        Vector<Complex<T>> x = random_signal<T>(n, generator);
+        std::vector<Complex<long double>> forward = direct_dft(x, false);
+        std::vector<Complex<long double>> inverse = direct_dft(x, true);
+        long double tol = tolerance(x);
+
+        CHECK(max_error(fft(x), forward) <= tol);
+        CHECK(max_error(ifft(x), inverse) <= tol / n);
+        CHECK(max_error(ifft(fft(x)), widen(x)) <= tol / n * 2);
+
+        Vector<Complex<T>> out;
+        fft(x, out);
+        CHECK(max_error(out, forward) <= tol);
+        ifft(x, out);
+        CHECK(max_error(out, inverse) <= tol / n);
+
+        Vector<Complex<T>> in_place = x;
+        fft_inplace(in_place);
+        CHECK(max_error(in_place, forward) <= tol);
+        in_place = x;
+        ifft_inplace(in_place);
+        CHECK(max_error(in_place, inverse) <= tol / n);
+
+        ComplexArray<T> split(x);
+        CHECK(max_error(to_vector(fft(split)), forward) <= tol);
+        CHECK(max_error(to_vector(ifft(split)), inverse) <= tol / n);
+        fft_inplace(split);
+        CHECK(max_error(to_vector(split), forward) <= tol);
+
+        for (FFTStrategy strategy : {FFTStrategy::radix4, FFTStrategy::radix2, FFTStrategy::odd_first})
+        {
+            FFTPlan<T> plan(n, strategy);
+            CHECK(plan.size() == n);
+            plan.forward(x, out);
+            CHECK(max_error(out, forward) <= tol);
+            plan.inverse(x, out);
+            CHECK(max_error(out, inverse) <= tol / n);
+
+            in_place = x;
+            plan.forward(in_place);
+            CHECK(max_error(in_place, forward) <= tol);
+            plan.inverse(in_place);
+            CHECK(max_error(in_place, widen(x)) <= tol / n * 2);
+
+            ComplexArray<T> split_out;
+            plan.forward(ComplexArray<T>(x), split_out);
+            CHECK(max_error(to_vector(split_out), forward) <= tol);
+        }
+
+        FFTPlan<T> measured(n, FFTPlanMode::measure);
+        measured.forward(x, out);
+        CHECK(max_error(out, forward) <= tol);
+    }
+
+    template <class T>
+    void test_real_transforms(size_t n, std::mt19937 &generator)
+    {
+        std::uniform_real_distribution<double> distribution(-1, 1);
+        Vector<T> x(n, uninitialized);
+        Vector<Complex<T>> complex_x(n, uninitialized);
+        for (size_t i = 0; i < n; i++)
+        {
+            x[i] = static_cast<T>(distribution(generator));
+            complex_x[i] = Complex<T>(x[i], 0);
+        }
+        std::vector<Complex<long double>> forward = direct_dft(complex_x, false);
+        forward.resize(n / 2 + 1);
+        long double tol = tolerance(complex_x);
+
+        Vector<Complex<T>> spectrum = rfft(x);
+        CHECK(spectrum.size() == n / 2 + 1);
+        CHECK(max_error(spectrum, forward) <= tol);
+
+        Vector<T> back = irfft(spectrum, n);
+        CHECK(back.size() == n);
+        long double error = 0;
+        for (size_t i = 0; i < n && back.size() == n; i++)
+        {
+            error = std::max(error, std::fabs(static_cast<long double>(back[i]) - x[i]));
+        }
+        CHECK(error <= tol / n * 2);
+    }
+
+}
+
+int main()
+{
+    std::mt19937 generator(2024);
+    for (size_t n : lengths)
+    {
+        test_transforms<float>(n, generator);
+        test_transforms<double>(n, generator);
+        test_real_transforms<float>(n, generator);
+        test_real_transforms<double>(n, generator);
+    }
+    return check::exit_code();
+}
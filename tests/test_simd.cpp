@@ -0,0 +1,368 @@
+// Every SIMD kernel, at every instruction set the running CPU supports,
+// against the scalar loops for each length in [0, 100] so all vector tails
+// are exercised. Inputs start one element past an allocation so the kernels
+// also see unaligned pointers.
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "Simd.hpp"
+#include "check.hpp"
+
+using namespace atMath;
+
+namespace
+{
+
+    constexpr size_t max_length = 100;
+
+// Forwards each kernel to one instruction-set namespace, so a single test
+// body can be instantiated for scalar, SSE, AVX2 and AVX-512.
+#define ATMATH_TEST_KERNEL_SET(NAME, NS)                                                          \
+    struct NAME                                                                                   \
+    {                                                                                             \
+        template <class... A>                                                                     \
+        static auto dot(A... a) { return simd::NS::dot(a...); }                                   \
+        template <class... A>                                                                     \
+        static auto sum(A... a) { return simd::NS::sum(a...); }                                   \
+        template <bool Neumaier, class... A>                                                      \
+        static auto sum_compensated(A... a) { return simd::NS::template sum_compensated<Neumaier>(a...); } \
+        template <class... A>                                                                     \
+        static auto sum_widened(A... a) { return simd::NS::sum_widened(a...); }                   \
+        template <class... A>                                                                     \
+        static void add(A... a) { simd::NS::add(a...); }                                          \
+        template <class... A>                                                                     \
+        static void sub(A... a) { simd::NS::sub(a...); }                                          \
+        template <class... A>                                                                     \
+        static void mul(A... a) { simd::NS::mul(a...); }                                          \
+        template <class... A>                                                                     \
+        static void scale(A... a) { simd::NS::scale(a...); }                                      \
+        template <class... A>                                                                     \
+        static void transform3(A... a) { simd::NS::transform3(a...); }                            \
+        template <class... A>                                                                     \
+        static void interpolate(A... a) { simd::NS::interpolate(a...); }                          \
+        template <class... A>                                                                     \
+        static void complex_mul(A... a) { simd::NS::complex_mul(a...); }                          \
+        template <class... A>                                                                     \
+        static void complex_mul_conj(A... a) { simd::NS::complex_mul_conj(a...); }                \
+        template <class... A>                                                                     \
+        static void complex_mac(A... a) { simd::NS::complex_mac(a...); }                          \
+        template <class... A>                                                                     \
+        static void complex_div(A... a) { simd::NS::complex_div(a...); }                          \
+        template <class... A>                                                                     \
+        static void complex_abs(A... a) { simd::NS::complex_abs(a...); }                          \
+        template <class... A>                                                                     \
+        static void complex_arg(A... a) { simd::NS::complex_arg(a...); }                          \
+        template <class... A>                                                                     \
+        static void complex_exp(A... a) { simd::NS::complex_exp(a...); }                          \
+        template <class... A>                                                                     \
+        static void complex_log(A... a) { simd::NS::complex_log(a...); }                          \
+        template <class... A>                                                                     \
+        static void complex_sqrt(A... a) { simd::NS::complex_sqrt(a...); }                        \
+        template <class... A>                                                                     \
+        static void complex_pow(A... a) { simd::NS::complex_pow(a...); }                          \
+    };
+
+    ATMATH_TEST_KERNEL_SET(Scalar, scalar)
+#ifdef ATMATH_SIMD_X86
+    ATMATH_TEST_KERNEL_SET(SSE, sse)
+    ATMATH_TEST_KERNEL_SET(AVX2, avx2)
+    ATMATH_TEST_KERNEL_SET(AVX512, avx512)
+#endif
+
+#undef ATMATH_TEST_KERNEL_SET
+
+    std::mt19937 generator(7);
+
+    // n values in [low, high), stored from index 1 of the returned vector.
+    template <class T>
+    std::vector<T> random_values(size_t n, double low = -1, double high = 1)
+    {
+        std::uniform_real_distribution<double> distribution(low, high);
+        std::vector<T> values(n + 1);
+        for (T &value : values)
+        {
+            value = static_cast<T>(distribution(generator));
+        }
+        return values;
+    }
+
+    template <class T>
+    double eps()
+    {
+        return std::is_integral<T>::value ? 0 : std::numeric_limits<T>::epsilon();
+    }
+
+    template <class K, class T>
+    void test_arithmetic()
+    {
+        double range = std::is_integral<T>::value ? 100 : 1;
+        for (size_t n = 0; n <= max_length; n++)
+        {
+            std::vector<T> a = random_values<T>(n, -range, range), b = random_values<T>(n, -range, range);
+            const T *pa = a.data() + 1, *pb = b.data() + 1;
+            double magnitude = 0;
+            for (size_t i = 0; i < n; i++)
+            {
+                magnitude += std::fabs(static_cast<double>(pa[i]) * static_cast<double>(pb[i])) + std::fabs(static_cast<double>(pa[i]));
+            }
+            double tolerance = 2 * (n + 1) * eps<T>() * magnitude;
+            CHECK_NEAR(K::dot(pa, pb, n), Scalar::dot(pa, pb, n), tolerance);
+            CHECK_NEAR(K::sum(pa, n), Scalar::sum(pa, n), tolerance);
+
+            std::vector<T> expected = a, actual = a;
+            Scalar::add(expected.data() + 1, pb, n);
+            K::add(actual.data() + 1, pb, n);
+            CHECK(expected == actual);
+            expected = actual = a;
+            Scalar::sub(expected.data() + 1, pb, n);
+            K::sub(actual.data() + 1, pb, n);
+            CHECK(expected == actual);
+            expected = actual = a;
+            Scalar::mul(expected.data() + 1, pb, n);
+            K::mul(actual.data() + 1, pb, n);
+            CHECK(expected == actual);
+            expected = actual = a;
+            Scalar::scale(expected.data() + 1, T(3), n);
+            K::scale(actual.data() + 1, T(3), n);
+            CHECK(expected == actual);
+        }
+    }
+
+    // The compensated kernels are held to the exact sum of the terms rather
+    // than to the scalar loop, since the lanes add in a different order.
+    // Kahan's bound is relative to sum |x|, Neumaier's to the result itself,
+    // both plus a second-order term. A product may be fused into the add
+    // that follows it, so a[i] * b[i] terms get one rounding each on top.
+    template <class K, class T>
+    void test_compensated()
+    {
+        for (size_t n = 0; n <= max_length; n++)
+        {
+            std::vector<T> a = random_values<T>(n, 0.5, 1.5), b = random_values<T>(n);
+            const T *pa = a.data() + 1, *pb = b.data() + 1;
+            for (const T *factor : {static_cast<const T *>(nullptr), pb})
+            {
+                long double exact = 0, magnitude = 0;
+                for (size_t i = 0; i < n; i++)
+                {
+                    T term = factor ? pa[i] * factor[i] : pa[i];
+                    exact += term;
+                    magnitude += std::fabs(term);
+                }
+                double extra = 4 * n * eps<T>() * eps<T>() * static_cast<double>(magnitude);
+                if (factor)
+                {
+                    extra += eps<T>() * static_cast<double>(magnitude);
+                }
+                double kahan = eps<T>() * std::fabs(static_cast<double>(exact)) + 2 * eps<T>() * static_cast<double>(magnitude);
+                double neumaier = 2 * eps<T>() * std::fabs(static_cast<double>(exact));
+                CHECK_NEAR(K::template sum_compensated<false>(pa, factor, n), exact, kahan + extra);
+                CHECK_NEAR(K::template sum_compensated<true>(pa, factor, n), exact, neumaier + extra);
+                if constexpr (std::is_same<T, float>::value)
+                {
+                    long double wide = 0;
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        wide += factor ? static_cast<double>(pa[i]) * factor[i] : pa[i];
+                    }
+                    CHECK_NEAR(K::sum_widened(pa, factor, n), wide, 4 * n * std::numeric_limits<double>::epsilon() * static_cast<double>(magnitude));
+                }
+            }
+        }
+    }
+
+    template <class K, class T>
+    void test_geometry()
+    {
+        T m[9] = {T(0.36), T(0.48), T(-0.8), T(-0.8), T(0.6), T(0), T(0.48), T(0.64), T(0.6)};
+        for (size_t n = 0; n <= max_length; n++)
+        {
+            std::vector<T> x = random_values<T>(n), y = random_values<T>(n), z = random_values<T>(n);
+            std::vector<T> ex(n), ey(n), ez(n), ax(n), ay(n), az(n);
+            Scalar::transform3(m, x.data() + 1, y.data() + 1, z.data() + 1, ex.data(), ey.data(), ez.data(), n);
+            K::transform3(m, x.data() + 1, y.data() + 1, z.data() + 1, ax.data(), ay.data(), az.data(), n);
+            for (size_t i = 0; i < n; i++)
+            {
+                CHECK_NEAR(ax[i], ex[i], 8 * eps<T>());
+                CHECK_NEAR(ay[i], ey[i], 8 * eps<T>());
+                CHECK_NEAR(az[i], ez[i], 8 * eps<T>());
+            }
+
+            // Unit quaternions as (real, i, j, k) lanes.
+            std::vector<T> lanes[8];
+            for (std::vector<T> &lane : lanes)
+            {
+                lane = random_values<T>(n);
+            }
+            for (size_t i = 1; i <= n; i++)
+            {
+                for (size_t q = 0; q < 8; q += 4)
+                {
+                    T norm = std::sqrt(lanes[q][i] * lanes[q][i] + lanes[q + 1][i] * lanes[q + 1][i] + lanes[q + 2][i] * lanes[q + 2][i] + lanes[q + 3][i] * lanes[q + 3][i]);
+                    for (size_t c = 0; c < 4; c++)
+                    {
+                        lanes[q + c][i] /= norm;
+                    }
+                }
+            }
+            const T *q0[4] = {lanes[0].data() + 1, lanes[1].data() + 1, lanes[2].data() + 1, lanes[3].data() + 1};
+            const T *q1[4] = {lanes[4].data() + 1, lanes[5].data() + 1, lanes[6].data() + 1, lanes[7].data() + 1};
+            std::vector<T> t = random_values<T>(n, 0, 1);
+            std::vector<T> expected[4], actual[4];
+            for (size_t c = 0; c < 4; c++)
+            {
+                expected[c].resize(n);
+                actual[c].resize(n);
+            }
+            T *eo[4] = {expected[0].data(), expected[1].data(), expected[2].data(), expected[3].data()};
+            T *ao[4] = {actual[0].data(), actual[1].data(), actual[2].data(), actual[3].data()};
+            for (bool spherical : {false, true})
+            {
+                for (size_t t_step : {0, 1})
+                {
+                    Scalar::interpolate(q0, q1, t.data() + 1, t_step, spherical, eo, n);
+                    K::interpolate(q0, q1, t.data() + 1, t_step, spherical, ao, n);
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        // Slerp divides by sin(theta), which scales the
+                        // rounding of both evaluation orders.
+                        T d = 0;
+                        for (size_t c = 0; c < 4; c++)
+                        {
+                            d += q0[c][i] * q1[c][i];
+                        }
+                        double tolerance = 16 * eps<T>() / std::sqrt(std::max(1 - static_cast<double>(d) * d, 1e-6));
+                        for (size_t c = 0; c < 4; c++)
+                        {
+                            CHECK_NEAR(actual[c][i], expected[c][i], tolerance);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    template <class K, class T>
+    void test_complex()
+    {
+        for (size_t n = 0; n <= max_length; n++)
+        {
+            std::vector<T> a = random_values<T>(2 * n), b = random_values<T>(2 * n, 0.25, 1);
+            const T *pa = a.data() + 1, *pb = b.data() + 1;
+            std::vector<T> expected(2 * n), actual(2 * n);
+            auto compare = [&](double tolerance)
+            {
+                for (size_t i = 0; i < 2 * n; i++)
+                {
+                    CHECK_NEAR(actual[i], expected[i], tolerance * (1 + std::fabs(expected[i])));
+                }
+            };
+
+            Scalar::complex_mul(expected.data(), pa, pb, n);
+            K::complex_mul(actual.data(), pa, pb, n);
+            compare(4 * eps<T>());
+            Scalar::complex_mul_conj(expected.data(), pa, pb, n);
+            K::complex_mul_conj(actual.data(), pa, pb, n);
+            compare(4 * eps<T>());
+            std::copy(pb, pb + 2 * n, expected.begin());
+            std::copy(pb, pb + 2 * n, actual.begin());
+            Scalar::complex_mac(expected.data(), pa, pb, n);
+            K::complex_mac(actual.data(), pa, pb, n);
+            compare(4 * eps<T>());
+            Scalar::complex_div(expected.data(), pa, pb, n);
+            K::complex_div(actual.data(), pa, pb, n);
+            compare(16 * eps<T>());
+
+            std::vector<T> expected_n(n), actual_n(n);
+            Scalar::complex_abs(expected_n.data(), pa, n);
+            K::complex_abs(actual_n.data(), pa, n);
+            for (size_t i = 0; i < n; i++)
+            {
+                CHECK_NEAR(actual_n[i], expected_n[i], 4 * eps<T>());
+            }
+            Scalar::complex_arg(expected_n.data(), pa, n);
+            K::complex_arg(actual_n.data(), pa, n);
+            for (size_t i = 0; i < n; i++)
+            {
+                CHECK_NEAR(actual_n[i], expected_n[i], 32 * eps<T>());
+            }
+        }
+    }
+
+    // Split-lane exp/log/sqrt/pow, float only.
+    template <class K>
+    void test_complex_functions()
+    {
+        for (size_t n = 0; n <= max_length; n++)
+        {
+            std::vector<float> re = random_values<float>(n, -4, 4), im = random_values<float>(n, -4, 4);
+            std::vector<float> er(n), ei(n), ar(n), ai(n);
+            auto compare = [&]()
+            {
+                for (size_t i = 0; i < n; i++)
+                {
+                    double magnitude = std::hypot(er[i], ei[i]);
+                    CHECK_NEAR(ar[i], er[i], 8 * eps<float>() * (1 + magnitude));
+                    CHECK_NEAR(ai[i], ei[i], 8 * eps<float>() * (1 + magnitude));
+                }
+            };
+            Scalar::complex_exp(re.data() + 1, im.data() + 1, er.data(), ei.data(), n);
+            K::complex_exp(re.data() + 1, im.data() + 1, ar.data(), ai.data(), n);
+            compare();
+            Scalar::complex_log(re.data() + 1, im.data() + 1, er.data(), ei.data(), n);
+            K::complex_log(re.data() + 1, im.data() + 1, ar.data(), ai.data(), n);
+            compare();
+            Scalar::complex_sqrt(re.data() + 1, im.data() + 1, er.data(), ei.data(), n);
+            K::complex_sqrt(re.data() + 1, im.data() + 1, ar.data(), ai.data(), n);
+            compare();
+            Scalar::complex_pow(re.data() + 1, im.data() + 1, 1.5f, -0.5f, er.data(), ei.data(), n);
+            K::complex_pow(re.data() + 1, im.data() + 1, 1.5f, -0.5f, ar.data(), ai.data(), n);
+            compare();
+        }
+    }
+
+    template <class K>
+    void test_level()
+    {
+        test_arithmetic<K, float>();
+        test_arithmetic<K, double>();
+        test_arithmetic<K, int>();
+        test_compensated<K, float>();
+        test_compensated<K, double>();
+        test_geometry<K, float>();
+        test_geometry<K, double>();
+        test_complex<K, float>();
+        test_complex<K, double>();
+        test_complex_functions<K>();
+    }
+
+}
+
+int main()
+{
+    // The scalar loops against themselves still run the compensated and
+    // widened checks, which compare against exact sums.
+    test_level<Scalar>();
+#ifdef ATMATH_SIMD_X86
+    simd::Level level = simd::detect();
+    if (level >= simd::Level::SSE)
+    {
+        test_level<SSE>();
+    }
+    if (level >= simd::Level::AVX2)
+    {
+        test_level<AVX2>();
+    }
+    if (level >= simd::Level::AVX512)
+    {
+        test_level<AVX512>();
+    }
+    std::printf("highest SIMD level tested: %d\n", static_cast<int>(level));
+#endif
+    return check::exit_code();
+}
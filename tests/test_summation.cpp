@@ -0,0 +1,133 @@
+// Accuracy of each Summation mode on a long float vector, measured against a
+// long double reference: the compensated and widened modes must land within a
+// couple of ulps of the exact sum, pairwise within its log2(n) bound.
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+
+#include "Vector.hpp"
+#include "check.hpp"
+
+using namespace atMath;
+
+namespace
+{
+
+    const Summation modes[] = {Summation::naive, Summation::pairwise, Summation::kahan, Summation::neumaier, Summation::widened};
+
+    template <class T>
+    long double exact_sum(const Vector<T> &x)
+    {
+        long double result = 0;
+        for (size_t i = 0; i < x.size(); i++)
+        {
+            result += x[i];
+        }
+        return result;
+    }
+
+    // Allowed error of each mode; magnitude is sum |x|.
+    template <class T>
+    long double bound(Summation mode, size_t n, long double exact, long double magnitude)
+    {
+        const long double eps = std::numeric_limits<T>::epsilon();
+        switch (mode)
+        {
+        case Summation::naive:
+            return n * eps * magnitude;
+        case Summation::pairwise:
+            return (std::log2(static_cast<double>(n)) + 256) * eps * magnitude;
+        case Summation::kahan:
+            return eps * std::fabs(exact) + 2 * eps * magnitude;
+        default:
+            return 2 * eps * std::fabs(exact);
+        }
+    }
+
+    // Every term positive, so sum |x| = |sum x|.
+    void test_long_float()
+    {
+        const size_t n = size_t(1) << 22;
+        Vector<float> x(n, uninitialized);
+        for (size_t i = 0; i < n; i++)
+        {
+            x[i] = 0.7f + 1e-7f * static_cast<float>(i % 13);
+        }
+        long double exact = exact_sum(x);
+        for (Summation mode : modes)
+        {
+            CHECK(std::fabs(x.sum(mode) - exact) <= bound<float>(mode, n, exact, exact));
+        }
+        // Naive float accumulation drifts visibly at this length.
+        CHECK(std::fabs(x.sum(Summation::neumaier) - exact) < std::fabs(x.sum(Summation::naive) - exact));
+        CHECK(std::fabs(x.sum(Summation::widened) - exact) < std::fabs(x.sum(Summation::naive) - exact));
+    }
+
+    template <class T>
+    void test_random_dot()
+    {
+        const size_t n = 1000003;
+        std::mt19937 generator(11);
+        std::uniform_real_distribution<double> distribution(-1, 1);
+        Vector<T> a(n, uninitialized), b(n, uninitialized);
+        long double exact = 0, magnitude = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            a[i] = static_cast<T>(distribution(generator));
+            b[i] = static_cast<T>(distribution(generator));
+            T product = a[i] * b[i];
+            exact += product;
+            magnitude += std::fabs(product);
+        }
+        // The compiler may fuse a product into the following add, so each
+        // product may or may not be rounded: allow one rounding per term on
+        // top of the mode's own bound.
+        long double products = std::numeric_limits<T>::epsilon() * magnitude;
+        for (Summation mode : modes)
+        {
+            if (mode == Summation::widened)
+            {
+                continue;
+            }
+            CHECK(std::fabs(a.dot(b, mode) - exact) <= bound<T>(mode, n, exact, magnitude) + products);
+        }
+        long double wide = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            wide += static_cast<double>(a[i]) * b[i];
+        }
+        // widened is plain summation for double.
+        Summation widened = std::is_same<T, float>::value ? Summation::widened : Summation::naive;
+        CHECK(std::fabs(a.dot(b, Summation::widened) - wide) <= bound<T>(widened, n, wide, magnitude));
+    }
+
+    // [1, big, 1, -big] repeated: each big term swamps the running total,
+    // which loses the ones under Kahan but not under Neumaier.
+    template <class T>
+    void test_cancellation()
+    {
+        const size_t blocks = 1000;
+        const T big = std::is_same<T, float>::value ? T(1e8) : T(1e17);
+        Vector<T> x(4 * blocks, uninitialized);
+        for (size_t i = 0; i < blocks; i++)
+        {
+            x[4 * i] = 1;
+            x[4 * i + 1] = big;
+            x[4 * i + 2] = 1;
+            x[4 * i + 3] = -big;
+        }
+        CHECK(x.sum(Summation::neumaier) == T(2 * blocks));
+    }
+
+}
+
+int main()
+{
+    test_long_float();
+    test_random_dot<float>();
+    test_random_dot<double>();
+    test_cancellation<float>();
+    test_cancellation<double>();
+    return check::exit_code();
+}
@@ -1,9 +1,16 @@
 #pragma once
 
 #include "Vector.hpp"
+#include "VectorView.hpp"
 #include "Vectors_d.hpp"
 #include "Complex.hpp"
 #include "Quaternion.hpp"
+#include "UnitQuaternion.hpp"
+#include "ComplexArray.hpp"
+#include "ComplexBatch.hpp"
+#include "QuaternionArray.hpp"
+#include "Vec3Array.hpp"
+#include "FFT.hpp"
 
 
 namespace atMath{
@@ -23,6 +30,9 @@ namespace atMath{
     typedef Vec4<double> Vec4d;
     typedef Vec4<int> Vec4i;
 
+    typedef Vec3Array<float> Vec3Arrf;
+    typedef Vec3Array<double> Vec3Arrd;
+
     typedef Complex<int> int_c;
     typedef Complex<float> float_c;
     typedef Complex<double> double_c;
@@ -47,6 +57,9 @@ namespace atMath{
     typedef Quaternion<uint16_t> uint16_q;
     typedef Quaternion<int16_t> int16_q;
 
+    typedef UnitQuaternion<float> float_uq;
+    typedef UnitQuaternion<double> double_uq;
+
     typedef Vector<int_c> Veci_c;
     typedef Vector<float_c> Vecf_c;
     typedef Vector<double_c> Vecd_c;
@@ -55,6 +68,12 @@ namespace atMath{
     typedef Vector<float_q> Vecf_q;
     typedef Vector<double_q> Vecd_q;
 
+    typedef ComplexArray<float> Arrf_c;
+    typedef ComplexArray<double> Arrd_c;
+
+    typedef QuaternionArray<float> Arrf_q;
+    typedef QuaternionArray<double> Arrd_q;
+
     typedef Vec2<int_c> Vec2i_c;
     typedef Vec2<float_c> Vec2f_c;
     typedef Vec2<double_c> Vec2d_c;